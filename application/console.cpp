@@ -0,0 +1,311 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include <stdint.h>
+#include "console.h"
+#include "rtos.h"
+#include "introspect.h"
+#include "uart.h"
+#include "utils/cmdline.h"
+
+// Define variables
+static char line[CONSOLE_LINE_SIZE];
+static char out[96];
+static uint8_t outLength;
+static taskInfo before[MAX_TASKS];
+static taskInfo after[MAX_TASKS];
+
+static const char* const stateNames[] = { "invalid", "ready", "blocked", "delayed" };
+static const char* const typeNames[] = { "task", "sem", "mutex", "stream" };
+
+//-----------------------------------------------------------------------------
+// Output helpers
+//-----------------------------------------------------------------------------
+
+static void put(const char* s) {
+    while (*s != 0 && outLength < sizeof(out))
+    {
+        out[outLength++] = *s++;
+    }
+}
+
+static void pad(uint8_t column) {
+    while (outLength < column && outLength < sizeof(out))
+    {
+        out[outLength++] = ' ';
+    }
+}
+
+static void putNumber(uint32_t value, uint8_t base = 10) {
+    char digits[10];
+    uint8_t n = 0;
+    do
+    {
+        digits[n++] = "0123456789abcdef"[value % base];
+        value /= base;
+    } while (value != 0);
+    while (n > 0 && outLength < sizeof(out))
+    {
+        out[outLength++] = digits[--n];
+    }
+}
+
+// per-mille as a percentage with one decimal
+static void putPercent(uint32_t permille) {
+    putNumber(permille / 10);
+    put(".");
+    putNumber(permille % 10);
+}
+
+static void putName(const void* object) {
+    const char* name = Introspect::name(object);
+    if (name != 0)
+    {
+        put(name);
+    }
+    else
+    {
+        put("0x");
+        putNumber((uint32_t)object, 16);
+    }
+}
+
+static void endLine() {
+    put("\r\n");
+    Uart::write(out, outLength, WAIT_FOREVER);
+    outLength = 0;
+}
+
+static uint32_t parseNumber(const char* s) {
+    uint32_t value = 0;
+    while (*s >= '0' && *s <= '9')
+    {
+        value = value * 10 + (*s++ - '0');
+    }
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+// Commands
+//-----------------------------------------------------------------------------
+
+static void printTask(const taskInfo* t, uint32_t permille) {
+    putNumber(t->index);
+    pad(4);
+    putName(t->pid);
+    pad(18);
+    put(stateNames[t->state & 3]);
+    pad(27);
+    putNumber(t->priority);
+    if (t->currentPriority != t->priority)
+    {
+        put(">");
+        putNumber(t->currentPriority);
+    }
+    pad(33);
+    putPercent(permille);
+    pad(40);
+    putNumber(t->stackFree * 4);
+    pad(47);
+    if (t->waitObject == (void*)&tcb[t->index].notify)
+        put("notify");
+    else if (t->waitObject != 0)
+        putName(t->waitObject);
+    if (t->wakeTick != 0)
+    {
+        put(" until ");
+        putNumber(t->wakeTick);
+    }
+    endLine();
+}
+
+static void printHeader() {
+    put("#   NAME          STATE    PRI   CPU%   FREE   WAIT");
+    endLine();
+}
+
+static int ps(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    uint8_t n = Introspect::tasks(after, MAX_TASKS);
+    uint32_t scale = tickCount / 1000;
+    printHeader();
+    for (uint8_t i = 0; i < n; i++)
+    {
+        uint32_t permille = (scale != 0) ? after[i].runTicks / scale : 0;
+        printTask(&after[i], permille > 1000 ? 1000 : permille);
+    }
+    return 0;
+}
+
+static int top(int argc, char* argv[]) {
+    uint32_t interval = (argc > 1) ? parseNumber(argv[1]) : 1000;
+    if (interval == 0 || interval > 60000)
+        return CMDLINE_INVALID_ARG;
+
+    uint8_t m = Introspect::tasks(before, MAX_TASKS);
+    uint32_t start = tickCount;
+    RTOS::sleep(interval);
+    uint8_t n = Introspect::tasks(after, MAX_TASKS);
+    uint32_t elapsed = tickCount - start;
+
+    printHeader();
+    for (uint8_t i = 0; i < n; i++)
+    {
+        // a task created during the interval counts from zero
+        uint32_t previous = 0;
+        for (uint8_t j = 0; j < m; j++)
+        {
+            if (before[j].index == after[i].index && before[j].pid == after[i].pid)
+                previous = before[j].runTicks;
+        }
+        uint32_t permille = (after[i].runTicks - previous) * 1000 / elapsed;
+        printTask(&after[i], permille > 1000 ? 1000 : permille);
+    }
+    return 0;
+}
+
+static int objs(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    objectInfo info[MAX_OBJECTS];
+    uint8_t n = Introspect::objects(info, MAX_OBJECTS);
+
+    put("NAME          TYPE    COUNT       WAITERS");
+    endLine();
+    for (uint8_t i = 0; i < n; i++)
+    {
+        put(info[i].name);
+        pad(14);
+        put(typeNames[info[i].type & 3]);
+        pad(22);
+        if (info[i].type == OBJECT_MUTEX)
+        {
+            if (info[i].count == NO_TASK)
+                put("free");
+            else
+            {
+                put("owner ");
+                putNumber(info[i].count);
+            }
+        }
+        else
+        {
+            putNumber(info[i].count);
+            if (info[i].capacity != 0)
+            {
+                put("/");
+                putNumber(info[i].capacity);
+            }
+        }
+        pad(34);
+        putNumber(info[i].waiters);
+        endLine();
+    }
+    return 0;
+}
+
+static int uptime(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    putNumber(tickCount);
+    put(" ticks");
+    endLine();
+    return 0;
+}
+
+static int help(int argc, char* argv[]);
+
+tCmdLineEntry g_psCmdTable[] =
+{
+    { "help",   help,   "list commands" },
+    { "ps",     ps,     "tasks, CPU share since start" },
+    { "top",    top,    "tasks, CPU share over [ticks]" },
+    { "objs",   objs,   "semaphores, mutexes, stream buffers" },
+    { "uptime", uptime, "ticks since start" },
+    { 0, 0, 0 }
+};
+
+static int help(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+    for (const tCmdLineEntry* e = g_psCmdTable; e->pcCmd != 0; e++)
+    {
+        put(e->pcCmd);
+        pad(8);
+        put(e->pcHelp);
+        endLine();
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Diagnostic Console
+//-----------------------------------------------------------------------------
+
+void Console::task() {
+    while (true)
+    {
+        put("> ");
+        Uart::write(out, outLength, WAIT_FOREVER);
+        outLength = 0;
+
+        // read a line with echo and backspace
+        uint8_t length = 0;
+        char c = 0;
+        while (c != '\r' && c != '\n')
+        {
+            Uart::read(&c, 1, WAIT_FOREVER);
+            if ((c == '\b' || c == 0x7F) && length > 0)
+            {
+                length--;
+                Uart::write("\b \b", 3, WAIT_FOREVER);
+            }
+            else if (c >= ' ' && length < CONSOLE_LINE_SIZE - 1)
+            {
+                line[length++] = c;
+                Uart::write(&c, 1, WAIT_FOREVER);
+            }
+        }
+        line[length] = 0;
+        endLine();
+        if (length == 0)
+            continue;
+
+        switch (CmdLineProcess(line))
+        {
+        case CMDLINE_BAD_CMD:
+            put("unknown command, try help");
+            endLine();
+            break;
+        case CMDLINE_TOO_MANY_ARGS:
+            put("too many arguments");
+            endLine();
+            break;
+        case CMDLINE_INVALID_ARG:
+            put("invalid argument");
+            endLine();
+            break;
+        default:
+            break;
+        }
+    }
+}
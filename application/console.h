@@ -0,0 +1,48 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+//-----------------------------------------------------------------------------
+// Diagnostic Console
+//-----------------------------------------------------------------------------
+
+/// Line-based shell on UART0 built on utils/cmdline. Commands:
+///   help           list commands
+///   ps             tasks with cumulative CPU share since start
+///   top [ticks]    tasks with CPU share over an interval (default 1000)
+///   objs           registered semaphores, mutexes and stream buffers
+///   uptime         ticks since start
+///
+/// Task and object names come from Introspect::registerObject(). The console
+/// shares UART0 with the LOG() drain; logdecode.py skips the ASCII text.
+
+#define CONSOLE_LINE_SIZE   64
+
+/// Class for the diagnostic console
+class Console
+{
+public:
+    static void task();
+};
+
+#endif // CONSOLE_H
@@ -20,18 +20,13 @@
 
 #include "rtos.h"
 #include "port.h"
-
-#define RED_LED_B          (*((volatile uint32_t *)(0x42000000 + (0x400253FC-0x40000000)*32 + 1*4)))
-#define BLUE_LED_B         (*((volatile uint32_t *)(0x42000000 + (0x400253FC-0x40000000)*32 + 2*4)))
-#define ORANGE_LED         (*((volatile uint32_t *)(0x42000000 + (0x400053FC-0x40000000)*32 + 4*4)))
-#define GREEN_LED          (*((volatile uint32_t *)(0x42000000 + (0x400053FC-0x40000000)*32 + 5*4)))
-#define RED_LED            (*((volatile uint32_t *)(0x42000000 + (0x400053FC-0x40000000)*32 + 7*4)))
-#define YELLOW_LED         (*((volatile uint32_t *)(0x42000000 + (0x400053FC-0x40000000)*32 + 6*4)))
-
-#define PB_0               (*((volatile uint32_t *)(0x42000000 + (0x400063FC-0x40000000)*32 + 4*4)))
-#define PB_1               (*((volatile uint32_t *)(0x42000000 + (0x400063FC-0x40000000)*32 + 5*4)))
-#define PB_2               (*((volatile uint32_t *)(0x42000000 + (0x400063FC-0x40000000)*32 + 6*4)))
-#define PB_3               (*((volatile uint32_t *)(0x42000000 + (0x400063FC-0x40000000)*32 + 7*4)))
+#include "board.h"
+#include "input.h"
+#include "workqueue.h"
+#include "log.h"
+#include "introspect.h"
+#include "console.h"
+#include "crc.h"
 
 //-----------------------------------------------------------------------------
 // Helper Functions
@@ -57,13 +52,13 @@ uint8_t readPbs()
 {
     uint8_t pb_status=0;
 
-    if(PB_0 == 0)
+    if(Pb0::read() == 0)
         pb_status = 1;
-    else if(PB_1 == 0)
+    else if(Pb1::read() == 0)
         pb_status = 2;
-    else if(PB_2 == 0)//MODE_COOPERATIVE
+    else if(Pb2::read() == 0)//MODE_COOPERATIVE
         pb_status = 4;
-    else if(PB_3 == 0)//MODE_PREEMPTIVE
+    else if(Pb3::read() == 0)//MODE_PREEMPTIVE
         pb_status = 8;
 
     return pb_status;
@@ -80,9 +75,9 @@ void idle()
 {
     while (true)
     {
-        BLUE_LED_B = 1;
+        BlueLedB::set();
         waitMicrosecond(1000);
-        BLUE_LED_B = 0;
+        BlueLedB::clear();
         RTOS::yield();
     }
 }
@@ -91,7 +86,7 @@ void flash4Hz()
 {
     while (true)
     {
-        GREEN_LED ^= 1;
+        GreenLed::toggle();
         RTOS::sleep(125);
     }
 }
@@ -101,9 +96,9 @@ void oneshot()
     while (true)
     {
         RTOS::waitSemaphore(&flashReq);
-        YELLOW_LED = 1;
+        YellowLed::set();
         RTOS::sleep(1000);
-        YELLOW_LED = 0;
+        YellowLed::clear();
     }
 }
 
@@ -124,32 +119,31 @@ void lengthyFn()
         {
             partOfLengthyFn();
         }
-        RED_LED ^= 1;
+        RedLed::toggle();
     }
 }
 
 void readKeys()
 {
+    inputEvent event;
     uint8_t buttons;
     while (true)
     {
-        RTOS::waitSemaphore(&keyReleased);
-        buttons = 0;
-        while (buttons == 0)
-        {
-            buttons = readPbs();
-            RTOS::yield();
-        }
-        RTOS::postSemaphore(&keyPressed);
+        // blocks until the input service reports a debounced edge
+        Input::waitEvent(&event, WAIT_FOREVER);
+        if (!event.pressed)
+            continue;
+        buttons = event.button;
+        LOG("buttons %02x pressed at %u", buttons, event.timestamp);
         if ((buttons & 1) != 0)
         {
-            YELLOW_LED ^= 1;
-            RED_LED = 1;
+            YellowLed::toggle();
+            RedLed::set();
         }
         if ((buttons & 2) != 0)
         {
             RTOS::postSemaphore(&flashReq);
-            RED_LED = 0;
+            RedLed::clear();
         }
         if ((buttons & 4) != 0)
         {
@@ -159,27 +153,6 @@ void readKeys()
         {
             RTOS::destroyProcess(flash4Hz);
         }
-
-        RTOS::yield();
-    }
-}
-
-void debounce()
-{
-    uint8_t count;
-    while (true)
-    {
-        RTOS::waitSemaphore(&keyPressed);
-        count = 10;
-        while (count != 0)
-        {
-            RTOS::sleep(10);
-            if (readPbs() == 0)
-                count--;
-            else
-                count = 10;
-        }
-        RTOS::postSemaphore(&keyReleased);
     }
 }
 
@@ -207,9 +180,9 @@ int main() {
     RTOS::bspInit(); // init hw
 
     // blink Red LED
-    RED_LED_B = 1;
+    RedLedB::set();
     waitMicrosecond(250000);
-    RED_LED_B = 0;
+    RedLedB::clear();
     waitMicrosecond(250000);
 
     // Initialize selected kernel mode
@@ -230,22 +203,39 @@ int main() {
       }
     }
 
+    // Start the worker tasks and the button input service
+    Crc::init();
+    error = WorkQueue::init();
+    Input::init();
+
     // Add required idle process
-    error =  RTOS::createProcess(idle, 7);
+    error &= RTOS::createProcess(idle, 7);
 
     // Add other processes
     error &= RTOS::createProcess(flash4Hz, 0);
     error &= RTOS::createProcess(lengthyFn, 6);
     error &= RTOS::createProcess(oneshot, 3);
     error &= RTOS::createProcess(readKeys, 1);
-    error &= RTOS::createProcess(debounce, 3);
     error &= RTOS::createProcess(uncooperative, 5);
+    error &= RTOS::createProcess(Log::drainTask, 6);
+    error &= RTOS::createProcess(Console::task, 6);
+
+    // Name the tasks and objects shown by the console
+    Introspect::registerObject("idle", OBJECT_TASK, (void*)idle);
+    Introspect::registerObject("flash4Hz", OBJECT_TASK, (void*)flash4Hz);
+    Introspect::registerObject("lengthyFn", OBJECT_TASK, (void*)lengthyFn);
+    Introspect::registerObject("oneshot", OBJECT_TASK, (void*)oneshot);
+    Introspect::registerObject("readKeys", OBJECT_TASK, (void*)readKeys);
+    Introspect::registerObject("uncoop", OBJECT_TASK, (void*)uncooperative);
+    Introspect::registerObject("logDrain", OBJECT_TASK, (void*)Log::drainTask);
+    Introspect::registerObject("console", OBJECT_TASK, (void*)Console::task);
+    Introspect::registerObject("flashReq", OBJECT_SEMAPHORE, &flashReq);
 
     // Start up RTOS
     if (error)
         RTOS::rtosStart(); // never returns
     else
-        RED_LED = 1;
+        RedLed::set();
         
     return 0;
 
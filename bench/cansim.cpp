@@ -0,0 +1,531 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+//-----------------------------------------------------------------------------
+// CAN driver against a simulated controller, on the host
+//-----------------------------------------------------------------------------
+
+// hal/can.cpp is compiled unchanged with its CAN0 registers redirected to a
+// model of the TM4C123 controller: 32 message objects behind the IF1/IF2
+// command interfaces, acceptance masks, FIFO chains ending in EOB, MSGLST on
+// overwrite, the INT register and loopback. The first part checks filtering,
+// FIFO order, overruns and the ID-ordered transmit queue in loopback mode.
+// The second saturates a 1 Mbit/s bus with 8-byte frames while interrupts
+// are masked for part of every millisecond and the reader task only drains
+// its queue every few ticks, and counts frames lost in hardware or dropped
+// from the queue. Build and run from the top level:
+//   T=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178
+//   g++ -O2 -std=c++17 -Ihal -Ikernel -Ibench -I$T/inc bench/cansim.cpp bench/hostkernel.cpp kernel/streambuf.cpp
+//   ./a.out
+
+#include <stdio.h>
+#include <string.h>
+#include "hostkernel.h"
+#include "can.h"
+#include "tm4c123gh6pm.h"
+
+#define FRAME_BITS      111     // 8-byte standard data frame with interframe space, unstuffed
+#define SIM_MS          2000    // length of each bus-load run
+
+//-----------------------------------------------------------------------------
+// Controller model
+//-----------------------------------------------------------------------------
+
+struct simObject
+{
+  uint32_t msk1, msk2, arb1, arb2, mctl;
+  uint32_t data[4];
+};
+
+struct simInterface
+{
+  uint32_t cmsk, msk1, msk2, arb1, arb2, mctl;
+  uint32_t da1, da2, db1, db2;
+};
+
+struct simFrame
+{
+  uint32_t id;          // CAN_ID_EXTENDED form, as in canFrame
+  uint8_t length;
+  uint8_t data[8];
+};
+
+class CanSim
+{
+public:
+    simObject object[33];           // 1..32
+    simInterface ifr[2];
+    uint32_t ctl, tst, bit, brpe;
+    bool statusPending;
+    simFrame sent[64];              // frames that left the transmit object
+    uint32_t sentCount;
+
+    // IFn command request: move data between an interface and an object
+    void command(int n, uint32_t number) {
+        simInterface* r = &ifr[n];
+        simObject* o = &object[number & 0x3F];
+        if (r->cmsk & CAN_IF1CMSK_WRNRD)
+        {
+            if (r->cmsk & CAN_IF1CMSK_MASK)
+            {
+                o->msk1 = r->msk1;
+                o->msk2 = r->msk2;
+            }
+            if (r->cmsk & CAN_IF1CMSK_ARB)
+            {
+                o->arb1 = r->arb1;
+                o->arb2 = r->arb2;
+            }
+            if (r->cmsk & CAN_IF1CMSK_CONTROL)
+                o->mctl = r->mctl;
+            if (r->cmsk & CAN_IF1CMSK_TXRQST)
+                o->mctl |= CAN_IF1MCTL_TXRQST;
+            if (r->cmsk & CAN_IF1CMSK_DATAA)
+            {
+                o->data[0] = r->da1;
+                o->data[1] = r->da2;
+            }
+            if (r->cmsk & CAN_IF1CMSK_DATAB)
+            {
+                o->data[2] = r->db1;
+                o->data[3] = r->db2;
+            }
+        }
+        else
+        {
+            r->msk1 = o->msk1;
+            r->msk2 = o->msk2;
+            r->arb1 = o->arb1;
+            r->arb2 = o->arb2;
+            r->mctl = o->mctl;
+            r->da1 = o->data[0];
+            r->da2 = o->data[1];
+            r->db1 = o->data[2];
+            r->db2 = o->data[3];
+            if (r->cmsk & CAN_IF1CMSK_CLRINTPND)
+                o->mctl &= ~CAN_IF1MCTL_INTPND;
+            if (r->cmsk & CAN_IF1CMSK_NEWDAT)
+                o->mctl &= ~CAN_IF1MCTL_NEWDAT;
+        }
+    }
+
+    // INT: status first, then the lowest-numbered object with INTPND
+    uint32_t interrupt() {
+        if (!(ctl & CAN_CTL_IE))
+            return 0;
+        if (statusPending && (ctl & CAN_CTL_EIE))
+            return CAN_INT_INTID_STATUS;
+        for (uint32_t i = 1; i <= 32; i++)
+        {
+            if (object[i].mctl & CAN_IF1MCTL_INTPND)
+                return i;
+        }
+        return 0;
+    }
+
+    // a frame on the bus: the first matching receive object with NEWDAT
+    // clear stores it; a full FIFO overwrites its EOB object (MSGLST).
+    // Returns false if no object accepted it.
+    bool receive(const simFrame* f) {
+        bool extended = (f->id & CAN_ID_EXTENDED) != 0;
+        uint32_t id = extended ? f->id & 0x1FFFFFFF : (f->id & 0x7FF) << 18;
+        for (uint32_t i = 1; i <= 32; i++)
+        {
+            simObject* o = &object[i];
+            if (!(o->arb2 & CAN_IF1ARB2_MSGVAL) || (o->arb2 & CAN_IF1ARB2_DIR))
+                continue;
+            uint32_t objectId = (o->arb2 & 0x1FFF) << 16 | o->arb1;
+            uint32_t mask = 0x1FFFFFFF;
+            bool matchXtd = true;
+            if (o->mctl & CAN_IF1MCTL_UMASK)
+            {
+                mask = (o->msk2 & 0x1FFF) << 16 | o->msk1;
+                matchXtd = (o->msk2 & CAN_IF1MSK2_MXTD) != 0;
+            }
+            if (matchXtd && extended != ((o->arb2 & CAN_IF1ARB2_XTD) != 0))
+                continue;
+            if (((id ^ objectId) & mask) != 0)
+                continue;
+            if ((o->mctl & CAN_IF1MCTL_NEWDAT) && !(o->mctl & CAN_IF1MCTL_EOB))
+                continue;
+
+            if (o->mctl & CAN_IF1MCTL_NEWDAT)
+                o->mctl |= CAN_IF1MCTL_MSGLST;
+            if (extended)
+            {
+                o->arb1 = id & 0xFFFF;
+                o->arb2 = (o->arb2 & ~0x1FFF) | id >> 16;
+            }
+            else
+            {
+                o->arb2 = (o->arb2 & ~0x1FFF) | (f->id & 0x7FF) << 2;
+            }
+            uint32_t d[4] = { 0, 0, 0, 0 };
+            for (int b = 0; b < 8; b++)
+            {
+                d[b >> 1] |= (uint32_t)f->data[b] << ((b & 1) * 8);
+            }
+            memcpy(o->data, d, sizeof(d));
+            o->mctl = (o->mctl & ~CAN_IF1MCTL_DLC_M) | CAN_IF1MCTL_NEWDAT | f->length;
+            if (o->mctl & CAN_IF1MCTL_RXIE)
+                o->mctl |= CAN_IF1MCTL_INTPND;
+            return true;
+        }
+        return false;
+    }
+
+    // send the transmit request of the lowest pending object, if any
+    bool transmit() {
+        for (uint32_t i = 1; i <= 32; i++)
+        {
+            simObject* o = &object[i];
+            if (!(o->mctl & CAN_IF1MCTL_TXRQST))
+                continue;
+            simFrame f;
+            if (o->arb2 & CAN_IF1ARB2_XTD)
+                f.id = CAN_ID_EXTENDED | (o->arb2 & 0x1FFF) << 16 | o->arb1;
+            else
+                f.id = (o->arb2 & 0x1FFF) >> 2;
+            f.length = o->mctl & CAN_IF1MCTL_DLC_M;
+            for (int b = 0; b < 8; b++)
+            {
+                f.data[b] = o->data[b >> 1] >> ((b & 1) * 8);
+            }
+            o->mctl &= ~CAN_IF1MCTL_TXRQST;
+            if (o->mctl & CAN_IF1MCTL_TXIE)
+                o->mctl |= CAN_IF1MCTL_INTPND;
+            if (sentCount < 64)
+                sent[sentCount++] = f;
+            if ((ctl & CAN_CTL_TEST) && (tst & CAN_TST_LBACK))
+                receive(&f);
+            return true;
+        }
+        return false;
+    }
+};
+
+// Define variables
+static CanSim sim;
+
+// register views that forward to the model
+struct simCommand
+{
+    int n;
+    simCommand& operator=(uint32_t v) { sim.command(n, v); return *this; }
+    operator uint32_t() const { return 0; }   // never busy
+};
+
+struct simInt
+{
+    operator uint32_t() const { return sim.interrupt(); }
+};
+
+struct simStatus
+{
+    uint32_t value;
+    simStatus& operator=(uint32_t v) { value = v; return *this; }
+    operator uint32_t() { sim.statusPending = false; return value; }   // read clears
+};
+
+static simCommand if1Command = { 0 };
+static simCommand if2Command = { 1 };
+static simInt canInt;
+static simStatus canStatus;
+static uint32_t sysctlRcgcCan, sysctlRcgc2, portEAfsel, portEPctl, portEAmsel, portEDen, nvicEn1;
+
+#undef CAN0_IF1CRQ_R
+#undef CAN0_IF1CMSK_R
+#undef CAN0_IF1MSK1_R
+#undef CAN0_IF1MSK2_R
+#undef CAN0_IF1ARB1_R
+#undef CAN0_IF1ARB2_R
+#undef CAN0_IF1MCTL_R
+#undef CAN0_IF1DA1_R
+#undef CAN0_IF1DA2_R
+#undef CAN0_IF1DB1_R
+#undef CAN0_IF1DB2_R
+#undef CAN0_IF2CRQ_R
+#undef CAN0_IF2CMSK_R
+#undef CAN0_IF2MSK1_R
+#undef CAN0_IF2MSK2_R
+#undef CAN0_IF2ARB1_R
+#undef CAN0_IF2ARB2_R
+#undef CAN0_IF2MCTL_R
+#undef CAN0_IF2DA1_R
+#undef CAN0_IF2DA2_R
+#undef CAN0_IF2DB1_R
+#undef CAN0_IF2DB2_R
+#undef CAN0_INT_R
+#undef CAN0_STS_R
+#undef CAN0_CTL_R
+#undef CAN0_TST_R
+#undef CAN0_BIT_R
+#undef CAN0_BRPE_R
+#undef SYSCTL_RCGCCAN_R
+#undef SYSCTL_RCGC2_R
+#undef GPIO_PORTE_AFSEL_R
+#undef GPIO_PORTE_PCTL_R
+#undef GPIO_PORTE_AMSEL_R
+#undef GPIO_PORTE_DEN_R
+#undef NVIC_EN1_R
+
+#define CAN0_IF1CRQ_R       if1Command
+#define CAN0_IF1CMSK_R      sim.ifr[0].cmsk
+#define CAN0_IF1MSK1_R      sim.ifr[0].msk1
+#define CAN0_IF1MSK2_R      sim.ifr[0].msk2
+#define CAN0_IF1ARB1_R      sim.ifr[0].arb1
+#define CAN0_IF1ARB2_R      sim.ifr[0].arb2
+#define CAN0_IF1MCTL_R      sim.ifr[0].mctl
+#define CAN0_IF1DA1_R       sim.ifr[0].da1
+#define CAN0_IF1DA2_R       sim.ifr[0].da2
+#define CAN0_IF1DB1_R       sim.ifr[0].db1
+#define CAN0_IF1DB2_R       sim.ifr[0].db2
+#define CAN0_IF2CRQ_R       if2Command
+#define CAN0_IF2CMSK_R      sim.ifr[1].cmsk
+#define CAN0_IF2MSK1_R      sim.ifr[1].msk1
+#define CAN0_IF2MSK2_R      sim.ifr[1].msk2
+#define CAN0_IF2ARB1_R      sim.ifr[1].arb1
+#define CAN0_IF2ARB2_R      sim.ifr[1].arb2
+#define CAN0_IF2MCTL_R      sim.ifr[1].mctl
+#define CAN0_IF2DA1_R       sim.ifr[1].da1
+#define CAN0_IF2DA2_R       sim.ifr[1].da2
+#define CAN0_IF2DB1_R       sim.ifr[1].db1
+#define CAN0_IF2DB2_R       sim.ifr[1].db2
+#define CAN0_INT_R          canInt
+#define CAN0_STS_R          canStatus
+#define CAN0_CTL_R          sim.ctl
+#define CAN0_TST_R          sim.tst
+#define CAN0_BIT_R          sim.bit
+#define CAN0_BRPE_R         sim.brpe
+#define SYSCTL_RCGCCAN_R    sysctlRcgcCan
+#define SYSCTL_RCGC2_R      sysctlRcgc2
+#define GPIO_PORTE_AFSEL_R  portEAfsel
+#define GPIO_PORTE_PCTL_R   portEPctl
+#define GPIO_PORTE_AMSEL_R  portEAmsel
+#define GPIO_PORTE_DEN_R    portEDen
+#define NVIC_EN1_R          nvicEn1
+
+// the driver under test, with its register include already satisfied
+#include "can.cpp"
+
+//-----------------------------------------------------------------------------
+// Checks
+//-----------------------------------------------------------------------------
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// run the ISR while the controller has something to report
+static void service() {
+    while (sim.interrupt() != 0)
+    {
+        CAN0_Handler();
+    }
+}
+
+// let the bus carry everything queued for transmit
+static void drainBus() {
+    do
+    {
+        service();
+    }
+    while (sim.transmit());
+    service();
+}
+
+static canFrame frameOf(uint32_t id, uint32_t sequence) {
+    canFrame f;
+    memset(&f, 0, sizeof(f));
+    f.id = id;
+    f.length = 8;
+    memcpy(f.data, &sequence, sizeof(sequence));
+    return f;
+}
+
+static simFrame simFrameOf(uint32_t id, uint32_t sequence) {
+    simFrame f;
+    memset(&f, 0, sizeof(f));
+    f.id = id;
+    f.length = 8;
+    memcpy(f.data, &sequence, sizeof(sequence));
+    return f;
+}
+
+static uint32_t sequenceOf(const canFrame* f) {
+    uint32_t sequence;
+    memcpy(&sequence, f->data, sizeof(sequence));
+    return sequence;
+}
+
+static uint8_t bufA[4096] __attribute__((aligned(4)));
+static uint8_t bufB[1024] __attribute__((aligned(4)));
+static uint8_t bufC[1024] __attribute__((aligned(4)));
+
+static void functional() {
+    canSubscriber a, b, c;
+    canFrame f;
+
+    memset(&sim, 0, sizeof(sim));
+    check(!Can::init(300000, true), "300 kbit/s does not divide 40 MHz / 20 and is refused");
+    check(Can::init(1000000, true), "init at 1 Mbit/s in loopback");
+    check(Can::subscribe(&a, 0x100, 0x7FF, 4, bufA, sizeof(bufA)), "subscribe 0x100, FIFO of 4");
+    check(Can::subscribe(&b, 0x200, 0x700, 1, bufB, sizeof(bufB)), "subscribe 0x200-0x2FF");
+    check(Can::subscribe(&c, CAN_ID_EXTENDED | 0x1ABCDE0, 0x1FFFFFF0, 2, bufC, sizeof(bufC)),
+          "subscribe extended 0x1ABCDEx");
+
+    // filtering
+    tickCount = 42;
+    canFrame out[5] = { frameOf(0x100, 1), frameOf(0x250, 2), frameOf(0x300, 3),
+                        frameOf(CAN_ID_EXTENDED | 0x1ABCDE5, 4), frameOf(0x0E5, 5) };
+    for (int i = 0; i < 5; i++)
+    {
+        check(Can::send(&out[i], NO_WAIT), "send in loopback");
+        drainBus();
+    }
+    check(Can::receive(&a, &f, NO_WAIT) && f.id == 0x100 && sequenceOf(&f) == 1 && f.timestamp == 42,
+          "0x100 reaches its subscriber with the tick stamp");
+    check(Can::receive(&b, &f, NO_WAIT) && f.id == 0x250, "0x250 passes the 0x2xx mask");
+    check(Can::receive(&c, &f, NO_WAIT) && f.id == (CAN_ID_EXTENDED | 0x1ABCDE5) && sequenceOf(&f) == 4,
+          "extended frame reaches the extended filter");
+    check(!Can::receive(&a, &f, NO_WAIT) && !Can::receive(&b, &f, NO_WAIT) && !Can::receive(&c, &f, NO_WAIT),
+          "0x300 and the standard 0x0E5 are filtered out");
+
+    // FIFO chain: four objects absorb a burst, the fifth frame overwrites the last
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        simFrame s = simFrameOf(0x100, 10 + i);
+        sim.receive(&s);
+    }
+    service();
+    bool ordered = true;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        ordered &= Can::receive(&a, &f, NO_WAIT) && sequenceOf(&f) == (i < 3 ? 10 + i : 14);
+    }
+    check(ordered, "FIFO chain delivers a burst in arrival order");
+    check(a.lost == 1 && a.dropped == 0, "overflowing the chain counts one MSGLST");
+
+    // transmit order: while 0x300 is on the bus, the rest go out by ID
+    sim.sentCount = 0;
+    canFrame queued[5] = { frameOf(0x300, 0), frameOf(CAN_ID_EXTENDED | 0x100 << 18, 0),
+                           frameOf(0x200, 0), frameOf(0x100, 0), frameOf(0x7FF, 0) };
+    for (int i = 0; i < 5; i++)
+    {
+        Can::send(&queued[i], NO_WAIT);
+    }
+    drainBus();
+    uint32_t expect[5] = { 0x300, 0x100, CAN_ID_EXTENDED | 0x100 << 18, 0x200, 0x7FF };
+    bool inOrder = sim.sentCount == 5;
+    for (uint32_t i = 0; inOrder && i < 5; i++)
+    {
+        inOrder = sim.sent[i].id == expect[i];
+    }
+    check(inOrder, "transmit queue follows arbitration order");
+
+    // a full transmit queue refuses with NO_WAIT while the bus is stalled
+    uint32_t accepted = 0;
+    for (int i = 0; i < CAN_TX_QUEUE_SIZE + 4; i++)
+    {
+        canFrame q = frameOf(0x400 + i, 0);
+        accepted += Can::send(&q, NO_WAIT);
+    }
+    check(accepted == CAN_TX_QUEUE_SIZE + 1, "transmit object plus queue hold the burst");
+    drainBus();
+
+    printf("functional checks: %s\n", failures == 0 ? "pass" : "FAIL");
+}
+
+//-----------------------------------------------------------------------------
+// Bus load
+//-----------------------------------------------------------------------------
+
+// One ID back to back on a saturated 1 Mbit/s bus. Every millisecond the CPU
+// masks interrupts for maskUs (other ISRs, critical sections); the reader
+// task drains its queue every readerMs. Returns frames lost in hardware plus
+// frames dropped from the queue; the reader checks the sequence as well.
+static uint32_t busLoad(uint8_t depth, uint32_t maskUs, uint32_t readerMs, uint32_t queueSize,
+                        uint32_t* lost, uint32_t* dropped) {
+    static uint8_t buf[8192] __attribute__((aligned(4)));
+    canSubscriber sub;
+    canFrame f;
+
+    memset(&sim, 0, sizeof(sim));
+    Can::init(1000000, false);
+    Can::subscribe(&sub, 0x123, 0x7FF, depth, buf, queueSize);
+
+    uint32_t sent = 0, received = 0, gaps = 0, expect = 0;
+    for (uint32_t us = 0; us < SIM_MS * 1000; us++)
+    {
+        if (us % 1000 == 0)
+            tickCount++;
+        if (us % FRAME_BITS == 0)
+        {
+            simFrame s = simFrameOf(0x123, sent++);
+            sim.receive(&s);
+        }
+        if (us % 1000 >= maskUs)
+            service();
+        if (us % (readerMs * 1000) == readerMs * 1000 - 1)
+        {
+            while (Can::receive(&sub, &f, NO_WAIT))
+            {
+                gaps += sequenceOf(&f) - expect;
+                expect = sequenceOf(&f) + 1;
+                received++;
+            }
+        }
+    }
+    *lost = sub.lost;
+    *dropped = sub.dropped;
+    return gaps;
+}
+
+int main() {
+    functional();
+
+    printf("\n1 Mbit/s, %u-bit frames (%u frames/s), %u ms per run\n",
+           FRAME_BITS, 1000000 / FRAME_BITS, SIM_MS);
+    printf("depth  masked/ms  reader  queue   lost  dropped  gaps\n");
+    static const uint8_t depths[] = { 1, 2, 4 };
+    static const uint32_t masks[] = { 50, 200, 400 };
+    for (uint8_t d : depths)
+    {
+        for (uint32_t m : masks)
+        {
+            uint32_t lost, dropped;
+            uint32_t gaps = busLoad(d, m, 10, 4096, &lost, &dropped);
+            printf("%5u  %6u us  %3u ms  %5u  %5u  %7u  %4u\n", d, m, 10u, 4096u, lost, dropped, gaps);
+        }
+    }
+    uint32_t lost, dropped;
+    uint32_t gaps = busLoad(4, 200, 50, 4096, &lost, &dropped);
+    printf("%5u  %6u us  %3u ms  %5u  %5u  %7u  %4u\n", 4, 200u, 50u, 4096u, lost, dropped, gaps);
+    gaps = busLoad(4, 200, 50, 8192, &lost, &dropped);
+    printf("%5u  %6u us  %3u ms  %5u  %5u  %7u  %4u\n", 4, 200u, 50u, 8192u, lost, dropped, gaps);
+    return failures != 0;
+}
@@ -0,0 +1,196 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+//-----------------------------------------------------------------------------
+// CRC engines against TivaWare's sw_crc, on the host
+//-----------------------------------------------------------------------------
+
+// Checks kernel/crc.cpp against bitwise reference CRCs and driverlib's
+// sw_crc.c (CRC-32 only: its Crc16 is CRC-16/ARC, not the X.25 FCS), over
+// every alignment and short length, split streams and combine32/16. Then
+// times both over aligned and unaligned buffers of several sizes and prints
+// bytes per cycle, using the time-stamp counter where the host has one.
+// Build and run from the top level, adding -DCRC_TABLES_SRAM to both
+// compiles to check the tables Crc::init() fills in SRAM:
+//   T=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178
+//   gcc -O2 -c -w -I$T $T/driverlib/sw_crc.c
+//   g++ -O2 -std=c++17 -Ikernel -I$T bench/crc.cpp kernel/crc.cpp sw_crc.o
+//   ./a.out
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "crc.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+extern "C" {
+#include "driverlib/sw_crc.h"
+}
+
+#define RUN_BYTES       (64u << 20)     // bytes hashed per timing
+
+// Define variables
+static uint8_t buffer[4096 + 8];
+static volatile uint32_t sink;
+static uint32_t failures;
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// References
+//-----------------------------------------------------------------------------
+
+static uint32_t bitwise32(const uint8_t* p, uint32_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    while (length-- > 0)
+    {
+        crc ^= *p++;
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static uint16_t bitwise16(const uint8_t* p, uint32_t length) {
+    uint16_t crc = 0xFFFF;
+    while (length-- > 0)
+    {
+        crc ^= *p++;
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t tivaware32(const uint8_t* p, uint32_t length) {
+    // Crc32 underflows its count on an odd address with no data
+    if (length == 0)
+        return 0;
+    return Crc32(0xFFFFFFFF, p, length) ^ 0xFFFFFFFF;
+}
+
+static void functional() {
+    check(Crc::crc32(0, "123456789", 9) == 0xCBF43926, "CRC-32 check value");
+    check(Crc::crc16(0, "123456789", 9) == 0x906E, "CRC-16/X.25 check value");
+
+    for (uint32_t offset = 0; offset < 8; offset++)
+    {
+        for (uint32_t length = 0; length < 300; length++)
+        {
+            const uint8_t* p = buffer + offset;
+            uint32_t c32 = Crc::crc32(0, p, length);
+            uint16_t c16 = Crc::crc16(0, p, length);
+            if (c32 != bitwise32(p, length) || c32 != tivaware32(p, length))
+            {
+                check(false, "CRC-32 matches the references");
+                return;
+            }
+            if (c16 != bitwise16(p, length))
+            {
+                check(false, "CRC-16 matches the reference");
+                return;
+            }
+
+            // streaming and combine over every split point of a short buffer
+            uint32_t split = length / 3;
+            uint32_t a32 = Crc::crc32(0, p, split);
+            uint32_t b32 = Crc::crc32(0, p + split, length - split);
+            uint16_t a16 = Crc::crc16(0, p, split);
+            uint16_t b16 = Crc::crc16(0, p + split, length - split);
+            if (Crc::crc32(a32, p + split, length - split) != c32 ||
+                Crc::combine32(a32, b32, length - split) != c32 ||
+                Crc::crc16(a16, p + split, length - split) != c16 ||
+                Crc::combine16(a16, b16, length - split) != c16)
+            {
+                check(false, "streaming and combine agree with one pass");
+                return;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Throughput
+//-----------------------------------------------------------------------------
+
+static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return clock();
+#endif
+}
+
+template <typename F>
+static double bytesPerCycle(F crc, uint32_t offset, uint32_t length) {
+    uint32_t runs = RUN_BYTES / length;
+    uint64_t start = now();
+    for (uint32_t i = 0; i < runs; i++)
+    {
+        sink = crc(buffer + offset, length);
+    }
+    return (double)runs * length / (now() - start);
+}
+
+int main() {
+    srand(1);
+    for (uint32_t i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = rand();
+    }
+    Crc::init();
+    functional();
+
+#if defined(__x86_64__) || defined(__i386__)
+    printf("bytes per TSC cycle, %u MB per timing, CRC_SLICES %u\n", RUN_BYTES >> 20, CRC_SLICES);
+#else
+    printf("bytes per clock() tick, %u MB per timing, CRC_SLICES %u\n", RUN_BYTES >> 20, CRC_SLICES);
+#endif
+    printf("length  offset   sw_crc Crc32   crc32   speedup   sw_crc Crc16   crc16   speedup\n");
+    static const uint32_t lengths[] = { 16, 64, 576, 4096 };
+    for (uint32_t length : lengths)
+    {
+        for (uint32_t offset = 0; offset < 2; offset++)
+        {
+            double sw32 = bytesPerCycle([](const uint8_t* p, uint32_t n) { return Crc32(0xFFFFFFFF, p, n); }, offset, length);
+            double ours32 = bytesPerCycle([](const uint8_t* p, uint32_t n) { return Crc::crc32(0, p, n); }, offset, length);
+            double sw16 = bytesPerCycle([](const uint8_t* p, uint32_t n) { return (uint32_t)Crc16(0, p, n); }, offset, length);
+            double ours16 = bytesPerCycle([](const uint8_t* p, uint32_t n) { return (uint32_t)Crc::crc16(0, p, n); }, offset, length);
+            printf("%6u  %6u   %12.3f  %6.3f   %6.2fx   %12.3f  %6.3f   %6.2fx\n", length, offset,
+                   sw32, ours32, ours32 / sw32, sw16, ours16, ours16 / sw16);
+        }
+    }
+    printf("%s\n", failures == 0 ? "all checks passed" : "checks FAILED");
+    return failures != 0;
+}
@@ -0,0 +1,209 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+
+//-----------------------------------------------------------------------------
+// Fixed-point library against libm, on the host
+//-----------------------------------------------------------------------------
+
+// Samples FixedMath::sin/cos/atan2/sqrt/exp at POINTS random arguments in Q24
+// and Q28 and compares each with libm in double: absolute error for sin, cos
+// and atan2, relative error for sqrt and exp. Then checks that the
+// saturating operations, integer and real constructors, format conversions
+// and FixedOps::rescale clamp at the range limits instead of wrapping, and
+// times sin and atan2. Build and run from the top level:
+//   g++ -O2 -std=c++17 -Ilib bench/fixed.cpp
+//   ./a.out
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "fixed.h"
+
+#define POINTS          200000
+#define RUNS            (1 << 22)   // calls per timing
+
+typedef Fixed<4, 28> Q28;
+
+// Define variables
+static uint32_t failures;
+static volatile int32_t sink;
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double uniform(double lo, double hi) {
+    return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+}
+
+//-----------------------------------------------------------------------------
+// Accuracy
+//-----------------------------------------------------------------------------
+
+// worst error of each function in one format; bounds are a little above
+// what the tables give, so a regression in any of them shows up
+template <typename Q>
+static void accuracy(const char* name, double range, double expLo, double expHi, const double* bounds) {
+    double worst[5] = {};
+    for (uint32_t n = 0; n < POINTS; n++)
+    {
+        Q x(uniform(-range, range)), y(uniform(-range, range));
+        double a = x.toDouble(), b = y.toDouble();
+        double e;
+
+        e = fabs(FixedMath::sin(x).toDouble() - ::sin(a));
+        worst[0] = e > worst[0] ? e : worst[0];
+        e = fabs(FixedMath::cos(x).toDouble() - ::cos(a));
+        worst[0] = e > worst[0] ? e : worst[0];
+
+        e = fabs(FixedMath::atan2(y, x).toDouble() - ::atan2(b, a));
+        worst[1] = e > worst[1] ? e : worst[1];
+
+        // sqrt and exp are relative, away from the bottom where one step of
+        // the format is most of the result
+        Q r(uniform(0.01, range));
+        double root = ::sqrt(r.toDouble());
+        e = fabs(FixedMath::sqrt(r).toDouble() - root) / root;
+        worst[2] = e > worst[2] ? e : worst[2];
+
+        Q p(uniform(expLo, expHi));
+        double power = ::exp(p.toDouble());
+        e = fabs(FixedMath::exp(p).toDouble() - power) / power;
+        worst[3] = e > worst[3] ? e : worst[3];
+    }
+
+    printf("%s  sin/cos %.1e  atan2 %.1e  sqrt %.1e rel  exp %.1e rel\n",
+           name, worst[0], worst[1], worst[2], worst[3]);
+    check(worst[0] < bounds[0], "sin/cos within bound");
+    check(worst[1] < bounds[1], "atan2 within bound");
+    check(worst[2] < bounds[2], "sqrt within bound");
+    check(worst[3] < bounds[3], "exp within bound");
+}
+
+//-----------------------------------------------------------------------------
+// Saturation and Format Conversion
+//-----------------------------------------------------------------------------
+
+static void saturation() {
+    const Q24 eps = Q24::epsilon();
+    check(Q24::addSat(Q24::max(), eps) == Q24::max(), "addSat clamps at max");
+    check(Q24::subSat(Q24::min(), eps) == Q24::min(), "subSat clamps at min");
+    check(Q24::addSat(Q24(100), Q24(-30)) == Q24(70), "addSat in range is exact");
+    check(Q24::mulSat(Q24(100), Q24(100)) == Q24::max(), "mulSat clamps at max");
+    check(Q24::mulSat(Q24(100), Q24(-100)) == Q24::min(), "mulSat clamps at min");
+    check(Q24::mulSat(Q24(1.5), Q24(-2.5)) == Q24(-3.75), "mulSat in range is exact");
+    check(Q24::abs(Q24::min()) == Q24::max(), "abs of min is max");
+    check(Q24(1000) == Q24::max() && Q24(-1000) == Q24::min(), "integer constructor saturates");
+    check(Q24(1e6) == Q24::max() && Q24(-1e6f) == Q24::min(), "real constructor saturates");
+    check(Q24(0.5 / Q24::one) == eps, "real constructor rounds to nearest");
+
+    int64_t acc = 0;
+    acc = Q24::mac(acc, Q24(100), Q24(100));
+    check(Q24::fromAcc(acc) == Q24::max(), "fromAcc clamps at max");
+    acc = 0;
+    for (int32_t i = 0; i < 3; i++)
+    {
+        acc = Q24::mac(acc, Q24::fromRaw(1), Q24(0.5));      // half a step each, rounded once
+    }
+    check(Q24::fromAcc(acc) == Q24::fromRaw(2), "fromAcc rounds the whole sum once");
+
+    check(Q28(Q24(100)) == Q28::max() && Q28(Q24(-100)) == Q28::min(), "narrowing conversion saturates");
+    check(Q28(Q24(-3.5)) == Q28(-3.5), "narrowing conversion in range is exact");
+    check(Q24(Q28::fromRaw(-1)) == Q24::fromRaw(-1), "widening conversion floors");
+    static_assert(Q31(Fixed<32, 0>(1)) == Q31::max(), "constant conversions saturate to max");
+    check(Q31(Fixed<32, 0>(-3)) == Q31::min(), "integer to Q31 saturates at min");
+
+    check(FixedMath::exp(Q24(10)) == Q24::max(), "exp saturates on overflow");
+    check(FixedMath::exp(Q24(-30)) == Q24(), "exp underflows to 0");
+    check(FixedMath::sqrt(Q24(-4)) == Q24(), "sqrt of a negative is 0");
+    check(FixedMath::atan2(Q24(), Q24()) == Q24(), "atan2(0, 0) is 0");
+    check(fabs(FixedMath::atan2(Q24(), Q24(-1)).toDouble() - FIXED_PI) < 1e-6, "atan2(0, -1) is pi");
+}
+
+// FixedOps::rescale against a 64-bit reference over random raw values
+static void rescale() {
+    bool up = true, down = true, wide = true;
+    for (uint32_t n = 0; n < POINTS; n++)
+    {
+        int32_t v = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+        int32_t s = rand() % 8;
+        v >>= s * 3;                    // small values as well as large ones
+        up &= FixedOps::rescale<24, 28>(v) == FixedOps::saturate((int64_t)v * 16);
+        up &= FixedOps::rescale<0, 31>(v) == FixedOps::saturate((int64_t)v * ((int64_t)1 << 31));
+        down &= FixedOps::rescale<28, 24>(v) == (int32_t)floor(v / 16.0);
+        int64_t p = (int64_t)v * (v >> 7);
+        wide &= FixedOps::rescale<48, 24>(p) == FixedOps::saturate(p >> 24);
+        wide &= FixedOps::rescale<20, 24>((int64_t)v) == FixedOps::saturate((int64_t)v * 16);
+    }
+    check(up, "rescale to more fraction bits saturates");
+    check(down, "rescale to fewer fraction bits floors");
+    check(wide, "64-bit rescale saturates");
+}
+
+//-----------------------------------------------------------------------------
+// Speed
+//-----------------------------------------------------------------------------
+
+static double now() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void speed() {
+    Q24 x(-3.0), y(2.0), step = Q24::fromRaw(37);
+    double start = now();
+    for (uint32_t n = 0; n < RUNS; n++)
+    {
+        x += step;
+        sink = FixedMath::sin(x).raw;
+    }
+    double sinNs = (now() - start) * 1e9 / RUNS;
+
+    start = now();
+    for (uint32_t n = 0; n < RUNS; n++)
+    {
+        x += step;
+        sink = FixedMath::atan2(y, x).raw;
+    }
+    double atanNs = (now() - start) * 1e9 / RUNS;
+    printf("host: sin %.1f ns, atan2 %.1f ns\n", sinNs, atanNs);
+}
+
+int main() {
+    srand(1);
+    static const double q24[4] = { 1e-5, 5e-6, 1e-5, 5e-5 };
+    static const double q28[4] = { 1e-5, 5e-6, 1e-5, 1e-5 };
+    accuracy<Q24>("Q24", 100.0, -5.0, 4.8, q24);
+    accuracy<Q28>("Q28", 7.9, -3.0, 2.07, q28);
+    saturation();
+    rescale();
+    speed();
+    printf("%s\n", failures == 0 ? "all checks passed" : "checks FAILED");
+    return failures != 0;
+}
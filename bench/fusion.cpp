@@ -0,0 +1,366 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+//-----------------------------------------------------------------------------
+// Sensor fusion accuracy and speed, on the host
+//-----------------------------------------------------------------------------
+
+// Simulates an IMU tumbling through a smooth rotation, quantised at the
+// scales Imu::init sets, with gyro bias, white noise, and the magnetometer
+// refreshed at 100 Hz as the FIFO delivers it. The same imuBlocks drive the
+// float and Q30 Mahony filters from lib/fusion.cpp and sensorlib's CompDCM,
+// and the RMS and worst attitude error against the true orientation are
+// printed with the host time per sample. At the default gains both Mahony
+// filters must beat the tuned CompDCM on RMS and worst error, and Q30 must
+// stay within Q30_DRIFT of float throughout. Build and run from the top level:
+//   T=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178
+//   gcc -O2 -c -I$T $T/sensorlib/comp_dcm.c $T/sensorlib/vector.c
+//   g++ -O2 -std=c++17 -Ihal -Ilib -I$T bench/fusion.cpp lib/fusion.cpp comp_dcm.o vector.o -lm
+//   ./a.out
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "fusion.h"
+#include "sensorlib/comp_dcm.h"
+
+#define RATE            1000        // Hz
+#define SECONDS         60
+#define SETTLE          5           // seconds before errors count
+#define SAMPLES         (RATE * SECONDS)
+#define BLOCKS          (SAMPLES / IMU_BLOCK_MAX)
+#define SUBSTEPS        10          // truth integration steps per sample
+
+#define GYRO_BIAS       0.5         // deg/s on each axis
+#define GYRO_NOISE      0.05        // deg/s RMS
+#define ACCEL_NOISE     0.004       // g RMS
+#define MAG_NOISE       0.5         // uT RMS
+#define MAG_NORTH       20.0        // uT, earth field in the x (north) - z (up) plane
+#define MAG_UP          -43.0
+
+#define Q30_DRIFT       0.5         // deg, worst Q30 departure from float
+
+struct vec3
+{
+  double x, y, z;
+};
+
+struct mat3
+{
+  double m[3][3];
+};
+
+// Define variables
+static imuBlock blocks[BLOCKS];
+static mat3 truth[SAMPLES];        // body to earth after each sample
+
+static double gauss() {
+    double u = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double v = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+static int16_t quantise(double value) {
+    double r = floor(value + 0.5);
+    return (int16_t)(r > 32767 ? 32767 : r < -32768 ? -32768 : r);
+}
+
+// body rate in rad/s: three incommensurate sweeps, peaks near 200 deg/s
+static vec3 rate(double t) {
+    return { 2.0 * sin(2 * M_PI * 0.31 * t), 1.5 * sin(2 * M_PI * 0.17 * t + 1.0), 2.5 * sin(2 * M_PI * 0.07 * t + 2.0) };
+}
+
+static vec3 transposeTimes(const mat3& r, vec3 v) {
+    return { r.m[0][0] * v.x + r.m[1][0] * v.y + r.m[2][0] * v.z,
+             r.m[0][1] * v.x + r.m[1][1] * v.y + r.m[2][1] * v.z,
+             r.m[0][2] * v.x + r.m[1][2] * v.y + r.m[2][2] * v.z };
+}
+
+// R = R * exp([w]dt), re-orthonormalised
+static void rotate(mat3& r, vec3 w, double dt) {
+    double angle = sqrt(w.x * w.x + w.y * w.y + w.z * w.z) * dt;
+    mat3 d = { { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } };
+    if (angle > 0)
+    {
+        double kx = w.x * dt / angle, ky = w.y * dt / angle, kz = w.z * dt / angle;
+        double s = sin(angle), c = 1 - cos(angle);
+        d.m[0][0] = 1 - c * (ky * ky + kz * kz);
+        d.m[0][1] = -s * kz + c * kx * ky;
+        d.m[0][2] = s * ky + c * kx * kz;
+        d.m[1][0] = s * kz + c * kx * ky;
+        d.m[1][1] = 1 - c * (kx * kx + kz * kz);
+        d.m[1][2] = -s * kx + c * ky * kz;
+        d.m[2][0] = -s * ky + c * kx * kz;
+        d.m[2][1] = s * kx + c * ky * kz;
+        d.m[2][2] = 1 - c * (kx * kx + ky * ky);
+    }
+    mat3 out;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            out.m[i][j] = r.m[i][0] * d.m[0][j] + r.m[i][1] * d.m[1][j] + r.m[i][2] * d.m[2][j];
+    r = out;
+}
+
+static void simulate() {
+    mat3 r = { { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } } };
+    double dt = 1.0 / RATE;
+    double gyroLsb = IMU_GYRO_LSB_PER_DPS * 180.0 / M_PI;    // LSB per rad/s
+    vec3 bias = { GYRO_BIAS * M_PI / 180, -GYRO_BIAS * M_PI / 180, GYRO_BIAS * M_PI / 180 };
+    int16_t mag[3] = { 0, 0, 0 };
+
+    for (int n = 0; n < SAMPLES; n++)
+    {
+        for (int k = 0; k < SUBSTEPS; k++)
+            rotate(r, rate((n + (k + 0.5) / SUBSTEPS) * dt), dt / SUBSTEPS);
+        truth[n] = r;
+
+        imuBlock* b = &blocks[n / IMU_BLOCK_MAX];
+        int i = n % IMU_BLOCK_MAX;
+        b->count = i + 1;
+        b->period = 1000000 / RATE;
+        b->sequence = n - i;
+
+        vec3 w = rate((n + 1) * dt);
+        double gyroNoise = GYRO_NOISE * M_PI / 180;
+        b->gx[i] = quantise((w.x + bias.x + gyroNoise * gauss()) * gyroLsb);
+        b->gy[i] = quantise((w.y + bias.y + gyroNoise * gauss()) * gyroLsb);
+        b->gz[i] = quantise((w.z + bias.z + gyroNoise * gauss()) * gyroLsb);
+
+        vec3 g = transposeTimes(r, { 0, 0, 1 });
+        b->ax[i] = quantise((g.x + ACCEL_NOISE * gauss()) * IMU_ACCEL_LSB_PER_G);
+        b->ay[i] = quantise((g.y + ACCEL_NOISE * gauss()) * IMU_ACCEL_LSB_PER_G);
+        b->az[i] = quantise((g.z + ACCEL_NOISE * gauss()) * IMU_ACCEL_LSB_PER_G);
+
+        if (n % (RATE / 100) == 0)
+        {
+            vec3 m = transposeTimes(r, { MAG_NORTH, 0, MAG_UP });
+            mag[0] = quantise((m.x + MAG_NOISE * gauss()) / IMU_MAG_UT_PER_LSB);
+            mag[1] = quantise((m.y + MAG_NOISE * gauss()) / IMU_MAG_UT_PER_LSB);
+            mag[2] = quantise((m.z + MAG_NOISE * gauss()) / IMU_MAG_UT_PER_LSB);
+        }
+        b->mx[i] = mag[0];
+        b->my[i] = mag[1];
+        b->mz[i] = mag[2];
+    }
+}
+
+static double elapsed(const timespec& start) {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) * 1e9 + (now.tv_nsec - start.tv_nsec);
+}
+
+static void quaternionToMatrix(const float q[4], mat3& r) {
+    double q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+    r.m[0][0] = 1 - 2 * (q2 * q2 + q3 * q3);
+    r.m[0][1] = 2 * (q1 * q2 - q0 * q3);
+    r.m[0][2] = 2 * (q1 * q3 + q0 * q2);
+    r.m[1][0] = 2 * (q1 * q2 + q0 * q3);
+    r.m[1][1] = 1 - 2 * (q1 * q1 + q3 * q3);
+    r.m[1][2] = 2 * (q2 * q3 - q0 * q1);
+    r.m[2][0] = 2 * (q1 * q3 - q0 * q2);
+    r.m[2][1] = 2 * (q2 * q3 + q0 * q1);
+    r.m[2][2] = 1 - 2 * (q1 * q1 + q2 * q2);
+}
+
+// angle of est^T * truth in degrees
+static double angleError(const mat3& est, const mat3& truth) {
+    double trace = 0;
+    for (int i = 0; i < 3; i++)
+        for (int k = 0; k < 3; k++)
+            trace += est.m[k][i] * truth.m[k][i];
+    double c = (trace - 1) / 2;
+    return acos(c > 1 ? 1 : c < -1 ? -1 : c) * 180 / M_PI;
+}
+
+struct score
+{
+  double sum;
+  double worst;
+  int count;
+};
+
+static void account(score* s, int n, const mat3& est) {
+    if (n < SETTLE * RATE)
+        return;
+    double e = angleError(est, truth[n]);
+    s->sum += e * e;
+    s->worst = e > s->worst ? e : s->worst;
+    s->count++;
+}
+
+static uint32_t failures;
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double rms(const score& s) {
+    return sqrt(s.sum / s.count);
+}
+
+static void report(const char* name, const score& s, double ns) {
+    printf("%-22s rms %6.3f deg  worst %6.3f deg  %7.1f ns/sample\n", name, rms(s), s.worst, ns / SAMPLES);
+}
+
+static score runFloat(float kp, float ki) {
+    fusionFilter f;
+    Fusion::init(&f, kp, ki);
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int b = 0; b < BLOCKS; b++)
+        Fusion::update(&f, &blocks[b]);
+    double ns = elapsed(start);
+
+    // second pass sample by sample for the error trace
+    score s = {};
+    Fusion::init(&f, kp, ki);
+    for (int b = 0; b < BLOCKS; b++)
+    {
+        imuBlock one = blocks[b];
+        for (int i = 0; i < blocks[b].count; i++)
+        {
+            one.count = 1;
+            one.ax[0] = blocks[b].ax[i]; one.ay[0] = blocks[b].ay[i]; one.az[0] = blocks[b].az[i];
+            one.gx[0] = blocks[b].gx[i]; one.gy[0] = blocks[b].gy[i]; one.gz[0] = blocks[b].gz[i];
+            one.mx[0] = blocks[b].mx[i]; one.my[0] = blocks[b].my[i]; one.mz[0] = blocks[b].mz[i];
+            Fusion::update(&f, &one);
+            mat3 est;
+            quaternionToMatrix(f.q, est);
+            account(&s, b * IMU_BLOCK_MAX + i, est);
+        }
+    }
+    char name[40];
+    snprintf(name, sizeof(name), "float kp %.1f ki %.2f", kp, ki);
+    report(name, s, ns);
+    return s;
+}
+
+// also tracks the worst angle between Q30 and a float filter fed alongside
+static score runFixed(float kp, float ki, double* drift) {
+    fusionFilterQ f;
+    Fusion::init(&f, kp, ki);
+    timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int b = 0; b < BLOCKS; b++)
+        Fusion::update(&f, &blocks[b]);
+    double ns = elapsed(start);
+
+    score s = {};
+    fusionFilter reference;
+    Fusion::init(&f, kp, ki);
+    Fusion::init(&reference, kp, ki);
+    *drift = 0;
+    for (int b = 0; b < BLOCKS; b++)
+    {
+        imuBlock one = blocks[b];
+        for (int i = 0; i < blocks[b].count; i++)
+        {
+            one.count = 1;
+            one.ax[0] = blocks[b].ax[i]; one.ay[0] = blocks[b].ay[i]; one.az[0] = blocks[b].az[i];
+            one.gx[0] = blocks[b].gx[i]; one.gy[0] = blocks[b].gy[i]; one.gz[0] = blocks[b].gz[i];
+            one.mx[0] = blocks[b].mx[i]; one.my[0] = blocks[b].my[i]; one.mz[0] = blocks[b].mz[i];
+            Fusion::update(&f, &one);
+            Fusion::update(&reference, &one);
+            float q[4];
+            Fusion::quaternion(&f, q);
+            mat3 est, ref;
+            quaternionToMatrix(q, est);
+            quaternionToMatrix(reference.q, ref);
+            account(&s, b * IMU_BLOCK_MAX + i, est);
+            double d = angleError(est, ref);
+            *drift = d > *drift ? d : *drift;
+        }
+    }
+    char name[40];
+    snprintf(name, sizeof(name), "Q30   kp %.1f ki %.2f", kp, ki);
+    report(name, s, ns);
+    printf("%-22s worst %6.3f deg from float\n", "", *drift);
+    return s;
+}
+
+static score runDcm(float scaleA, float scaleG, float scaleM) {
+    const float gyroScale = (float)(M_PI / 180.0) / IMU_GYRO_LSB_PER_DPS;
+    tCompDCM dcm;
+    score s = {};
+    double ns = 0;
+
+    CompDCMInit(&dcm, 1.0f / RATE, scaleA, scaleG, scaleM);
+    for (int n = 0; n < SAMPLES; n++)
+    {
+        const imuBlock* b = &blocks[n / IMU_BLOCK_MAX];
+        int i = n % IMU_BLOCK_MAX;
+        timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        CompDCMAccelUpdate(&dcm, b->ax[i], b->ay[i], b->az[i]);
+        CompDCMMagnetoUpdate(&dcm, b->mx[i], b->my[i], b->mz[i]);
+        if (n == 0)
+        {
+            CompDCMStart(&dcm);
+        }
+        else
+        {
+            // CompDCMUpdate turns its rows by +rate*dt, the opposite sense to these body rates
+            CompDCMGyroUpdate(&dcm, -b->gx[i] * gyroScale, -b->gy[i] * gyroScale, -b->gz[i] * gyroScale);
+            CompDCMUpdate(&dcm);
+        }
+        ns += elapsed(start);
+
+        // the DCM rows are the earth axes in sensor coordinates, i.e. the rows of body to earth
+        float m[3][3];
+        CompDCMMatrixGet(&dcm, m);
+        mat3 est;
+        for (int r = 0; r < 3; r++)
+            for (int c = 0; c < 3; c++)
+                est.m[r][c] = m[r][c];
+        account(&s, n, est);
+    }
+    char name[40];
+    snprintf(name, sizeof(name), "CompDCM %.3f/%.1f/%.3f", scaleA, scaleG, scaleM);
+    report(name, s, ns);
+    return s;
+}
+
+int main() {
+    srand(1);
+    simulate();
+    printf("%d s at %d Hz, blocks of %d, errors after %d s\n", SECONDS, RATE, IMU_BLOCK_MAX, SETTLE);
+    double drift;
+    runDcm(0.2f, 0.6f, 0.2f);        // weights from the TivaWare compdcm_mpu9150 example
+    score dcm = runDcm(0.005f, 1.0f, 0.005f);
+    runFloat(0.5f, 0.0f);
+    score mahony = runFloat(FUSION_KP, FUSION_KI);
+    runFixed(0.5f, 0.0f, &drift);
+    check(drift < Q30_DRIFT, "Q30 tracks float without integral gain");
+    score fixed = runFixed(FUSION_KP, FUSION_KI, &drift);
+    check(drift < Q30_DRIFT, "Q30 tracks float at the default gains");
+
+    check(rms(mahony) < rms(dcm) && mahony.worst < dcm.worst, "float Mahony beats the tuned CompDCM");
+    check(rms(fixed) < rms(dcm) && fixed.worst < dcm.worst, "Q30 Mahony beats the tuned CompDCM");
+    printf("%s\n", failures == 0 ? "all checks passed" : "checks FAILED");
+    return failures != 0;
+}
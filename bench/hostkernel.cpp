@@ -0,0 +1,156 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+//-----------------------------------------------------------------------------
+// Host kernel stand-in for benchmarks
+//-----------------------------------------------------------------------------
+
+// Provides the kernel symbols drivers link against (tcb, tickCount, RTOS
+// tasks and notifications, Mutex) on the host. See hostkernel.h.
+
+#include <stdlib.h>
+#include <ucontext.h>
+#include "hostkernel.h"
+#include "sync.h"
+
+#define HOST_STACK      (256 * 1024)    // bytes per createProcess() task
+
+// Define variables
+void (*hostIdle)() = 0;
+uint8_t taskCurrent = 0;
+uint8_t taskCount = 1;
+volatile uint32_t tickCount = 0;
+struct _tcb tcb[MAX_TASKS];
+static ucontext_t contexts[MAX_TASKS];  // slot 0 is main()
+
+uint32_t disableInterrupts() {
+    return 0;
+}
+
+void restoreInterrupts(uint32_t) {
+}
+
+void enterCritical() {
+}
+
+void exitCritical() {
+}
+
+//-----------------------------------------------------------------------------
+// RTOS
+//-----------------------------------------------------------------------------
+
+bool RTOS::createProcess(_fn fn, int priority) {
+    // a cooperative task on its own stack; like the kernel's, it must not return
+    for (uint8_t i = 1; i < MAX_TASKS; i++)
+    {
+        if (tcb[i].state == STATE_INVALID)
+        {
+            getcontext(&contexts[i]);
+            contexts[i].uc_stack.ss_sp = malloc(HOST_STACK);
+            contexts[i].uc_stack.ss_size = HOST_STACK;
+            contexts[i].uc_link = 0;
+            makecontext(&contexts[i], fn, 0);
+            tcb[i].pid = (void*)fn;
+            tcb[i].priority = priority;
+            tcb[i].currentPriority = priority;
+            tcb[i].notify = NOTIFY_NONE;
+            tcb[i].state = STATE_READY;
+            taskCount++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void RTOS::yield() {
+    // tasks take turns, main() first; each round through them is one tick,
+    // during which the simulation runs
+    uint8_t from = taskCurrent;
+    uint8_t to = from;
+    do
+    {
+        to = (to + 1) % MAX_TASKS;
+    } while (to != 0 && tcb[to].state == STATE_INVALID);
+
+    if (to == 0)
+    {
+        tickCount++;
+        if (hostIdle != 0)
+            hostIdle();
+    }
+    if (to != from)
+    {
+        taskCurrent = to;
+        swapcontext(&contexts[from], &contexts[to]);
+    }
+    tcb[taskCurrent].state = STATE_READY;
+}
+
+void RTOS::sleep(uint32_t tick) {
+    while (tick-- > 0)
+    {
+        yield();
+    }
+}
+
+bool RTOS::waitNotify(uint32_t timeout) {
+    uint32_t start = tickCount;
+    while (tcb[taskCurrent].notify != NOTIFY_PENDING)
+    {
+        if (timeout != WAIT_FOREVER && tickCount - start >= timeout)
+            break;
+        yield();
+    }
+    bool notified = (tcb[taskCurrent].notify == NOTIFY_PENDING);
+    tcb[taskCurrent].notify = NOTIFY_NONE;
+    return notified;
+}
+
+void RTOS::notify(uint8_t task) {
+    if (task < MAX_TASKS)
+        tcb[task].notify = NOTIFY_PENDING;
+}
+
+//-----------------------------------------------------------------------------
+// Mutex
+//-----------------------------------------------------------------------------
+
+// with one task a mutex is only bookkeeping
+void Mutex::init(mutex* m) {
+    m->owner = NO_TASK;
+    m->queueSize = 0;
+}
+
+void Mutex::lock(mutex* m) {
+    m->owner = taskCurrent;
+}
+
+bool Mutex::tryLock(mutex* m) {
+    if (m->owner != NO_TASK)
+        return false;
+    m->owner = taskCurrent;
+    return true;
+}
+
+void Mutex::unlock(mutex* m) {
+    m->owner = NO_TASK;
+}
@@ -0,0 +1,43 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+#ifndef HOSTKERNEL_H
+#define HOSTKERNEL_H
+
+#include <stdint.h>
+#include "rtos.h"
+
+//-----------------------------------------------------------------------------
+// Host Kernel
+//-----------------------------------------------------------------------------
+
+/// A stand-in for the kernel so drivers and libraries run in host
+/// benchmarks. Interrupt masking is a no-op and every blocking call advances
+/// tickCount by one tick, calling hostIdle so the benchmark can move its
+/// simulated hardware forward (and raise the driver's "interrupts").
+///
+/// main() is task 0. createProcess() adds cooperative tasks on ucontext
+/// stacks: a blocking call passes to the next task, and only a full round
+/// back to main() counts as the tick. Priorities are recorded, not enforced.
+/// Mutexes stay bookkeeping, so tasks must not contend for one.
+
+extern void (*hostIdle)();
+
+#endif // HOSTKERNEL_H
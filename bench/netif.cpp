@@ -0,0 +1,357 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+//-----------------------------------------------------------------------------
+// lwIP sys layer and zero-copy netif on the host kernel
+//-----------------------------------------------------------------------------
+
+// net/sys_arch.cpp and net/ringif.cpp are linked unchanged with lwIP, and
+// their tasks run as host kernel tasks, so every wait really blocks and is
+// woken through the sys_arch wait lists.
+//
+// The first part checks the wait lists: five tasks block on one semaphore,
+// the fifth past SYS_MAX_WAITERS, and each signal must wake the oldest; a
+// writer must block on a full mailbox and a reader on an empty one, and
+// timed waits must give up no sooner than asked. The second part starts the
+// tcpip thread, adds a RingIf and feeds it frames as a driver would: an ICMP
+// echo must come back through the transmit hook, and UDP datagrams held in a
+// netconn must keep their buffers out of the ring, so a fifth frame is
+// dropped, until netbuf_delete() returns them through freeBuffer. Last it
+// times echo round trips on the host.
+// Build and run from the top level:
+//   T=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178
+//   L=$T/third_party/lwip-1.4.1/src
+//   gcc -O2 -c -w -Inet -I$L/include -I$L/include/ipv4 $L/core/*.c $L/core/ipv4/*.c $L/api/*.c
+//   g++ -O2 -std=c++17 -Wno-literal-suffix -Inet -Ikernel -Ihal -Ibench -I$L/include -I$L/include/ipv4 bench/netif.cpp net/sys_arch.cpp net/ringif.cpp kernel/mempool.cpp bench/hostkernel.cpp *.o
+//   ./a.out
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "hostkernel.h"
+#include "introspect.h"
+#include "ringif.h"
+#include "lwip/tcpip.h"
+#include "lwip/api.h"
+#include "lwip/inet_chksum.h"
+#include "lwip/ip.h"
+#include "lwip/udp.h"
+
+#define SEM_TASKS       (SYS_MAX_WAITERS + 1)   // one more than a wait list holds
+#define BOX_SIZE        2       // messages in the test mailbox
+#define BOX_MESSAGES    5       // messages the writer posts
+#define WAIT_TIMEOUT    5       // ms for the timed waits
+#define SETTLE_TICKS    3       // rounds for every task to reach its wait
+#define UDP_PORT        7000
+#define PAYLOAD         32      // bytes of echo and datagram data
+#define ECHO_RUNS       20000   // echo round trips in the timing run
+
+// Define variables
+static sys_sem_t sem;
+static uint8_t woken[SEM_TASKS];
+static uint8_t wokenCount;
+static sys_mbox_t box;
+static uintptr_t readerGot;
+static bool writerDone;
+static volatile bool tcpipUp;
+static ringIf rif;
+static std::vector<std::vector<uint8_t>> sent;
+static uint32_t failures;
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// the kernel's registry is not linked; sys_thread_new() only names its tasks
+bool Introspect::registerObject(const char* name, uint8_t type, void* object) {
+    (void)name;
+    (void)type;
+    (void)object;
+    return true;
+}
+
+static void park() {
+    while (true)
+    {
+        RTOS::waitNotify(WAIT_FOREVER);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Wait List Tasks
+//-----------------------------------------------------------------------------
+
+template <int N>
+static void semWaiter() {
+    sys_arch_sem_wait(&sem, 0);
+    woken[wokenCount++] = N;
+    park();
+}
+
+static const _fn semWaiters[SEM_TASKS] = { semWaiter<0>, semWaiter<1>, semWaiter<2>, semWaiter<3>, semWaiter<4> };
+
+static void boxWriter() {
+    for (uintptr_t i = 1; i <= BOX_MESSAGES; i++)
+    {
+        sys_mbox_post(&box, (void*)i);
+    }
+    writerDone = true;
+    park();
+}
+
+static void boxReader() {
+    void* msg;
+    sys_arch_mbox_fetch(&box, &msg, 0);
+    readerGot = (uintptr_t)msg;
+    park();
+}
+
+static void testSemaphore() {
+    sys_sem_new(&sem, 0);
+    for (uint8_t i = 0; i < SEM_TASKS; i++)
+    {
+        RTOS::createProcess(semWaiters[i], 5);
+    }
+    RTOS::sleep(SETTLE_TICKS);
+    check(wokenCount == 0, "semaphore waiters blocked");
+    check(sem.waiters.count == SYS_MAX_WAITERS, "semaphore wait list full, last task polling");
+
+    for (uint8_t i = 0; i < SEM_TASKS; i++)
+    {
+        sys_sem_signal(&sem);
+        RTOS::sleep(SETTLE_TICKS);
+        check(wokenCount == i + 1u, "one semaphore waiter per signal");
+        check(woken[i] == i, "semaphore waiters woken oldest first");
+    }
+    check(sem.waiters.count == 0 && sem.count == 0, "semaphore drained");
+
+    uint32_t start = tickCount;
+    check(sys_arch_sem_wait(&sem, WAIT_TIMEOUT) == SYS_ARCH_TIMEOUT, "semaphore wait times out");
+    check(tickCount - start >= WAIT_TIMEOUT, "semaphore timeout not early");
+    check(sem.waiters.count == 0, "semaphore timeout leaves the wait list");
+    sys_sem_free(&sem);
+}
+
+static void testMailbox() {
+    void* msg;
+    check(sys_mbox_new(&box, SYS_MBOX_SIZE + 1) == ERR_MEM, "oversized mailbox refused");
+    sys_mbox_new(&box, BOX_SIZE);
+
+    RTOS::createProcess(boxWriter, 5);
+    RTOS::sleep(SETTLE_TICKS);
+    check(box.count == BOX_SIZE && box.writers.count == 1, "writer blocks on a full mailbox");
+    check(sys_mbox_trypost(&box, (void*)99) == ERR_MEM, "trypost refused when full");
+
+    bool ordered = true;
+    for (uintptr_t i = 1; i <= BOX_MESSAGES; i++)
+    {
+        sys_arch_mbox_fetch(&box, &msg, 0);
+        ordered &= ((uintptr_t)msg == i);
+    }
+    check(ordered, "mailbox keeps message order");
+    RTOS::sleep(SETTLE_TICKS);
+    check(writerDone && box.writers.count == 0, "writer woken as space frees");
+
+    check(sys_arch_mbox_tryfetch(&box, &msg) == SYS_MBOX_EMPTY, "tryfetch on an empty mailbox");
+    uint32_t start = tickCount;
+    msg = (void*)1;
+    check(sys_arch_mbox_fetch(&box, &msg, WAIT_TIMEOUT) == SYS_ARCH_TIMEOUT && msg == 0, "fetch times out empty");
+    check(tickCount - start >= WAIT_TIMEOUT, "fetch timeout not early");
+
+    RTOS::createProcess(boxReader, 5);
+    RTOS::sleep(SETTLE_TICKS);
+    check(box.readers.count == 1 && readerGot == 0, "reader blocks on an empty mailbox");
+    sys_mbox_post(&box, (void*)42);
+    RTOS::sleep(SETTLE_TICKS);
+    check(readerGot == 42 && box.readers.count == 0, "reader woken by a post");
+    sys_mbox_free(&box);
+}
+
+//-----------------------------------------------------------------------------
+// RingIf Driver Side
+//-----------------------------------------------------------------------------
+
+// the driver transmit hook, on the tcpip thread: keep a copy of the frame
+static err_t transmit(ringIf* rif, pbuf* p) {
+    (void)rif;
+    std::vector<uint8_t> frame(p->tot_len);
+    pbuf_copy_partial(p, frame.data(), p->tot_len, 0);
+    sent.push_back(frame);
+    return ERR_OK;
+}
+
+static void tcpipReady(void* arg) {
+    (void)arg;
+    tcpipUp = true;
+}
+
+// an IPv4 packet from 10.0.0.1 to the interface, filled in as the link would
+static uint16_t packet(uint8_t* frame, uint8_t proto, const uint8_t* body, uint16_t length) {
+    uint16_t total = IP_HLEN + length;
+    memset(frame, 0, IP_HLEN);
+    frame[0] = 0x45;
+    frame[2] = total >> 8;
+    frame[3] = total & 0xFF;
+    frame[8] = 64;
+    frame[9] = proto;
+    const uint8_t addresses[8] = { 10, 0, 0, 1, 10, 0, 0, 2 };
+    memcpy(frame + 12, addresses, 8);
+    uint16_t sum = inet_chksum(frame, IP_HLEN);
+    memcpy(frame + 10, &sum, 2);
+    memcpy(frame + IP_HLEN, body, length);
+    return total;
+}
+
+// hand lwIP an echo request through a ring buffer; false if the ring is empty
+static bool sendEcho(uint16_t seq) {
+    uint8_t* frame = RingIf::rxBuffer(&rif);
+    if (frame == 0)
+        return false;
+    uint8_t icmp[8 + PAYLOAD] = { 8, 0, 0, 0, 0x12, 0x34, (uint8_t)(seq >> 8), (uint8_t)seq };
+    for (uint16_t i = 0; i < PAYLOAD; i++)
+    {
+        icmp[8 + i] = (uint8_t)(seq + i);
+    }
+    uint16_t sum = inet_chksum(icmp, sizeof(icmp));
+    memcpy(icmp + 2, &sum, 2);
+    RingIf::rxDone(&rif, frame, packet(frame, IP_PROTO_ICMP, icmp, sizeof(icmp)));
+    return true;
+}
+
+static bool echoReply(const std::vector<uint8_t>& frame, uint16_t seq) {
+    if (frame.size() != IP_HLEN + 8 + PAYLOAD || frame[9] != IP_PROTO_ICMP || frame[IP_HLEN] != 0)
+        return false;
+    if (frame[IP_HLEN + 6] != (uint8_t)(seq >> 8) || frame[IP_HLEN + 7] != (uint8_t)seq)
+        return false;
+    for (uint16_t i = 0; i < PAYLOAD; i++)
+    {
+        if (frame[IP_HLEN + 8 + i] != (uint8_t)(seq + i))
+            return false;
+    }
+    return true;
+}
+
+static bool sendDatagram(uint8_t tag) {
+    uint8_t* frame = RingIf::rxBuffer(&rif);
+    if (frame == 0)
+        return false;
+    uint8_t udp[UDP_HLEN + PAYLOAD] = { 0x30, 0x39, UDP_PORT >> 8, UDP_PORT & 0xFF, 0, UDP_HLEN + PAYLOAD, 0, 0 };
+    memset(udp + UDP_HLEN, tag, PAYLOAD);   // checksum 0: none, allowed over IPv4
+    RingIf::rxDone(&rif, frame, packet(frame, IP_PROTO_UDP, udp, sizeof(udp)));
+    return true;
+}
+
+// let the tcpip thread catch up
+static void settle() {
+    RTOS::sleep(SETTLE_TICKS);
+}
+
+static void testNetif() {
+    tcpip_init(tcpipReady, 0);
+    for (uint8_t i = 0; i < 100 && !tcpipUp; i++)
+    {
+        RTOS::sleep(1);
+    }
+    check(tcpipUp, "tcpip thread started");
+
+    ip_addr_t ip, netmask, gateway;
+    IP4_ADDR(&ip, 10, 0, 0, 2);
+    IP4_ADDR(&netmask, 255, 255, 255, 0);
+    IP4_ADDR(&gateway, 10, 0, 0, 1);
+    check(RingIf::init(&rif, transmit, 0, &ip, &netmask, &gateway), "RingIf::init");
+    check(MemPool::available(&rif.pool) == RINGIF_BUFFERS, "ring full before traffic");
+
+    // echo: the request's buffer comes back once lwIP has answered
+    check(sendEcho(1), "echo buffer");
+    settle();
+    check(sent.size() == 1 && echoReply(sent[0], 1), "echo reply transmitted");
+    check(MemPool::available(&rif.pool) == RINGIF_BUFFERS, "echo buffer returned");
+    check(rif.rxFrames == 1 && rif.rxDropped == 0, "echo counted");
+
+    // datagrams queued on a netconn hold their buffers until deleted
+    netconn* conn = netconn_new(NETCONN_UDP);
+    check(conn != 0 && netconn_bind(conn, IP_ADDR_ANY, UDP_PORT) == ERR_OK, "netconn bound");
+    for (uint8_t i = 0; i < RINGIF_BUFFERS; i++)
+    {
+        check(sendDatagram(i), "datagram buffer");
+    }
+    settle();
+    check(MemPool::available(&rif.pool) == 0, "queued datagrams keep their buffers");
+    check(!sendDatagram(RINGIF_BUFFERS), "empty ring refuses a frame");
+    check(rif.rxDropped == 1, "refused frame counted");
+
+    for (uint8_t i = 0; i < RINGIF_BUFFERS; i++)
+    {
+        netbuf* buf;
+        check(netconn_recv(conn, &buf) == ERR_OK, "datagram received");
+        if (buf == 0)
+            continue;
+        uint8_t data[PAYLOAD];
+        bool same = netbuf_len(buf) == PAYLOAD && netbuf_copy(buf, data, PAYLOAD) == PAYLOAD;
+        for (uint16_t j = 0; same && j < PAYLOAD; j++)
+        {
+            same = (data[j] == i);
+        }
+        check(same, "datagram payload");
+        netbuf_delete(buf);
+        check(MemPool::available(&rif.pool) == i + 1u, "netbuf_delete returns the buffer");
+    }
+    netconn_delete(conn);
+    settle();
+    check(rif.rxFrames == 1 + RINGIF_BUFFERS, "datagrams counted");
+
+    // timing: each echo is one rxDone, one tcpip thread pass and one transmit
+    sent.clear();
+    uint32_t echoed = 0;
+    clock_t begin = clock();
+    for (uint16_t seq = 0; seq < ECHO_RUNS; seq++)
+    {
+        sendEcho(seq);
+        while (sent.empty())
+        {
+            RTOS::yield();
+        }
+        echoed += echoReply(sent.back(), seq);
+        sent.clear();
+    }
+    double us = (double)(clock() - begin) / CLOCKS_PER_SEC * 1e6 / ECHO_RUNS;
+    check(echoed == ECHO_RUNS, "every timed echo answered");
+    check(MemPool::available(&rif.pool) == RINGIF_BUFFERS, "ring full after the run");
+    printf("echo round trip   %7.2f us on the host (%u echoes)\n", us, ECHO_RUNS);
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main() {
+    testSemaphore();
+    testMailbox();
+    testNetif();
+    printf("%s\n", failures == 0 ? "all checks passed" : "checks FAILED");
+    return failures != 0;
+}
@@ -0,0 +1,301 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+//-----------------------------------------------------------------------------
+// FatFs storage stack over a RAM disk, on the host
+//-----------------------------------------------------------------------------
+
+// hal/fatdisk.cpp and FatFs run unchanged over a RAM-disk stand-in for
+// SdCard, formatted here as a 32 MB FAT16 volume with 4 KB clusters
+// (_USE_MKFS is off). Each pattern reports host MB/s, which is the cost of
+// FatFs and the sector cache, the card commands and blocks it caused, the
+// cache counters, and the MB/s the SSI bus would allow at the driver's
+// 20 MHz clock when the card itself never holds the bus busy. Every
+// byte read is checked against what was written. Build and run from the
+// top level (-DFATDISK_CACHE_SECTORS=n tries other cache sizes):
+//   F=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178/third_party/fatfs/src
+//   gcc -O2 -c -I$F $F/ff.c
+//   g++ -O2 -std=c++17 -Ihal -Ikernel -Ibench -I$F bench/ramdisk.cpp hal/fatdisk.cpp bench/hostkernel.cpp ff.o
+//   ./a.out
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hostkernel.h"
+#include "sdcard.h"
+#include "fatdisk.h"
+#include "ff.h"
+
+#define DISK_SECTORS    65536               // 32 MB
+#define FILE_BYTES      (8 * 1024 * 1024)
+#define RANDOM_OPS      4000
+#define BUS_RATE        20000000.0          // SSI clock, bits/s (SYSTEM_CLOCK / 2)
+#define COMMAND_BYTES   10                  // command frame, response and gaps
+#define BLOCK_BYTES     (SDCARD_BLOCK_SIZE + 5)   // token, CRC, data response, gap
+
+// Define variables
+static uint8_t disk[DISK_SECTORS][SDCARD_BLOCK_SIZE];
+static uint32_t commands, blocks;
+static uint32_t writeSector, writeLeft;
+
+//-----------------------------------------------------------------------------
+// RAM-disk SdCard
+//-----------------------------------------------------------------------------
+
+bool SdCard::init() {
+    return true;
+}
+
+uint8_t SdCard::type() {
+    return SDCARD_SD2 | SDCARD_BLOCK;
+}
+
+uint32_t SdCard::sectors() {
+    return DISK_SECTORS;
+}
+
+// CMD17, or CMD18 + CMD12
+bool SdCard::readBlocks(uint32_t sector, uint8_t* data, uint32_t count) {
+    if (sector + count > DISK_SECTORS)
+        return false;
+    memcpy(data, disk[sector], count * SDCARD_BLOCK_SIZE);
+    commands += (count == 1) ? 1 : 2;
+    blocks += count;
+    return true;
+}
+
+bool SdCard::writeBlocks(uint32_t sector, const uint8_t* data, uint32_t count) {
+    bool ok = beginWrite(sector, count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ok = ok && writeNext(data + i * SDCARD_BLOCK_SIZE);
+    }
+    return endWrite() && ok;
+}
+
+// CMD24, or CMD55 + ACMD23 + CMD25
+bool SdCard::beginWrite(uint32_t sector, uint32_t count) {
+    if (sector + count > DISK_SECTORS)
+        return false;
+    writeSector = sector;
+    writeLeft = count;
+    commands += (count == 1) ? 1 : 3;
+    return true;
+}
+
+bool SdCard::writeNext(const uint8_t* block) {
+    if (writeLeft == 0)
+        return false;
+    memcpy(disk[writeSector++], block, SDCARD_BLOCK_SIZE);
+    writeLeft--;
+    blocks++;
+    return true;
+}
+
+bool SdCard::endWrite() {
+    return writeLeft == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Volume
+//-----------------------------------------------------------------------------
+
+static void put16(uint8_t* p, uint16_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+    put16(p, v);
+    put16(p + 2, v >> 16);
+}
+
+// FAT16, no partition table: 1 reserved sector, 2 FATs of 32 sectors,
+// 512 root entries, 8-sector clusters
+static void format() {
+    memset(disk, 0, sizeof(disk));
+    uint8_t* bs = disk[0];
+    static const uint8_t jump[3] = { 0xEB, 0x3C, 0x90 };
+    memcpy(bs, jump, 3);
+    memcpy(bs + 3, "RTOSFW  ", 8);
+    put16(bs + 11, SDCARD_BLOCK_SIZE);
+    bs[13] = 8;
+    put16(bs + 14, 1);
+    bs[16] = 2;
+    put16(bs + 17, 512);
+    bs[21] = 0xF8;
+    put16(bs + 22, 32);
+    put32(bs + 32, DISK_SECTORS);
+    bs[36] = 0x80;
+    bs[38] = 0x29;
+    memcpy(bs + 43, "RAMDISK    ", 11);
+    memcpy(bs + 54, "FAT16   ", 8);
+    bs[510] = 0x55;
+    bs[511] = 0xAA;
+    for (uint32_t fat = 0; fat < 2; fat++)
+    {
+        uint8_t* f = disk[1 + fat * 32];
+        put16(f, 0xFFF8);
+        put16(f + 2, 0xFFFF);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Patterns
+//-----------------------------------------------------------------------------
+
+static uint8_t pattern(uint32_t offset) {
+    return (uint8_t)(offset * 2654435761u >> 24);
+}
+
+static uint32_t startCommands, startBlocks;
+static fatDiskStats startStats;
+static clock_t startClock;
+static uint32_t failures;
+
+static void begin() {
+    startCommands = commands;
+    startBlocks = blocks;
+    FatDisk::stats(&startStats);
+    startClock = clock();
+}
+
+static void report(const char* name, uint32_t bytes) {
+    double seconds = (double)(clock() - startClock) / CLOCKS_PER_SEC;
+    uint32_t c = commands - startCommands;
+    uint32_t b = blocks - startBlocks;
+    fatDiskStats s;
+    FatDisk::stats(&s);
+    double busSeconds = (c * COMMAND_BYTES + (double)b * BLOCK_BYTES) * 8 / BUS_RATE;
+    printf("%-22s %8.1f %8u %8u %6u %6u %6u %8.2f\n", name, bytes / seconds / 1e6, c, b,
+           s.hits - startStats.hits, s.misses - startStats.misses, s.writeBacks - startStats.writeBacks,
+           bytes / busSeconds / 1e6);
+}
+
+static void sequentialWrite(const char* name, uint32_t chunk) {
+    static uint8_t buf[16384];
+    FIL f;
+    UINT n;
+    begin();
+    if (f_open(&f, "log.bin", FA_WRITE | FA_CREATE_ALWAYS) != FR_OK)
+    {
+        failures++;
+        return;
+    }
+    for (uint32_t offset = 0; offset < FILE_BYTES; offset += chunk)
+    {
+        for (uint32_t i = 0; i < chunk; i++)
+        {
+            buf[i] = pattern(offset + i);
+        }
+        if (f_write(&f, buf, chunk, &n) != FR_OK || n != chunk)
+            failures++;
+    }
+    f_close(&f);
+    report(name, FILE_BYTES);
+}
+
+static void sequentialRead(const char* name, uint32_t chunk) {
+    static uint8_t buf[16384];
+    FIL f;
+    UINT n;
+    begin();
+    f_open(&f, "log.bin", FA_READ);
+    for (uint32_t offset = 0; offset < FILE_BYTES; offset += chunk)
+    {
+        if (f_read(&f, buf, chunk, &n) != FR_OK || n != chunk)
+            failures++;
+        for (uint32_t i = 0; i < chunk; i++)
+        {
+            failures += buf[i] != pattern(offset + i);
+        }
+    }
+    f_close(&f);
+    report(name, FILE_BYTES);
+}
+
+// 512-byte records at random sector-aligned offsets, fast seek enabled
+static void randomAccess(const char* name, bool write) {
+    static DWORD linkMap[256];
+    uint8_t buf[512];
+    FIL f;
+    UINT n;
+    srand(1);
+    f_open(&f, "log.bin", FA_READ | FA_WRITE);
+    f.cltbl = linkMap;
+    linkMap[0] = sizeof(linkMap) / sizeof(linkMap[0]);
+    if (f_lseek(&f, CREATE_LINKMAP) != FR_OK)
+        failures++;
+    begin();
+    for (uint32_t op = 0; op < RANDOM_OPS; op++)
+    {
+        uint32_t offset = (rand() % (FILE_BYTES / 512)) * 512;
+        f_lseek(&f, offset);
+        if (write)
+        {
+            for (uint32_t i = 0; i < 512; i++)
+            {
+                buf[i] = pattern(offset + i);
+            }
+            if (f_write(&f, buf, 512, &n) != FR_OK || n != 512)
+                failures++;
+        }
+        else
+        {
+            if (f_read(&f, buf, 512, &n) != FR_OK || n != 512)
+                failures++;
+            for (uint32_t i = 0; i < 512; i++)
+            {
+                failures += buf[i] != pattern(offset + i);
+            }
+        }
+    }
+    f_sync(&f);
+    report(name, RANDOM_OPS * 512);
+    f_close(&f);
+}
+
+int main() {
+    static FATFS fs;
+    format();
+    if (f_mount(0, &fs) != FR_OK)
+    {
+        printf("mount failed\n");
+        return 1;
+    }
+
+    printf("%u MB file, %u random 512-byte ops, %u cache sectors\n\n",
+           FILE_BYTES >> 20, RANDOM_OPS, FATDISK_CACHE_SECTORS);
+    printf("%-22s %8s %8s %8s %6s %6s %6s %8s\n", "pattern", "host", "commands", "blocks",
+           "hits", "misses", "flush", "bus");
+    printf("%-22s %8s %8s %8s %6s %6s %6s %8s\n", "", "MB/s", "", "", "", "", "", "MB/s");
+    sequentialWrite("seq write 512 B", 512);
+    sequentialWrite("seq write 16 KB", 16384);
+    sequentialRead("seq read 512 B", 512);
+    sequentialRead("seq read 16 KB", 16384);
+    randomAccess("random read 512 B", false);
+    randomAccess("random write 512 B", true);
+    sequentialRead("verify 16 KB", 16384);
+
+    printf("\n%s\n", failures == 0 ? "data verified" : "DATA MISMATCH");
+    return failures != 0;
+}
@@ -0,0 +1,351 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+//-----------------------------------------------------------------------------
+// Serial network interface over a loopback UART, on the host
+//-----------------------------------------------------------------------------
+
+// net/serialif.cpp is compiled unchanged against a UART whose transmit side
+// feeds its receive side, with the lwIP semaphores and RingIf reduced to
+// bookkeeping. Its transmit and receive threads run in turn on the one host
+// task: a semaphore wait or UART read with nothing to do unwinds back here,
+// at the top of the thread's loop, so no decoder state is lost mid-frame.
+//
+// The first part checks the SLIP wire bytes against an RFC 1055 encoder and
+// round-trips frames in both framings: every byte value, runs of end and
+// escape bytes, chained pbufs and full-MTU frames. An MTU + 1 frame and an
+// HDLC frame with a flipped bit must be dropped and counted. The second part
+// pushes random full-size frames through and prints the host throughput and
+// the link efficiency, i.e. the payload rate a 115200 baud UART would carry.
+// Build and run from the top level:
+//   T=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178
+//   L=$T/third_party/lwip-1.4.1/src/include
+//   g++ -O2 -std=c++17 -Wno-literal-suffix -Inet -Ihal -Ikernel -Ibench -I$L -I$L/ipv4 bench/slip.cpp bench/hostkernel.cpp kernel/crc.cpp
+//   ./a.out
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "hostkernel.h"
+#include "uart.h"
+#include "crc.h"
+#include "lwip/sys.h"
+
+#define LINE_SIZE       (1 << 16)   // loopback bytes per batch
+#define BAUD_BYTES      11520       // 115200 baud, 10 bits per byte
+#define RUN_FRAMES      20000       // full-size frames in the throughput run
+
+// thrown by a stub that would block, to leave the thread that called it
+struct lineIdle
+{
+};
+
+// Define variables
+static uint8_t line[LINE_SIZE];
+static uint32_t lineHead;           // bytes written by Uart::write
+static uint32_t lineTail;           // bytes taken by Uart::read
+static std::vector<std::vector<uint8_t>> received;
+static bool keepFrames = true;
+static uint32_t failures;
+
+static void runTx();
+
+#include "serialif.cpp"
+
+//-----------------------------------------------------------------------------
+// Loopback UART, lwIP sys and RingIf stand-ins
+//-----------------------------------------------------------------------------
+
+uint32_t Uart::write(const void* data, uint32_t length, uint32_t timeout) {
+    (void)timeout;
+    if (lineHead + length > LINE_SIZE)
+    {
+        printf("loopback line overflow\n");
+        exit(1);
+    }
+    memcpy(&line[lineHead], data, length);
+    lineHead += length;
+    return length;
+}
+
+uint32_t Uart::read(void* data, uint32_t length, uint32_t timeout) {
+    (void)timeout;
+    if (lineTail == lineHead)
+        throw lineIdle();
+    uint32_t n = lineHead - lineTail;
+    if (n > length)
+        n = length;
+    memcpy(data, &line[lineTail], n);
+    lineTail += n;
+    return n;
+}
+
+err_t sys_sem_new(sys_sem_t* sem, u8_t count) {
+    sem->count = count;
+    sem->valid = 1;
+    return ERR_OK;
+}
+
+void sys_sem_signal(sys_sem_t* sem) {
+    sem->count++;
+}
+
+u32_t sys_arch_sem_wait(sys_sem_t* sem, u32_t timeout) {
+    (void)timeout;
+    // put() waits here with both burst buffers full: let the UART drain them
+    if (sem->count == 0 && sem == &txFree)
+        runTx();
+    if (sem->count == 0)
+        throw lineIdle();
+    sem->count--;
+    return 0;
+}
+
+sys_thread_t sys_thread_new(const char* name, lwip_thread_fn thread, void* arg, int stacksize, int prio) {
+    // the harness calls the thread functions itself
+    (void)name; (void)thread; (void)arg; (void)stacksize; (void)prio;
+    return 1;
+}
+
+bool RingIf::init(ringIf* rif, ringIfTransmit transmit, void* driver,
+                  ip_addr_t* ip, ip_addr_t* netmask, ip_addr_t* gateway) {
+    (void)rif; (void)transmit; (void)driver; (void)ip; (void)netmask; (void)gateway;
+    return true;
+}
+
+uint8_t* RingIf::rxBuffer(ringIf* rif) {
+    // frames are copied out in rxDone, so one buffer is enough
+    return (uint8_t*)rif->buffers[0].data;
+}
+
+void RingIf::rxDone(ringIf* rif, uint8_t* frame, uint16_t length) {
+    rif->rxFrames++;
+    if (keepFrames)
+        received.push_back(std::vector<uint8_t>(frame, frame + length));
+}
+
+static void runTx() {
+    try
+    {
+        txThread(0);
+    }
+    catch (lineIdle&)
+    {
+    }
+}
+
+static void runRx() {
+    try
+    {
+        rxThread(0);
+    }
+    catch (lineIdle&)
+    {
+    }
+    lineHead = 0;
+    lineTail = 0;
+}
+
+// hands a frame to the interface as a two-pbuf chain, as lwIP does with headers
+static void send(const std::vector<uint8_t>& frame) {
+    pbuf head, tail;
+    uint16_t split = frame.size() / 3;
+    head.next = &tail;
+    head.payload = (void*)frame.data();
+    head.len = split;
+    head.tot_len = frame.size();
+    tail.next = 0;
+    tail.payload = (void*)(frame.data() + split);
+    tail.len = frame.size() - split;
+    tail.tot_len = tail.len;
+    transmit(&rif, &head);
+}
+
+//-----------------------------------------------------------------------------
+// Functional checks
+//-----------------------------------------------------------------------------
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static std::vector<uint8_t> randomFrame(uint16_t length) {
+    std::vector<uint8_t> f(length);
+    for (uint16_t i = 0; i < length; i++)
+    {
+        f[i] = rand();
+    }
+    return f;
+}
+
+// RFC 1055 with the leading END that flushes line noise
+static std::vector<uint8_t> slipReference(const std::vector<uint8_t>& frame) {
+    std::vector<uint8_t> out(1, 0xC0);
+    for (uint8_t b : frame)
+    {
+        if (b == 0xC0)
+        {
+            out.push_back(0xDB);
+            out.push_back(0xDC);
+        }
+        else if (b == 0xDB)
+        {
+            out.push_back(0xDB);
+            out.push_back(0xDD);
+        }
+        else
+        {
+            out.push_back(b);
+        }
+    }
+    out.push_back(0xC0);
+    return out;
+}
+
+static void roundTrip(uint8_t mode, const char* name) {
+    SerialIf::init(mode, 0, 0, 0);
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> all(256);
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        all[i] = i;
+    }
+    frames.push_back(all);
+    frames.push_back(std::vector<uint8_t>(300, bytes->end));
+    frames.push_back(std::vector<uint8_t>(300, bytes->esc));
+    frames.push_back(std::vector<uint8_t>(1, bytes->esc));
+    frames.push_back(randomFrame(RINGIF_MTU));
+    for (uint16_t i = 0; i < 40; i++)
+    {
+        frames.push_back(randomFrame(1 + rand() % RINGIF_MTU));
+    }
+
+    received.clear();
+    for (const std::vector<uint8_t>& f : frames)
+    {
+        send(f);
+    }
+    runTx();
+    runRx();
+    char what[80];
+    snprintf(what, sizeof(what), "%s: %zu frames back of %zu", name, received.size(), frames.size());
+    check(received == frames, what);
+    check(SerialIf::rxErrors() == 0, "no receive errors on a clean line");
+
+    // a frame too long for the buffer is dropped and counted
+    received.clear();
+    send(randomFrame(RINGIF_MTU + 1));
+    send(all);
+    runTx();
+    runRx();
+    check(received.size() == 1 && received[0] == all, "oversized frame dropped, next one kept");
+    check(SerialIf::rxErrors() == 1, "oversized frame counted");
+}
+
+static void functional() {
+    // SLIP wire bytes match the reference encoder, escapes included
+    SerialIf::init(SERIALIF_SLIP, 0, 0, 0);
+    std::vector<uint8_t> frame = randomFrame(200);
+    frame[0] = 0xC0;
+    frame[1] = 0xDB;
+    frame[199] = 0xC0;
+    send(frame);
+    runTx();
+    std::vector<uint8_t> wire(line, line + lineHead);
+    check(wire == slipReference(frame), "SLIP encoding matches RFC 1055");
+    runRx();
+
+    roundTrip(SERIALIF_SLIP, "SLIP");
+    roundTrip(SERIALIF_HDLC, "HDLC");
+
+    // a flipped bit fails the FCS; the frame after it still arrives
+    SerialIf::init(SERIALIF_HDLC, 0, 0, 0);
+    received.clear();
+    std::vector<uint8_t> a = randomFrame(100), b = randomFrame(100);
+    send(a);
+    send(b);
+    runTx();
+    uint32_t i = 10;    // inside the first frame, on a byte that stays data
+    while (line[i] == 0x7E || line[i] == 0x7D || (line[i] ^ 1) == 0x7E || (line[i] ^ 1) == 0x7D)
+    {
+        i++;
+    }
+    line[i] ^= 0x01;
+    runRx();
+    check(received.size() == 1 && received[0] == b, "corrupted HDLC frame dropped");
+    check(SerialIf::rxErrors() == 1, "corrupted HDLC frame counted");
+}
+
+//-----------------------------------------------------------------------------
+// Throughput
+//-----------------------------------------------------------------------------
+
+static void throughput(uint8_t mode, const char* name) {
+    SerialIf::init(mode, 0, 0, 0);
+    std::vector<std::vector<uint8_t>> frames;
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        frames.push_back(randomFrame(RINGIF_MTU));
+    }
+
+    keepFrames = false;
+    uint32_t before = rif.rxFrames;
+    uint64_t wireBytes = 0;
+    clock_t start = clock();
+    for (uint32_t n = 0; n < RUN_FRAMES; n += 16)
+    {
+        for (const std::vector<uint8_t>& f : frames)
+        {
+            send(f);
+        }
+        runTx();
+        wireBytes += lineHead;
+        runRx();
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    keepFrames = true;
+
+    uint64_t payload = (uint64_t)RUN_FRAMES * RINGIF_MTU;
+    check(rif.rxFrames - before == RUN_FRAMES, "every frame of the run received");
+    double efficiency = (double)payload / wireBytes;
+    printf("%-5s %8.1f MB/s encode+decode on the host, %5.2f%% wire efficiency, %5.0f B/s at 115200 baud\n",
+           name, payload / seconds / 1e6, efficiency * 100, efficiency * BAUD_BYTES);
+}
+
+int main() {
+    Crc::init();
+    srand(1);
+    functional();
+
+    printf("%u random %u-byte frames per run\n", RUN_FRAMES, RINGIF_MTU);
+    throughput(SERIALIF_SLIP, "SLIP");
+    throughput(SERIALIF_HDLC, "HDLC");
+    printf("%s\n", failures == 0 ? "all checks passed" : "checks FAILED");
+    return failures != 0;
+}
@@ -0,0 +1,396 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+//-----------------------------------------------------------------------------
+// Span kernels against grlib's offscreen displays, on the host
+//-----------------------------------------------------------------------------
+
+// Two offscreen displays of each format share a random starting image; one
+// keeps grlib's offscr8bpp.c/offscr4bpp.c callbacks and the other has
+// Span::install() applied. Random LineDrawH, RectFill and PixelDrawMultiple
+// calls, the latter from 1, 4 and 8 bpp images at every source phase, go to
+// both and the buffers must stay identical byte for byte; keyed and opaque
+// blits are checked against a scalar reference. Each buffer sits at an odd
+// address with the bytes after it poisoned, so building with
+// -fsanitize=address also catches any access past the last pixel. Then every
+// primitive is timed on both displays, best of five runs each, alternating
+// between them, in pixels per second. Build and run from the top level:
+//   T=platform/tm4c123gxl_bsp/tivaware_c_series_2_1_4_178
+//   gcc -O2 -c -w -Dgcc -I$T $T/grlib/offscr8bpp.c $T/grlib/offscr4bpp.c
+//   g++ -O2 -std=c++17 -Dgcc -Igfx -I$T bench/span.cpp gfx/span.cpp offscr8bpp.o offscr4bpp.o
+//   ./a.out
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "span.h"
+#ifdef __SANITIZE_ADDRESS__
+#include <sanitizer/asan_interface.h>
+#endif
+
+#define WIDTH           161     // odd, so 4 bpp rows end on a half byte
+#define HEIGHT          97
+#define RUNS            5       // timings per primitive, the best is kept
+#define RANDOM_CALLS    200000
+#define RANDOM_BLITS    100000
+
+// Define variables
+static uint8_t* storeA;
+static uint8_t* storeB;
+static uint32_t palette[256];
+static uint32_t failures;
+
+static void check(bool ok, const char* what) {
+    if (!ok)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double now() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static uint32_t imageSize(bool eight) {
+    return eight ? 6 + 256 * 3 + WIDTH * HEIGHT : 6 + 16 * 3 + (WIDTH + 1) / 2 * HEIGHT;
+}
+
+// a buffer at an odd address that ends mid-word, so a word access that
+// strays past the last pixel still reaches the poisoned bytes after it
+static uint8_t* buffer(uint8_t** store, bool eight) {
+    free(*store);
+    uint32_t size = imageSize(eight);
+    *store = (uint8_t*)malloc(size + 8);
+    uint8_t* image = *store + 1;
+    if (((uintptr_t)(image + size) & 3) == 0)
+        image += 2;
+#ifdef __SANITIZE_ADDRESS__
+    ASAN_POISON_MEMORY_REGION(image + size, *store + size + 8 - (image + size));
+#endif
+    return image;
+}
+
+// one grlib display and one with the span kernels installed, same palette
+static void openDisplays(bool eight, tDisplay* grlib, tDisplay* span, uint8_t** a, uint8_t** b) {
+    *a = buffer(&storeA, eight);
+    *b = buffer(&storeB, eight);
+    if (eight)
+    {
+        GrOffScreen8BPPInit(grlib, *a, WIDTH, HEIGHT);
+        GrOffScreen8BPPInit(span, *b, WIDTH, HEIGHT);
+        GrOffScreen8BPPPaletteSet(grlib, palette, 0, 256);
+        GrOffScreen8BPPPaletteSet(span, palette, 0, 256);
+    }
+    else
+    {
+        GrOffScreen4BPPInit(grlib, *a, WIDTH, HEIGHT);
+        GrOffScreen4BPPInit(span, *b, WIDTH, HEIGHT);
+        GrOffScreen4BPPPaletteSet(grlib, palette, 0, 16);
+        GrOffScreen4BPPPaletteSet(span, palette, 0, 16);
+    }
+    Span::install(span);
+}
+
+//-----------------------------------------------------------------------------
+// Pixel-for-pixel checks
+//-----------------------------------------------------------------------------
+
+static void randomCalls(bool eight) {
+    tDisplay grlib, span;
+    uint8_t *a, *b;
+    openDisplays(eight, &grlib, &span, &a, &b);
+    uint32_t size = imageSize(eight);
+    uint32_t header = eight ? 6 + 256 * 3 : 6 + 16 * 3;
+    for (uint32_t i = header; i < size; i++)
+    {
+        a[i] = b[i] = rand();
+    }
+    uint32_t maxIndex = eight ? 255 : 15;
+    uint8_t pixels[512];
+    uint8_t imagePalette[256 * 3];
+    uint32_t colors[2];
+
+    for (uint32_t n = 0; n < RANDOM_CALLS; n++)
+    {
+        int32_t x1 = rand() % WIDTH, x2 = rand() % WIDTH;
+        int32_t y1 = rand() % HEIGHT, y2 = rand() % HEIGHT;
+        if (x1 > x2)
+        {
+            int32_t t = x1; x1 = x2; x2 = t;
+        }
+        if (y1 > y2)
+        {
+            int32_t t = y1; y1 = y2; y2 = t;
+        }
+        uint32_t value = rand() & maxIndex;
+        switch (rand() % 4)
+        {
+        case 0:
+            grlib.pfnLineDrawH(a, x1, x2, y1, value);
+            span.pfnLineDrawH(b, x1, x2, y1, value);
+            break;
+        case 1:
+        {
+            tRectangle r = { (int16_t)x1, (int16_t)y1, (int16_t)x2, (int16_t)y2 };
+            grlib.pfnRectFill(a, &r, value);
+            span.pfnRectFill(b, &r, value);
+            break;
+        }
+        default:
+        {
+            static const int32_t depths[3] = { 1, 4, 8 };
+            int32_t bpp = depths[rand() % 3];
+            for (uint8_t& p : pixels)
+            {
+                p = rand();
+            }
+            const uint8_t* pal = imagePalette;
+            int32_t flag = 0;
+            if (bpp == 1)
+            {
+                colors[0] = rand() & maxIndex;
+                colors[1] = rand() & maxIndex;
+                pal = (const uint8_t*)colors;
+            }
+            else if (rand() % 4 == 0)
+            {
+                for (uint8_t& c : imagePalette)
+                {
+                    c = rand();
+                }
+                flag = GRLIB_DRIVER_FLAG_NEW_IMAGE;
+            }
+            int32_t x0 = (bpp == 1) ? rand() % 8 : (bpp == 4) ? rand() % 2 : 0;
+            grlib.pfnPixelDrawMultiple(a, x1, y1, x0, x2 - x1 + 1, bpp | flag, pixels, pal);
+            span.pfnPixelDrawMultiple(b, x1, y1, x0, x2 - x1 + 1, bpp | flag, pixels, pal);
+            break;
+        }
+        }
+        if (memcmp(a, b, size) != 0)
+        {
+            check(false, eight ? "8bpp buffers identical to grlib" : "4bpp buffers identical to grlib");
+            return;
+        }
+    }
+}
+
+static void randomBlits(bool eight) {
+    tDisplay grlib, span;
+    uint8_t *a, *b;
+    openDisplays(eight, &grlib, &span, &a, &b);
+    uint32_t size = imageSize(eight);
+    uint32_t header = eight ? 6 + 256 * 3 : 6 + 16 * 3;
+    for (uint32_t i = header; i < size; i++)
+    {
+        b[i] = rand();
+    }
+    uint32_t maxIndex = eight ? 255 : 15;
+
+    for (uint32_t n = 0; n < RANDOM_BLITS; n++)
+    {
+        int32_t x = rand() % WIDTH, sx = rand() % WIDTH;
+        int32_t count = rand() % (WIDTH - (x > sx ? x : sx) + 1);
+        int32_t y = rand() % HEIGHT, sy = rand() % HEIGHT;
+        int32_t key = (rand() % 3 != 0) ? (int32_t)(rand() & maxIndex) : SPAN_OPAQUE;
+        if (y == sy || count == 0)
+            continue;
+        memcpy(a, b, size);
+        tRectangle r = { (int16_t)sx, (int16_t)sy, (int16_t)(sx + count - 1), (int16_t)sy };
+        Span::blit(&span, x, y, &span, &r, key);
+
+        // scalar reference on the copy, through the grlib display's buffer
+        uint8_t* to = Span::row(&grlib, y);
+        const uint8_t* from = Span::row(&grlib, sy);
+        for (int32_t i = 0; i < count; i++)
+        {
+            if (eight)
+            {
+                uint8_t s = from[sx + i];
+                if (key == SPAN_OPAQUE || s != key)
+                    to[x + i] = s;
+            }
+            else
+            {
+                int32_t q = sx + i, d = x + i;
+                uint8_t s = (from[q >> 1] >> ((~q & 1) * 4)) & 15;
+                if (key == SPAN_OPAQUE || s != key)
+                {
+                    int32_t shift = (~d & 1) * 4;
+                    to[d >> 1] = (to[d >> 1] & ~(15 << shift)) | (s << shift);
+                }
+            }
+        }
+        if (memcmp(a, b, size) != 0)
+        {
+            check(false, eight ? "8bpp blits match the scalar reference" : "4bpp blits match the scalar reference");
+            return;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Throughput
+//-----------------------------------------------------------------------------
+
+// time draw(), which returns the pixels it drew, and keep the best rate
+template <typename F>
+static void rate(double& best, F draw) {
+    double start = now();
+    double px = draw();
+    double r = px / (now() - start);
+    if (r > best)
+        best = r;
+}
+
+// keyed 140-pixel blits, by a scalar loop (grlib has none) or the span kernels
+static double keyedBlits(const tDisplay* display, bool eight, bool scalar) {
+    uint8_t* to = Span::row(display, 50);
+    const uint8_t* from = Span::row(display, 1);
+    for (uint32_t n = 0; n < 200000; n++)
+    {
+        int32_t x = n % 5, sx = n % 3;
+        if (!scalar)
+        {
+            if (eight)
+                Span::blitKey8(to + x, from + sx, 140, 7);
+            else
+                Span::blitKey4(to, x, from, sx, 140, 7);
+        }
+        else
+        {
+            for (int32_t i = 0; i < 140; i++)
+            {
+                int32_t q = sx + i, e = x + i;
+                if (eight)
+                {
+                    if (from[q] != 7)
+                        to[e] = from[q];
+                    continue;
+                }
+                uint8_t s = (from[q >> 1] >> ((~q & 1) * 4)) & 15;
+                if (s != 7)
+                {
+                    int32_t shift = (~e & 1) * 4;
+                    to[e >> 1] = (to[e >> 1] & ~(15 << shift)) | (s << shift);
+                }
+            }
+        }
+        __asm volatile ("" : : : "memory");
+    }
+    return 200000.0 * 140;
+}
+
+static void throughput(bool eight) {
+    tDisplay grlib, span;
+    uint8_t *a, *b;
+    openDisplays(eight, &grlib, &span, &a, &b);
+    tDisplay* displays[2] = { &grlib, &span };
+    double rates[2][5] = {};
+    static uint8_t pixels[WIDTH];
+    for (uint8_t& p : pixels)
+    {
+        p = rand();
+    }
+    static uint8_t imagePalette[256 * 3];
+    for (uint8_t& c : imagePalette)
+    {
+        c = rand();
+    }
+    static const uint32_t colors[2] = { 1, 14 };
+
+    // alternate the displays run by run so clock changes hit both alike
+    for (uint8_t run = 0; run < 2 * RUNS; run++)
+    {
+        uint8_t k = run & 1;
+        tDisplay* d = displays[k];
+        void* data = d->pvDisplayData;
+        rate(rates[k][0], [&]() {
+            tRectangle r = { 3, 2, WIDTH - 4, HEIGHT - 3 };
+            for (uint32_t n = 0; n < 4000; n++)
+            {
+                d->pfnRectFill(data, &r, n & 15);
+            }
+            return 4000.0 * (WIDTH - 6) * (HEIGHT - 4);
+        });
+        rate(rates[k][1], [&]() {
+            double px = 0;
+            for (uint32_t n = 0; n < 600000; n++)
+            {
+                int32_t x1 = n % 13, x2 = x1 + 5 + n % 23;     // 6-28 pixels
+                d->pfnLineDrawH(data, x1, x2, n % HEIGHT, n & 15);
+                px += x2 - x1 + 1;
+            }
+            return px;
+        });
+        rate(rates[k][2], [&]() {
+            for (uint32_t n = 0; n < 60000; n++)
+            {
+                d->pfnPixelDrawMultiple(data, 1 + n % 3, n % HEIGHT, n % 8, 150, 1, pixels, (const uint8_t*)colors);
+            }
+            return 60000.0 * 150;
+        });
+        // grlib searches the palette for every pixel, so give it fewer rows
+        uint32_t rows = (eight && k == 0) ? 40 : 20000;
+        rate(rates[k][3], [&]() {
+            for (uint32_t n = 0; n < rows; n++)
+            {
+                int32_t flag = (n % HEIGHT == 0) ? GRLIB_DRIVER_FLAG_NEW_IMAGE : 0;
+                d->pfnPixelDrawMultiple(data, 1 + n % 3, n % HEIGHT, 0, 150, 8 | flag, pixels, imagePalette);
+            }
+            return rows * 150.0;
+        });
+        rate(rates[k][4], [&]() {
+            return keyedBlits(&span, eight, k == 0);
+        });
+    }
+
+    static const char* names[5] = { "RectFill", "LineDrawH 6-28 px", "1bpp text", "8bpp image", "keyed blit (scalar)" };
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        printf("%s %-20s %9.1f -> %9.1f Mpx/s  %5.2fx\n", eight ? "8bpp" : "4bpp", names[i],
+               rates[0][i] / 1e6, rates[1][i] / 1e6, rates[1][i] / rates[0][i]);
+    }
+}
+
+int main() {
+    srand(1);
+    for (uint32_t& c : palette)
+    {
+        c = rand() & 0xFFFFFF;
+    }
+    randomCalls(true);
+    randomCalls(false);
+    randomBlits(true);
+    randomBlits(false);
+    printf("%s\n", failures == 0 ? "pixel-identical to grlib" : "checks FAILED");
+
+    printf("grlib -> span\n");
+    throughput(true);
+    throughput(false);
+    free(storeA);
+    free(storeB);
+    return failures != 0;
+}
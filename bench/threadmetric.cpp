@@ -0,0 +1,372 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+//-----------------------------------------------------------------------------
+// Thread-Metric style kernel benchmarks
+//-----------------------------------------------------------------------------
+
+// Runs each benchmark for BENCH_INTERVAL ticks and prints the number of
+// operations completed and the SysTick cycles elapsed. Test names follow the
+// Thread-Metric suite; there is no port of it to the bundled FreeRTOS yet, so
+// the numbers are this kernel's own costs, not a comparison.
+// Built as rtos-bench for a QEMU Cortex-M machine:
+//   mps2-an386    Cortex-M4, CMSDK UART0 (default)
+//   lm3s6965evb   Cortex-M3, PL011 UART0 at the TM4C address (BENCH_UART_PL011)
+// When the suite is done it exits QEMU through semihosting.
+
+#include <stdint.h>
+#include "rtos.h"
+#include "port.h"
+#include "streambuf.h"
+#include "mempool.h"
+#include "tm4c123gh6pm.h"
+
+#ifndef BENCH_INTERVAL
+#define BENCH_INTERVAL   5000    // ticks per test, < 100 s so cycles fit 32 bits
+#endif
+
+#define BENCH_RELOAD     (SYSTEM_CLOCK / 1000)   // SysTick cycles per tick
+#define BENCH_IRQ        27                      // Comp2, software triggered
+#define BENCH_TASKS      5
+
+// CMSDK APB UART0 on mps2-an386
+#define CMSDK_UART0_DATA_R   (*((volatile uint32_t *)0x40004000))
+#define CMSDK_UART0_STATE_R  (*((volatile uint32_t *)0x40004004))
+#define CMSDK_UART0_CTRL_R   (*((volatile uint32_t *)0x40004008))
+#define CMSDK_UART0_BDIV_R   (*((volatile uint32_t *)0x40004010))
+#define CMSDK_UART_TXFULL    0x00000001
+#define CMSDK_UART_TXEN      0x00000001
+
+// Define variables
+static volatile uint32_t counter[BENCH_TASKS];
+static volatile uint32_t isrCount;
+static volatile uint8_t isrTarget = NO_TASK;
+static semaphore ping, pong;
+static streamBuffer queue;
+static uint8_t queueBuf[256] __attribute__((aligned(4)));
+static memPool pool;
+static uint32_t poolBuf[8 * 128 / 4];
+
+//-----------------------------------------------------------------------------
+// Port Layer
+//-----------------------------------------------------------------------------
+
+// RTOS::bspInit() calls this in place of the board's hwInit()
+void hwInit() {
+#ifdef BENCH_UART_PL011
+    UART0_CTL_R = UART_CTL_UARTEN | UART_CTL_TXE;
+#else
+    CMSDK_UART0_BDIV_R = SYSTEM_CLOCK / 115200;
+    CMSDK_UART0_CTRL_R = CMSDK_UART_TXEN;
+#endif
+    NVIC_EN0_R = 1 << BENCH_IRQ;
+}
+
+extern "C" void SysTick_Handler() {
+    RTOS::tickIsr();
+}
+
+extern "C" void Comp2_Handler() {
+    isrCount++;
+    RTOS::notify(isrTarget);
+}
+
+static void putChar(char c) {
+#ifdef BENCH_UART_PL011
+    while (UART0_FR_R & UART_FR_TXFF);
+    UART0_DR_R = c;
+#else
+    while (CMSDK_UART0_STATE_R & CMSDK_UART_TXFULL);
+    CMSDK_UART0_DATA_R = c;
+#endif
+}
+
+static void putString(const char* s) {
+    while (*s != 0)
+    {
+        putChar(*s++);
+    }
+}
+
+static void putNumber(uint32_t value) {
+    char digits[10];
+    uint8_t n = 0;
+    do
+    {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value != 0);
+    while (n > 0)
+    {
+        putChar(digits[--n]);
+    }
+}
+
+// SysTick cycles since rtosInit: ticks times reload plus the down-counter
+static uint32_t cycles() {
+    uint32_t ticks, current;
+    do
+    {
+        ticks = tickCount;
+        current = NVIC_ST_CURRENT_R;
+    } while (ticks != tickCount);
+    return ticks * BENCH_RELOAD + (BENCH_RELOAD - 1 - current);
+}
+
+static uint8_t taskIndex(_fn fn) {
+    for (uint8_t i = 0; i < MAX_TASKS; i++)
+    {
+        if (tcb[i].state != STATE_INVALID && tcb[i].pid == (void*)fn)
+            return i;
+    }
+    return NO_TASK;
+}
+
+static void semihostExit() {
+    // SYS_EXIT with ADP_Stopped_ApplicationExit
+    __asm volatile ("MOV R0, #0x18 \n"
+                    "LDR R1, =0x20026 \n"
+                    "BKPT 0xAB" : : : "r0", "r1", "memory");
+}
+
+//-----------------------------------------------------------------------------
+// Benchmark Tasks
+//-----------------------------------------------------------------------------
+
+// one task must be ready at all times
+static void idle() {
+    while (true)
+    {
+        RTOS::yield();
+    }
+}
+
+// cooperative context switch: equal priority tasks yielding round robin
+template <int N>
+static void cooperative() {
+    while (true)
+    {
+        counter[N]++;
+        RTOS::yield();
+    }
+}
+
+// preemptive context switch: each task wakes the next higher priority one,
+// which runs at once and blocks again
+template <int N>
+static void preemptive();
+
+template <>
+void preemptive<0>() {
+    while (true)
+    {
+        RTOS::waitNotify(WAIT_FOREVER);
+        counter[0]++;
+    }
+}
+
+template <int N>
+static void preemptive() {
+    while (true)
+    {
+        RTOS::waitNotify(WAIT_FOREVER);
+        counter[N]++;
+        RTOS::notify(taskIndex(preemptive<N - 1>));
+    }
+}
+
+static void preemptiveDriver() {
+    uint8_t next = taskIndex(preemptive<3>);
+    while (true)
+    {
+        counter[4]++;
+        RTOS::notify(next);
+        RTOS::yield();
+    }
+}
+
+// interrupt processing: the ISR wakes the task that triggered it
+static void interruptProcessing() {
+    isrTarget = taskIndex(interruptProcessing);
+    while (true)
+    {
+        NVIC_SW_TRIG_R = BENCH_IRQ;
+        RTOS::waitNotify(WAIT_FOREVER);
+        counter[0]++;
+    }
+}
+
+// interrupt preemption: the ISR wakes a higher priority task
+static void interruptHigh() {
+    while (true)
+    {
+        RTOS::waitNotify(WAIT_FOREVER);
+        counter[0]++;
+    }
+}
+
+static void interruptLow() {
+    isrTarget = taskIndex(interruptHigh);
+    while (true)
+    {
+        NVIC_SW_TRIG_R = BENCH_IRQ;
+        counter[1]++;
+        RTOS::yield();
+    }
+}
+
+// message processing: send a 16 byte message and receive it back
+static void messageProcessing() {
+    uint32_t message[4] = { 0 };
+    while (true)
+    {
+        message[0] = counter[0];
+        StreamBuffer::send(&queue, message, sizeof(message));
+        StreamBuffer::receive(&queue, message, sizeof(message), NO_WAIT);
+        if (message[0] == counter[0])
+            counter[0]++;
+    }
+}
+
+// synchronization processing: two tasks alternate on a pair of semaphores
+static void semaphorePing() {
+    while (true)
+    {
+        RTOS::waitSemaphore(&ping);
+        counter[0]++;
+        RTOS::postSemaphore(&pong);
+    }
+}
+
+static void semaphorePong() {
+    while (true)
+    {
+        RTOS::waitSemaphore(&pong);
+        counter[1]++;
+        RTOS::postSemaphore(&ping);
+    }
+}
+
+// memory allocation: allocate and release a 128 byte block
+static void memoryAllocation() {
+    while (true)
+    {
+        void* block = MemPool::alloc(&pool);
+        MemPool::free(&pool, block);
+        if (block != 0)
+            counter[0]++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmark Runner
+//-----------------------------------------------------------------------------
+
+struct benchTest
+{
+  const char* name;
+  _fn tasks[BENCH_TASKS];
+  uint8_t priorities[BENCH_TASKS];
+};
+
+static const benchTest tests[] =
+{
+    { "cooperative context switch",
+      { cooperative<0>, cooperative<1>, cooperative<2>, cooperative<3>, cooperative<4> },
+      { 3, 3, 3, 3, 3 } },
+    { "preemptive context switch",
+      { preemptive<0>, preemptive<1>, preemptive<2>, preemptive<3>, preemptiveDriver },
+      { 1, 2, 3, 4, 5 } },
+    { "interrupt processing", { interruptProcessing }, { 3 } },
+    { "interrupt preemption", { interruptHigh, interruptLow }, { 1, 5 } },
+    { "message processing", { messageProcessing }, { 3 } },
+    { "semaphore ping-pong", { semaphorePing, semaphorePong }, { 3, 3 } },
+    { "memory allocation", { memoryAllocation }, { 3 } },
+};
+
+static void report(const char* name, uint32_t ops, uint32_t elapsed) {
+    putString(name);
+    putString(": ");
+    putNumber(ops);
+    putString(" ops in ");
+    putNumber(elapsed);
+    putString(" cycles, ");
+    putNumber(ops != 0 ? elapsed / ops : 0);
+    putString(" cycles/op\r\n");
+}
+
+// highest priority: starts each test, sleeps for the interval, then tears it down
+static void runner() {
+    for (const benchTest& test : tests)
+    {
+        for (uint8_t i = 0; i < BENCH_TASKS; i++)
+        {
+            counter[i] = 0;
+        }
+        isrCount = 0;
+        RTOS::initSemaphore(&ping, 1);
+        RTOS::initSemaphore(&pong, 0);
+        StreamBuffer::init(&queue, queueBuf, sizeof(queueBuf), 1);
+        MemPool::init(&pool, poolBuf, 128, 8);
+
+        for (uint8_t i = 0; i < BENCH_TASKS && test.tasks[i] != 0; i++)
+        {
+            RTOS::createProcess(test.tasks[i], test.priorities[i]);
+        }
+
+        uint32_t start = cycles();
+        RTOS::sleep(BENCH_INTERVAL);
+        uint32_t elapsed = cycles() - start;
+
+        uint32_t ops = 0;
+        for (uint8_t i = 0; i < BENCH_TASKS; i++)
+        {
+            ops += counter[i];
+        }
+        isrTarget = NO_TASK;
+        for (uint8_t i = 0; i < BENCH_TASKS && test.tasks[i] != 0; i++)
+        {
+            RTOS::destroyProcess(test.tasks[i]);
+        }
+        report(test.name, ops, elapsed);
+    }
+    semihostExit();
+    while (true);
+}
+
+//-----------------------------------------------------------------------------
+// Main
+//-----------------------------------------------------------------------------
+
+int main() {
+    RTOS::bspInit();
+    RTOS::rtosInit(MODE_PREEMPTIVE, BENCH_RELOAD);
+    putString("rtos-bench: ");
+    putNumber(BENCH_INTERVAL);
+    putString(" ticks per test\r\n");
+
+    bool ok = RTOS::createProcess(idle, 7);
+    ok &= RTOS::createProcess(runner, 0);
+    if (ok)
+        RTOS::rtosStart(); // never returns
+    semihostExit();
+    return 0;
+}
@@ -0,0 +1,289 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "damage.h"
+#include "lcd.h"
+
+// Define variables
+static uint8_t line[DAMAGE_LINE_BYTES];
+
+static int32_t area(const tRectangle& r) {
+    return (r.i16XMax - r.i16XMin + 1) * (r.i16YMax - r.i16YMin + 1);
+}
+
+static tRectangle unite(const tRectangle& a, const tRectangle& b) {
+    tRectangle r;
+    r.i16XMin = (a.i16XMin < b.i16XMin) ? a.i16XMin : b.i16XMin;
+    r.i16YMin = (a.i16YMin < b.i16YMin) ? a.i16YMin : b.i16YMin;
+    r.i16XMax = (a.i16XMax > b.i16XMax) ? a.i16XMax : b.i16XMax;
+    r.i16YMax = (a.i16YMax > b.i16YMax) ? a.i16YMax : b.i16YMax;
+    return r;
+}
+
+// clean pixels a merge would add; zero or less when a and b overlap or abut
+static int32_t mergeCost(const tRectangle& a, const tRectangle& b) {
+    return area(unite(a, b)) - area(a) - area(b);
+}
+
+static void removeRect(damageDisplay* d, uint8_t i) {
+    d->count--;
+    for (; i < d->count; i++)
+    {
+        d->rects[i] = d->rects[i + 1];
+    }
+}
+
+//-----------------------------------------------------------------------------
+// grlib Display Callbacks
+//-----------------------------------------------------------------------------
+
+// each one draws into the offscreen display, then records the damage
+
+static void pixelDraw(void* data, int32_t x, int32_t y, uint32_t value) {
+    damageDisplay* d = (damageDisplay*)data;
+    d->target->pfnPixelDraw(d->target->pvDisplayData, x, y, value);
+    Damage::add(d, x, y, x, y);
+}
+
+static void pixelDrawMultiple(void* data, int32_t x, int32_t y, int32_t x0, int32_t count,
+                              int32_t bpp, const uint8_t* pixels, const uint8_t* palette) {
+    damageDisplay* d = (damageDisplay*)data;
+    d->target->pfnPixelDrawMultiple(d->target->pvDisplayData, x, y, x0, count, bpp, pixels, palette);
+    Damage::add(d, x, y, x + count - 1, y);
+}
+
+static void lineDrawH(void* data, int32_t x1, int32_t x2, int32_t y, uint32_t value) {
+    damageDisplay* d = (damageDisplay*)data;
+    d->target->pfnLineDrawH(d->target->pvDisplayData, x1, x2, y, value);
+    Damage::add(d, x1, y, x2, y);
+}
+
+static void lineDrawV(void* data, int32_t x, int32_t y1, int32_t y2, uint32_t value) {
+    damageDisplay* d = (damageDisplay*)data;
+    d->target->pfnLineDrawV(d->target->pvDisplayData, x, y1, y2, value);
+    Damage::add(d, x, y1, x, y2);
+}
+
+static void rectFill(void* data, const tRectangle* rect, uint32_t value) {
+    damageDisplay* d = (damageDisplay*)data;
+    d->target->pfnRectFill(d->target->pvDisplayData, rect, value);
+    Damage::add(d, rect->i16XMin, rect->i16YMin, rect->i16XMax, rect->i16YMax);
+}
+
+static uint32_t colorTranslate(void* data, uint32_t value) {
+    damageDisplay* d = (damageDisplay*)data;
+    return d->target->pfnColorTranslate(d->target->pvDisplayData, value);
+}
+
+static void flush(void* data) {
+    Damage::flush((damageDisplay*)data);
+}
+
+//-----------------------------------------------------------------------------
+// Damage-Tracking Display
+//-----------------------------------------------------------------------------
+
+void Damage::init(damageDisplay* d, const tDisplay* offscreen, damageFlushFn flushRect, void* panel) {
+    d->display.i32Size = sizeof(tDisplay);
+    d->display.pvDisplayData = d;
+    d->display.ui16Width = offscreen->ui16Width;
+    d->display.ui16Height = offscreen->ui16Height;
+    d->display.pfnPixelDraw = pixelDraw;
+    d->display.pfnPixelDrawMultiple = pixelDrawMultiple;
+    d->display.pfnLineDrawH = lineDrawH;
+    d->display.pfnLineDrawV = lineDrawV;
+    d->display.pfnRectFill = rectFill;
+    d->display.pfnColorTranslate = colorTranslate;
+    d->display.pfnFlush = ::flush;
+    d->target = offscreen;
+    d->flushRect = flushRect;
+    d->panel = panel;
+    d->count = 0;
+}
+
+void Damage::add(damageDisplay* d, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    // inclusive bounds, in any order; clipped to the display
+    if (x0 > x1)
+    {
+        int32_t t = x0; x0 = x1; x1 = t;
+    }
+    if (y0 > y1)
+    {
+        int32_t t = y0; y0 = y1; y1 = t;
+    }
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 >= d->display.ui16Width)
+        x1 = d->display.ui16Width - 1;
+    if (y1 >= d->display.ui16Height)
+        y1 = d->display.ui16Height - 1;
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    tRectangle r = { (int16_t)x0, (int16_t)y0, (int16_t)x1, (int16_t)y1 };
+
+    // pick the merge that wastes the least area
+    uint8_t best = 0;
+    int32_t bestCost = INT32_MAX;
+    for (uint8_t i = 0; i < d->count; i++)
+    {
+        const tRectangle& q = d->rects[i];
+        if (q.i16XMin <= r.i16XMin && q.i16YMin <= r.i16YMin &&
+            q.i16XMax >= r.i16XMax && q.i16YMax >= r.i16YMax)
+            return;     // already dirty
+        int32_t cost = mergeCost(q, r);
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            best = i;
+        }
+    }
+
+    if (d->count < DAMAGE_MAX_RECTS && bestCost > 0)
+    {
+        d->rects[d->count++] = r;
+        return;
+    }
+
+    // merge, then absorb any rectangle the grown one now overlaps or touches
+    d->rects[best] = unite(d->rects[best], r);
+    for (uint8_t i = 0; i < d->count; )
+    {
+        if (i != best && mergeCost(d->rects[best], d->rects[i]) <= 0)
+        {
+            d->rects[best] = unite(d->rects[best], d->rects[i]);
+            removeRect(d, i);
+            if (best > i)
+                best--;
+            i = 0;
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void Damage::addAll(damageDisplay* d) {
+    // e.g. after the panel was reset or the palette changed
+    d->count = 1;
+    d->rects[0].i16XMin = 0;
+    d->rects[0].i16YMin = 0;
+    d->rects[0].i16XMax = d->display.ui16Width - 1;
+    d->rects[0].i16YMax = d->display.ui16Height - 1;
+}
+
+void Damage::flush(damageDisplay* d) {
+    for (uint8_t i = 0; i < d->count; i++)
+    {
+        d->flushRect(d->panel, d->target, &d->rects[i]);
+    }
+    d->count = 0;
+    d->target->pfnFlush(d->target->pvDisplayData);
+}
+
+//-----------------------------------------------------------------------------
+// Panel Output
+//-----------------------------------------------------------------------------
+
+void Damage::rowToRgb565(const tDisplay* offscreen, int32_t x, int32_t y, int32_t width, uint8_t* out) {
+    // converts width pixels of one row to RGB565, most significant byte first
+    const uint8_t* image = (const uint8_t*)offscreen->pvDisplayData;
+    uint32_t stride = image[1] | (image[2] << 8);
+
+    switch (image[0])
+    {
+    case IMAGE_FMT_8BPP_UNCOMP:
+    {
+        const uint8_t* palette = image + 6;     // B, G, R per entry
+        const uint8_t* pixel = image + 6 + 256 * 3 + y * stride + x;
+        for (int32_t i = 0; i < width; i++)
+        {
+            const uint8_t* c = palette + pixel[i] * 3;
+            uint16_t v = ((c[2] & 0xF8) << 8) | ((c[1] & 0xFC) << 3) | (c[0] >> 3);
+            *out++ = v >> 8;
+            *out++ = v;
+        }
+        break;
+    }
+    case IMAGE_FMT_4BPP_UNCOMP:
+    {
+        const uint8_t* palette = image + 6;
+        const uint8_t* row = image + 6 + 16 * 3 + y * ((stride + 1) / 2);
+        for (int32_t i = x; i < x + width; i++)
+        {
+            uint8_t index = (row[i / 2] >> ((1 - (i & 1)) * 4)) & 15;
+            const uint8_t* c = palette + index * 3;
+            uint16_t v = ((c[2] & 0xF8) << 8) | ((c[1] & 0xFC) << 3) | (c[0] >> 3);
+            *out++ = v >> 8;
+            *out++ = v;
+        }
+        break;
+    }
+    default:    // IMAGE_FMT_1BPP_UNCOMP, 1 is white
+    {
+        const uint8_t* row = image + 5 + y * ((stride + 7) / 8);
+        for (int32_t i = x; i < x + width; i++)
+        {
+            uint8_t v = ((row[i / 8] >> (7 - (i & 7))) & 1) ? 0xFF : 0x00;
+            *out++ = v;
+            *out++ = v;
+        }
+        break;
+    }
+    }
+}
+
+void Damage::lcdFlush(void* panel, const tDisplay* offscreen, const tRectangle* rect) {
+    // converts as many rows as fit in the staging buffer, then DMAs them out
+    (void)panel;
+    int32_t width = rect->i16XMax - rect->i16XMin + 1;
+    int32_t rowsPerChunk = DAMAGE_LINE_BYTES / (2 * width);
+    if (rowsPerChunk == 0)
+        rowsPerChunk = 1;   // rows wider than the buffer go out in pieces
+
+    Lcd::setWindow(rect->i16XMin, rect->i16YMin, rect->i16XMax, rect->i16YMax);
+    for (int32_t y = rect->i16YMin; y <= rect->i16YMax; )
+    {
+        uint32_t length = 0;
+        for (int32_t n = 0; n < rowsPerChunk && y <= rect->i16YMax; n++, y++)
+        {
+            for (int32_t x = rect->i16XMin; x <= rect->i16XMax; )
+            {
+                int32_t span = rect->i16XMax - x + 1;
+                if (span > DAMAGE_LINE_BYTES / 2)
+                    span = DAMAGE_LINE_BYTES / 2;
+                if (length + 2 * span > DAMAGE_LINE_BYTES)
+                {
+                    Lcd::writePixels(line, length);
+                    length = 0;
+                }
+                rowToRgb565(offscreen, x, y, span, line + length);
+                length += 2 * span;
+                x += span;
+            }
+        }
+        Lcd::writePixels(line, length);
+    }
+    Lcd::end();
+}
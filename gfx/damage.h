@@ -0,0 +1,72 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Damage-Tracking Display
+//-----------------------------------------------------------------------------
+
+/// A grlib display that draws into an offscreen 1/4/8 bpp display and records
+/// which regions changed. Every draw merges its bounds into at most
+/// DAMAGE_MAX_RECTS dirty rectangles, picking whichever merge adds the least
+/// clean area; GrFlush() then pushes only those rectangles to the panel and
+/// clears them.
+///
+/// Hand damageDisplay.display to GrContextInit(). flushRect is called once per
+/// dirty rectangle; lcdFlush() sends it to the SPI panel (hal/lcd.h) by DMA.
+
+#define DAMAGE_MAX_RECTS    4
+#define DAMAGE_LINE_BYTES   1024    // RGB565 staging buffer for lcdFlush()
+
+/// pushes one dirty rectangle of the offscreen display to the panel
+typedef void (*damageFlushFn)(void* panel, const tDisplay* offscreen, const tRectangle* rect);
+
+struct damageDisplay
+{
+  tDisplay display;                   // wrapper handed to grlib
+  const tDisplay *target;             // offscreen display holding the pixels
+  damageFlushFn flushRect;
+  void *panel;                        // context for flushRect
+  tRectangle rects[DAMAGE_MAX_RECTS]; // dirty regions, inclusive bounds
+  uint8_t count;
+};
+
+/// Class for damage-tracking display
+class Damage
+{
+public:
+    static void init(damageDisplay* d, const tDisplay* offscreen, damageFlushFn flushRect, void* panel);
+    static void add(damageDisplay* d, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+    static void addAll(damageDisplay* d);
+    static void flush(damageDisplay* d);
+
+    // panel side
+    static void rowToRgb565(const tDisplay* offscreen, int32_t x, int32_t y, int32_t width, uint8_t* out);
+    static void lcdFlush(void* panel, const tDisplay* offscreen, const tRectangle* rect);
+};
+
+#endif // DAMAGE_H
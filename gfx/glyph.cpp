@@ -0,0 +1,407 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include <string.h>
+#include "glyph.h"
+#include "crc.h"
+
+// Define variables
+static glyphSlot slots[GLYPH_CACHE_SLOTS];
+static uint8_t buckets[GLYPH_HASH_BUCKETS];
+static uint8_t newest;
+static uint8_t oldest;
+static uint32_t hitCount;
+static uint32_t missCount;
+static uint8_t decodeImage[5 + GLYPH_SLOT_BYTES];  // 1 bpp offscreen header and bitmap
+
+//-----------------------------------------------------------------------------
+// Cache Lists
+//-----------------------------------------------------------------------------
+
+static uint32_t bucketOf(const tFont* font, uint32_t codepoint) {
+    uint32_t h = (uint32_t)(uintptr_t)font + codepoint;
+    return ((h * 0x9E3779B1u) >> 24) & (GLYPH_HASH_BUCKETS - 1);
+}
+
+static void unlink(uint8_t i) {
+    glyphSlot& g = slots[i];
+    if (g.older != GLYPH_NONE)
+        slots[g.older].newer = g.newer;
+    else
+        oldest = g.newer;
+    if (g.newer != GLYPH_NONE)
+        slots[g.newer].older = g.older;
+    else
+        newest = g.older;
+}
+
+static void pushNewest(uint8_t i) {
+    slots[i].older = newest;
+    slots[i].newer = GLYPH_NONE;
+    if (newest != GLYPH_NONE)
+        slots[newest].newer = i;
+    else
+        oldest = i;
+    newest = i;
+}
+
+static void touch(uint8_t i) {
+    if (i != newest)
+    {
+        unlink(i);
+        pushNewest(i);
+    }
+}
+
+static void unhash(uint8_t i) {
+    uint8_t* link = &buckets[bucketOf(slots[i].font, slots[i].codepoint)];
+    while (*link != i)
+    {
+        link = &slots[*link].chain;
+    }
+    *link = slots[i].chain;
+}
+
+//-----------------------------------------------------------------------------
+// Decoding and Drawing
+//-----------------------------------------------------------------------------
+
+// same fallbacks as GrDefaultStringRenderer: the glyph, then '.', then ' '
+static const uint8_t* glyphData(const tFont* font, uint32_t codepoint, uint8_t* advance) {
+    const uint8_t* data = GrFontGlyphDataGet(font, codepoint, advance);
+    if (!data)
+        data = GrFontGlyphDataGet(font, '.', advance);
+    if (!data)
+        data = GrFontGlyphDataGet(font, ' ', advance);
+    return data;
+}
+
+// whether the glyph's bitmap fits a slot, checked before a slot is evicted
+static bool fits(const tFont* font, uint32_t codepoint) {
+    uint8_t format, maxWidth, height, baseline, advance;
+    GrFontInfoGet(font, &format, &maxWidth, &height, &baseline);
+    const uint8_t* data = glyphData(font, codepoint, &advance);
+    return !data || ((data[1] + 7) / 8) * height <= GLYPH_SLOT_BYTES;
+}
+
+static void decode(glyphSlot* g, const tFont* font, uint32_t codepoint) {
+    uint8_t format, maxWidth, height, baseline, advance;
+    GrFontInfoGet(font, &format, &maxWidth, &height, &baseline);
+    const uint8_t* data = glyphData(font, codepoint, &advance);
+
+    g->height = height;
+    if (!data)
+    {
+        // grlib leaves a blank of the widest glyph
+        g->width = 0;
+        g->advance = maxWidth;
+        return;
+    }
+    g->width = data[1];
+    g->advance = advance;
+    if (g->width == 0)
+        return;
+
+    uint32_t size = ((g->width + 7) / 8) * height;
+
+    // let grlib decode it into a cleared 1 bpp image
+    tDisplay display;
+    tContext context;
+    GrOffScreen1BPPInit(&display, decodeImage, g->width, height);
+    memset(decodeImage + 5, 0, size);
+    GrContextInit(&context, &display);
+    GrContextForegroundSetTranslated(&context, 1);
+    GrFontGlyphRender(&context, data, 0, 0, (format & FONT_FMT_PIXEL_RLE) != 0, false);
+    memcpy(g->bitmap, decodeImage + 5, size);
+}
+
+// first bit at or after i that is set (or clear), or end
+static int32_t findBit(const uint8_t* bits, int32_t i, int32_t end, bool set) {
+    for (; i < end; i++)
+    {
+        if ((((bits[i >> 3] >> (7 - (i & 7))) & 1) != 0) == set)
+            break;
+    }
+    return i;
+}
+
+// calls fn(start, end) for each run of set bits within columns first..last
+template <class Fn>
+static void forEachRun(const uint8_t* bits, int32_t first, int32_t last, Fn fn) {
+    if (last < 32)
+    {
+        // the whole row in one word, column 0 in the top bit; CLZ finds each edge
+        uint32_t v = 0;
+        for (int32_t i = 0; i <= last / 8; i++)
+        {
+            v |= (uint32_t)bits[i] << (24 - 8 * i);
+        }
+        v &= (0xFFFFFFFFu >> first) & ~(0x7FFFFFFFu >> last);
+        while (v)
+        {
+            int32_t start = __builtin_clz(v);
+            uint32_t ones = ~(v << start);
+            int32_t end = start + (ones ? __builtin_clz(ones) : 32);
+            fn(start, end - 1);
+            v = (end < 32) ? v & (0xFFFFFFFFu >> end) : 0;
+        }
+        return;
+    }
+    for (int32_t i = findBit(bits, first, last + 1, true); i <= last; )
+    {
+        int32_t end = findBit(bits, i, last + 1, false);
+        fn(i, end - 1);
+        i = findBit(bits, end, last + 1, true);
+    }
+}
+
+static void drawGlyph(const tContext* context, const glyphSlot* g, int32_t x, int32_t y, bool opaque) {
+    const tRectangle& clip = context->sClipRegion;
+    int32_t first = (clip.i16XMin > x) ? clip.i16XMin - x : 0;     // columns inside the clip
+    int32_t last = (clip.i16XMax < x + g->width - 1) ? clip.i16XMax - x : g->width - 1;
+    if (first > last)
+        return;
+
+    int32_t top = (clip.i16YMin > y) ? clip.i16YMin - y : 0;          // rows inside the clip
+    int32_t bottom = (clip.i16YMax < y + g->height - 1) ? clip.i16YMax - y : g->height - 1;
+    if (top > bottom)
+        return;
+
+    // opaque: one fill for the cell, then the foreground runs over it
+    if (opaque)
+    {
+        tRectangle cell = { (int16_t)(x + first), (int16_t)(y + top),
+                            (int16_t)(x + last), (int16_t)(y + bottom) };
+        DpyRectFill(context->psDisplay, &cell, context->ui32Background);
+    }
+
+    uint32_t stride = (g->width + 7) / 8;
+    for (int32_t row = top; row <= bottom; row++)
+    {
+        int32_t py = y + row;
+        forEachRun(g->bitmap + row * stride, first, last, [&](int32_t start, int32_t end) {
+            DpyLineDrawH(context->psDisplay, x + start, x + end, py, context->ui32Foreground);
+        });
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Glyph Cache
+//-----------------------------------------------------------------------------
+
+void Glyph::init() {
+    for (uint8_t i = 0; i < GLYPH_HASH_BUCKETS; i++)
+    {
+        buckets[i] = GLYPH_NONE;
+    }
+    newest = GLYPH_NONE;
+    oldest = GLYPH_NONE;
+    for (uint8_t i = 0; i < GLYPH_CACHE_SLOTS; i++)
+    {
+        slots[i].font = 0;
+        pushNewest(i);
+    }
+    hitCount = 0;
+    missCount = 0;
+}
+
+const glyphSlot* Glyph::get(const tFont* font, uint32_t codepoint) {
+    uint32_t bucket = bucketOf(font, codepoint);
+    for (uint8_t i = buckets[bucket]; i != GLYPH_NONE; i = slots[i].chain)
+    {
+        if (slots[i].font == font && slots[i].codepoint == codepoint)
+        {
+            hitCount++;
+            touch(i);
+            return &slots[i];
+        }
+    }
+
+    // too large to cache: leave the cached glyphs where they are
+    missCount++;
+    if (!fits(font, codepoint))
+        return 0;
+
+    // evict the least recently used slot
+    uint8_t i = oldest;
+    glyphSlot* g = &slots[i];
+    if (g->font)
+        unhash(i);
+    decode(g, font, codepoint);
+
+    g->font = font;
+    g->codepoint = codepoint;
+    g->chain = buckets[bucket];
+    buckets[bucket] = i;
+    touch(i);
+    return g;
+}
+
+void Glyph::renderer(const tContext* context, const char* string, int32_t length,
+                     int32_t x, int32_t y, bool opaque) {
+    // drop-in for GrDefaultStringRenderer
+    const tRectangle& clip = context->sClipRegion;
+    uint8_t format, maxWidth, height, baseline;
+    GrFontInfoGet(context->psFont, &format, &maxWidth, &height, &baseline);
+    if (y > clip.i16YMax || y + height < clip.i16YMin)
+        return;
+
+    uint32_t count = (uint32_t)length;   // -1: up to the terminator
+    uint32_t skip;
+    while (count)
+    {
+        uint32_t codepoint = GrStringNextCharGet(context, string, count, &skip);
+        if (!codepoint || x > clip.i16XMax)
+            return;
+
+        const glyphSlot* g = get(context->psFont, codepoint);
+        if (g)
+        {
+            drawGlyph(context, g, x, y, opaque);
+            x += g->advance;
+        }
+        else
+        {
+            // too large to cache
+            uint8_t advance;
+            const uint8_t* data = glyphData(context->psFont, codepoint, &advance);
+            GrFontGlyphRender(context, data, x, y, (format & FONT_FMT_PIXEL_RLE) != 0, opaque);
+            x += advance;
+        }
+        string += skip;
+        count -= skip;
+    }
+}
+
+uint32_t Glyph::hits() {
+    return hitCount;
+}
+
+uint32_t Glyph::misses() {
+    return missCount;
+}
+
+//-----------------------------------------------------------------------------
+// Pre-rasterized Text
+//-----------------------------------------------------------------------------
+
+void Glyph::textInit(glyphText* text, glyphSpan* spans, uint16_t capacity) {
+    text->spans = spans;
+    text->capacity = capacity;
+    text->count = 0;
+    text->width = 0;
+    text->height = 0;
+    text->valid = false;
+    text->key = 0;
+}
+
+bool Glyph::textSet(glyphText* text, const tContext* context, const char* string, int32_t length) {
+    // false if a glyph is uncacheable or the spans do not fit
+    const tFont* font = context->psFont;
+    uint32_t bytes = 0;
+    while (bytes < (uint32_t)length && string[bytes])
+    {
+        bytes++;
+    }
+    uint32_t key = Crc::crc32(Crc::crc32(0, &font, sizeof(font)), string, bytes);
+    if (text->valid && text->key == key)
+        return true;
+
+    text->valid = false;
+    text->count = 0;
+    text->key = key;
+
+    int32_t x = 0;
+    uint32_t skip;
+    while (bytes)
+    {
+        uint32_t codepoint = GrStringNextCharGet(context, string, bytes, &skip);
+        if (!codepoint)
+            break;
+        const glyphSlot* g = get(font, codepoint);
+        if (!g)
+            return false;
+
+        // a blank (no glyph and no fallback) has no bitmap to scan
+        uint32_t stride = (g->width + 7) / 8;
+        for (int32_t row = 0; g->width != 0 && row < g->height; row++)
+        {
+            const uint8_t* bits = g->bitmap + row * stride;
+            bool full = false;
+            forEachRun(bits, 0, g->width - 1, [&](int32_t start, int32_t end) {
+                if (text->count == text->capacity)
+                {
+                    full = true;
+                    return;
+                }
+                glyphSpan& span = text->spans[text->count++];
+                span.x = x + start;
+                span.y = row;
+                span.length = end - start + 1;
+            });
+            if (full)
+                return false;
+        }
+        x += g->advance;
+        string += skip;
+        bytes -= skip;
+    }
+
+    uint8_t format, maxWidth, height, baseline;
+    GrFontInfoGet(font, &format, &maxWidth, &height, &baseline);
+    text->width = x;
+    text->height = height;
+    text->valid = true;
+    return true;
+}
+
+void Glyph::textDraw(const tContext* context, const glyphText* text, int32_t x, int32_t y, bool opaque) {
+    if (!text->valid)
+        return;
+
+    const tRectangle& clip = context->sClipRegion;
+    if (opaque)
+    {
+        tRectangle r;
+        r.i16XMin = (x > clip.i16XMin) ? x : clip.i16XMin;
+        r.i16YMin = (y > clip.i16YMin) ? y : clip.i16YMin;
+        r.i16XMax = (x + text->width - 1 < clip.i16XMax) ? x + text->width - 1 : clip.i16XMax;
+        r.i16YMax = (y + text->height - 1 < clip.i16YMax) ? y + text->height - 1 : clip.i16YMax;
+        if (r.i16XMin <= r.i16XMax && r.i16YMin <= r.i16YMax)
+            DpyRectFill(context->psDisplay, &r, context->ui32Background);
+    }
+
+    for (uint16_t i = 0; i < text->count; i++)
+    {
+        const glyphSpan& span = text->spans[i];
+        int32_t py = y + span.y;
+        int32_t x0 = x + span.x;
+        int32_t x1 = x0 + span.length - 1;
+        if (py < clip.i16YMin || py > clip.i16YMax)
+            continue;
+        if (x0 < clip.i16XMin)
+            x0 = clip.i16XMin;
+        if (x1 > clip.i16XMax)
+            x1 = clip.i16XMax;
+        if (x0 <= x1)
+            DpyLineDrawH(context->psDisplay, x0, x1, py, context->ui32Foreground);
+    }
+}
@@ -0,0 +1,104 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef GLYPH_H
+#define GLYPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Glyph Cache
+//-----------------------------------------------------------------------------
+
+/// Decoded 1 bpp glyph bitmaps in SRAM, keyed by font and codepoint and
+/// evicted least recently used first. A miss decodes the glyph once with
+/// grlib's own GrFontGlyphRender into a 1 bpp offscreen image, so compressed,
+/// wide and wrapped fonts all come out exactly as grlib draws them.
+///
+/// Call init() once, then set context.pfnStringRenderer = Glyph::renderer to
+/// serve GrStringDraw from the cache. Glyphs larger than GLYPH_SLOT_BYTES
+/// bypass it and are drawn by grlib as before.
+///
+/// A glyphText holds a string pre-rasterized into horizontal runs of
+/// foreground pixels. textSet() only re-rasterizes when the font or the bytes
+/// of the string change, so a label redrawn every frame costs one CRC and a
+/// LineDrawH per run. All of this must be used from one drawing task.
+
+#ifndef GLYPH_CACHE_SLOTS
+#define GLYPH_CACHE_SLOTS   24
+#endif
+#ifndef GLYPH_SLOT_BYTES
+#define GLYPH_SLOT_BYTES    96      // e.g. 24x32 or 32x24 pixels
+#endif
+#define GLYPH_HASH_BUCKETS  32      // power of two
+#define GLYPH_NONE          0xFF
+
+struct glyphSlot
+{
+  const tFont *font;              // 0 while unused
+  uint32_t codepoint;
+  uint8_t advance;                // pixels to the next glyph
+  uint8_t width;                  // bitmap width, 0 if nothing is drawn
+  uint8_t height;
+  uint8_t older;                  // LRU list neighbours
+  uint8_t newer;
+  uint8_t chain;                  // next slot in the same hash bucket
+  uint8_t bitmap[GLYPH_SLOT_BYTES]; // rows of (width + 7) / 8 bytes, MSB first
+};
+
+struct glyphSpan
+{
+  int16_t x;                      // from the left of the text
+  uint8_t y;                      // from the top of the text
+  uint8_t length;
+};
+
+struct glyphText
+{
+  glyphSpan *spans;
+  uint16_t capacity;
+  uint16_t count;
+  int16_t width;
+  uint8_t height;
+  bool valid;
+  uint32_t key;                   // CRC of the font pointer and string bytes
+};
+
+/// Class for glyph cache
+class Glyph
+{
+public:
+    static void init();
+    static const glyphSlot* get(const tFont* font, uint32_t codepoint);
+    static void renderer(const tContext* context, const char* string, int32_t length,
+                         int32_t x, int32_t y, bool opaque);
+    static uint32_t hits();
+    static uint32_t misses();
+
+    // pre-rasterized strings
+    static void textInit(glyphText* text, glyphSpan* spans, uint16_t capacity);
+    static bool textSet(glyphText* text, const tContext* context, const char* string, int32_t length);
+    static void textDraw(const tContext* context, const glyphText* text, int32_t x, int32_t y, bool opaque);
+};
+
+#endif // GLYPH_H
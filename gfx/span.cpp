@@ -0,0 +1,546 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include <string.h>
+#include "span.h"
+
+typedef uint32_t (*colorTranslateFn)(void* data, uint32_t value);
+
+// Define variables
+static colorTranslateFn translate8;     // grlib's own, saved by install()
+static colorTranslateFn translate4;
+static const void* lutImage;            // cache owner: display buffer and image palette
+static const uint8_t* lutPalette;
+static uint32_t lutValid[256 / 32];
+static uint8_t lut[256];
+
+// byte lanes set for each bit of a nibble, first pixel in the top bit
+static const uint32_t expand[16] = {
+    0x00000000, 0xFF000000, 0x00FF0000, 0xFFFF0000,
+    0x0000FF00, 0xFF00FF00, 0x00FFFF00, 0xFFFFFF00,
+    0x000000FF, 0xFF0000FF, 0x00FF00FF, 0xFFFF00FF,
+    0x0000FFFF, 0xFF00FFFF, 0x00FFFFFF, 0xFFFFFFFF,
+};
+
+//-----------------------------------------------------------------------------
+// Word Helpers
+//-----------------------------------------------------------------------------
+
+// memcpy compiles to a single LDR/STR, unaligned loads included on the M4
+static inline uint32_t load32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline void store32(uint8_t* p, uint32_t v) {
+    memcpy(p, &v, 4);
+}
+
+static inline void store16(uint8_t* p, uint32_t v) {
+    uint16_t h = v;
+    memcpy(p, &h, 2);
+}
+
+// REV: puts 4 bpp pixels in order from the top nibble down
+static inline uint32_t rev(uint32_t v) {
+    return __builtin_bswap32(v);
+}
+
+// source lanes that differ from the key, destination lanes elsewhere
+static inline uint32_t keyed8(uint32_t src, uint32_t dst, uint32_t key) {
+#if defined(__ARM_FEATURE_SIMD32)
+    uint32_t r;
+    __asm ("UADD8 %0, %1, %2\n\t"       // GE[n] = carry out of byte n: set unless it is zero
+           "SEL %0, %3, %4"
+           : "=&r" (r) : "r" (src ^ key), "r" (0xFFFFFFFFu), "r" (src), "r" (dst) : "cc");
+    return r;
+#else
+    uint32_t x = src ^ key;
+    uint32_t m = (((x & 0x7F7F7F7Fu) + 0x7F7F7F7Fu) | x) & 0x80808080u;
+    m = (m >> 7) * 0xFFu;
+    return (src & m) | (dst & ~m);
+#endif
+}
+
+static inline uint32_t keyed4(uint32_t src, uint32_t dst, uint32_t key) {
+    uint32_t x = src ^ key;
+    uint32_t m = (((x & 0x77777777u) + 0x77777777u) | x) & 0x88888888u;
+    m = (m >> 3) * 0xFu;
+    return (src & m) | (dst & ~m);
+}
+
+//-----------------------------------------------------------------------------
+// 8 bpp Rows
+//-----------------------------------------------------------------------------
+
+template <bool Keyed>
+static inline void put8(uint8_t* p, uint8_t s, uint32_t key) {
+    if (!Keyed || s != (uint8_t)key)
+        *p = s;
+}
+
+// a byte and two bytes up to a word boundary, whole words, then two bytes and
+// a byte: nothing outside the span is read or written
+template <bool Keyed>
+static void blit8(uint8_t* dst, const uint8_t* src, int32_t count, uint32_t key) {
+    if (count <= 0)
+        return;
+    if ((uintptr_t)dst & 1)
+    {
+        put8<Keyed>(dst++, *src++, key);
+        count--;
+    }
+    if (((uintptr_t)dst & 2) && count >= 2)
+    {
+        put8<Keyed>(dst, src[0], key);
+        put8<Keyed>(dst + 1, src[1], key);
+        dst += 2;
+        src += 2;
+        count -= 2;
+    }
+    for (; count >= 4; count -= 4, dst += 4, src += 4)
+    {
+        uint32_t v = load32(src);
+        store32(dst, Keyed ? keyed8(v, load32(dst), key) : v);
+    }
+    if (count & 2)
+    {
+        put8<Keyed>(dst, src[0], key);
+        put8<Keyed>(dst + 1, src[1], key);
+        dst += 2;
+        src += 2;
+    }
+    if (count & 1)
+        put8<Keyed>(dst, *src, key);
+}
+
+void Span::fill8(uint8_t* row, int32_t x0, int32_t x1, uint8_t index) {
+    if (x1 < x0)
+        return;
+    uint8_t* p = row + x0;
+    int32_t count = x1 - x0 + 1;
+    uint32_t v = index * 0x01010101u;
+
+    if ((uintptr_t)p & 1)
+    {
+        *p++ = index;
+        count--;
+    }
+    if (((uintptr_t)p & 2) && count >= 2)
+    {
+        store16(p, v);
+        p += 2;
+        count -= 2;
+    }
+    for (; count >= 16; count -= 16, p += 16)
+    {
+        store32(p, v);
+        store32(p + 4, v);
+        store32(p + 8, v);
+        store32(p + 12, v);
+    }
+    for (; count >= 4; count -= 4, p += 4)
+    {
+        store32(p, v);
+    }
+    if (count & 2)
+    {
+        store16(p, v);
+        p += 2;
+    }
+    if (count & 1)
+        *p = index;
+}
+
+void Span::copy8(uint8_t* dst, const uint8_t* src, int32_t count) {
+    blit8<false>(dst, src, count, 0);
+}
+
+void Span::blitKey8(uint8_t* dst, const uint8_t* src, int32_t count, uint8_t key) {
+    blit8<true>(dst, src, count, key * 0x01010101u);
+}
+
+//-----------------------------------------------------------------------------
+// 4 bpp Rows
+//-----------------------------------------------------------------------------
+
+// even pixels are in the high nibble of each byte
+struct packed4
+{
+  const uint8_t *row;
+
+  uint32_t pixel(int32_t q) const {
+      return (row[q >> 1] >> ((~q & 1) * 4)) & 15;
+  }
+  // pixels q..q+7, first in the top nibble
+  uint32_t word(int32_t q) const {
+      const uint8_t* p = row + (q >> 1);
+      uint32_t v = rev(load32(p));
+      if (q & 1)
+          v = (v << 4) | (p[4] >> 4);
+      return v;
+  }
+};
+
+// one pixel per byte, as translated by pixelDrawMultiple()
+struct unpacked4
+{
+  const uint8_t *row;
+
+  uint32_t pixel(int32_t q) const {
+      return row[q] & 15;
+  }
+  uint32_t word(int32_t q) const {
+      uint32_t v = 0;
+      for (int32_t n = 0; n < 8; n++)
+      {
+          v = (v << 4) | (row[q + n] & 15);
+      }
+      return v;
+  }
+};
+
+// one destination byte from source pixels q (high nibble) and q + 1 (low),
+// each only if its flag is set and, when keyed, it differs from the key
+template <bool Keyed, class Source>
+static void byte4(uint8_t* p, const Source& src, int32_t q, bool high, bool low, uint32_t key) {
+    uint32_t v = *p;
+    if (high)
+    {
+        uint32_t s = src.pixel(q);
+        if (!Keyed || s != (key & 15))
+            v = (v & 0x0F) | (s << 4);
+    }
+    if (low)
+    {
+        uint32_t s = src.pixel(q + 1);
+        if (!Keyed || s != (key & 15))
+            v = (v & 0xF0) | s;
+    }
+    *p = v;
+}
+
+// as blit8, in bytes of two pixels, with a lone nibble at either end
+template <bool Keyed, class Source>
+static void blit4(uint8_t* dstRow, int32_t x, const Source& src, int32_t sx, int32_t count, uint32_t key) {
+    if (count <= 0)
+        return;
+    uint8_t* p = dstRow + (x >> 1);
+    int32_t delta = sx - x;             // source pixel of destination pixel d is d + delta
+    int32_t d = x;
+    int32_t end = x + count;
+
+    if (d & 1)
+    {
+        byte4<Keyed>(p++, src, d - 1 + delta, false, true, key);
+        d++;
+    }
+    if (((uintptr_t)p & 1) && d + 2 <= end)
+    {
+        byte4<Keyed>(p++, src, d + delta, true, true, key);
+        d += 2;
+    }
+    if (((uintptr_t)p & 2) && d + 4 <= end)
+    {
+        byte4<Keyed>(p, src, d + delta, true, true, key);
+        byte4<Keyed>(p + 1, src, d + 2 + delta, true, true, key);
+        p += 2;
+        d += 4;
+    }
+    for (; d + 8 <= end; d += 8, p += 4)
+    {
+        uint32_t v = src.word(d + delta);
+        if (Keyed)
+            v = keyed4(v, rev(load32(p)), key);
+        store32(p, rev(v));
+    }
+    if (d + 4 <= end)
+    {
+        byte4<Keyed>(p, src, d + delta, true, true, key);
+        byte4<Keyed>(p + 1, src, d + 2 + delta, true, true, key);
+        p += 2;
+        d += 4;
+    }
+    if (d + 2 <= end)
+    {
+        byte4<Keyed>(p++, src, d + delta, true, true, key);
+        d += 2;
+    }
+    if (d < end)
+        byte4<Keyed>(p, src, d + delta, true, false, key);
+}
+
+void Span::fill4(uint8_t* row, int32_t x0, int32_t x1, uint8_t index) {
+    if (x1 < x0)
+        return;
+    uint8_t* p = row + (x0 >> 1);
+    int32_t d = x0;
+    int32_t end = x1 + 1;
+    uint8_t b = (index & 15) * 0x11;
+    uint32_t v = b * 0x01010101u;       // same in either byte order
+
+    if (d & 1)
+    {
+        *p = (*p & 0xF0) | (b & 0x0F);
+        p++;
+        d++;
+    }
+    if (((uintptr_t)p & 1) && d + 2 <= end)
+    {
+        *p++ = b;
+        d += 2;
+    }
+    if (((uintptr_t)p & 2) && d + 4 <= end)
+    {
+        store16(p, v);
+        p += 2;
+        d += 4;
+    }
+    for (; d + 32 <= end; d += 32, p += 16)
+    {
+        store32(p, v);
+        store32(p + 4, v);
+        store32(p + 8, v);
+        store32(p + 12, v);
+    }
+    for (; d + 8 <= end; d += 8, p += 4)
+    {
+        store32(p, v);
+    }
+    if (d + 4 <= end)
+    {
+        store16(p, v);
+        p += 2;
+        d += 4;
+    }
+    if (d + 2 <= end)
+    {
+        *p++ = b;
+        d += 2;
+    }
+    if (d < end)
+        *p = (*p & 0x0F) | (b & 0xF0);
+}
+
+void Span::copy4(uint8_t* dstRow, int32_t x, const uint8_t* srcRow, int32_t sx, int32_t count) {
+    packed4 src = { srcRow };
+    blit4<false>(dstRow, x, src, sx, count, 0);
+}
+
+void Span::blitKey4(uint8_t* dstRow, int32_t x, const uint8_t* srcRow, int32_t sx, int32_t count, uint8_t key) {
+    packed4 src = { srcRow };
+    blit4<true>(dstRow, x, src, sx, count, (key & 15) * 0x11111111u);
+}
+
+//-----------------------------------------------------------------------------
+// grlib Display Callbacks
+//-----------------------------------------------------------------------------
+
+static inline bool is8bpp(const uint8_t* image) {
+    return image[0] == IMAGE_FMT_8BPP_UNCOMP;
+}
+
+static inline uint8_t* rowOf(uint8_t* image, int32_t y) {
+    uint32_t width = image[1] | (image[2] << 8);
+    if (is8bpp(image))
+        return image + 6 + 256 * 3 + y * width;
+    return image + 6 + 16 * 3 + y * ((width + 1) / 2);
+}
+
+// fills come one per format, chosen by install(), so short lines skip the
+// format test
+static void lineDrawH8(void* data, int32_t x1, int32_t x2, int32_t y, uint32_t value) {
+    uint8_t* image = (uint8_t*)data;
+    uint32_t width = image[1] | (image[2] << 8);
+    Span::fill8(image + 6 + 256 * 3 + y * width, x1, x2, value);
+}
+
+static void lineDrawH4(void* data, int32_t x1, int32_t x2, int32_t y, uint32_t value) {
+    uint8_t* image = (uint8_t*)data;
+    uint32_t width = image[1] | (image[2] << 8);
+    Span::fill4(image + 6 + 16 * 3 + y * ((width + 1) / 2), x1, x2, value);
+}
+
+static void rectFill8(void* data, const tRectangle* rect, uint32_t value) {
+    // row by row, where grlib's 8 bpp fill walks down columns
+    uint8_t* image = (uint8_t*)data;
+    uint32_t width = image[1] | (image[2] << 8);
+    uint8_t* row = image + 6 + 256 * 3 + rect->i16YMin * width;
+    for (int32_t y = rect->i16YMin; y <= rect->i16YMax; y++, row += width)
+    {
+        Span::fill8(row, rect->i16XMin, rect->i16XMax, value);
+    }
+}
+
+static void rectFill4(void* data, const tRectangle* rect, uint32_t value) {
+    uint8_t* image = (uint8_t*)data;
+    uint32_t stride = ((image[1] | (image[2] << 8)) + 1) / 2;
+    uint8_t* row = image + 6 + 16 * 3 + rect->i16YMin * stride;
+    for (int32_t y = rect->i16YMin; y <= rect->i16YMax; y++, row += stride)
+    {
+        Span::fill4(row, rect->i16XMin, rect->i16XMax, value);
+    }
+}
+
+// display index for an image palette entry, translated on first use
+static uint8_t lookup(void* data, const uint8_t* palette, uint32_t index) {
+    if (!(lutValid[index / 32] & (1u << (index % 32))))
+    {
+        const uint8_t* c = palette + index * 3;
+        colorTranslateFn translate = is8bpp((uint8_t*)data) ? translate8 : translate4;
+        lut[index] = translate(data, c[0] | (c[1] << 8) | (c[2] << 16));
+        lutValid[index / 32] |= 1u << (index % 32);
+    }
+    return lut[index];
+}
+
+static void pixelDrawMultiple(void* data, int32_t x, int32_t y, int32_t x0, int32_t count,
+                              int32_t bpp, const uint8_t* pixels, const uint8_t* palette) {
+    // translates up to SPAN_CHUNK pixels to display indices, then stores words
+    uint8_t* image = (uint8_t*)data;
+    uint8_t* row = rowOf(image, y);
+    uint8_t buf[SPAN_CHUNK];
+    int32_t s = ((bpp & 0xFF) == 8) ? 0 : x0;   // source pixel index
+
+    if ((bpp & 0xFF) != 1 &&
+        ((bpp & GRLIB_DRIVER_FLAG_NEW_IMAGE) || lutImage != data || lutPalette != palette))
+    {
+        lutImage = data;
+        lutPalette = palette;
+        memset(lutValid, 0, sizeof(lutValid));
+    }
+
+    while (count > 0)
+    {
+        int32_t n = (count < SPAN_CHUNK) ? count : SPAN_CHUNK;
+        switch (bpp & 0xFF)
+        {
+        case 1:
+        {
+            // palette holds the two already-translated colours
+            uint32_t colors[2];
+            memcpy(colors, palette, sizeof(colors));
+            uint32_t bg = (uint8_t)colors[0] * 0x01010101u;
+            uint32_t fg = (uint8_t)colors[1] * 0x01010101u;
+            int32_t i = 0;
+            for (; i < n && (s & 7); i++, s++)
+            {
+                buf[i] = colors[(pixels[s >> 3] >> (7 - (s & 7))) & 1];
+            }
+            for (; i + 8 <= n; i += 8, s += 8)
+            {
+                // a whole source byte: eight pixels as two words
+                uint32_t bits = pixels[s >> 3];
+                uint32_t m = expand[bits >> 4];
+                store32(buf + i, (fg & m) | (bg & ~m));
+                m = expand[bits & 15];
+                store32(buf + i + 4, (fg & m) | (bg & ~m));
+            }
+            for (; i < n; i++, s++)
+            {
+                buf[i] = colors[(pixels[s >> 3] >> (7 - (s & 7))) & 1];
+            }
+            break;
+        }
+        case 4:
+            for (int32_t i = 0; i < n; i++, s++)
+            {
+                buf[i] = lookup(data, palette, (pixels[s >> 1] >> ((~s & 1) * 4)) & 15);
+            }
+            break;
+        default:
+            for (int32_t i = 0; i < n; i++, s++)
+            {
+                buf[i] = lookup(data, palette, pixels[s]);
+            }
+            break;
+        }
+
+        if (is8bpp(image))
+        {
+            Span::copy8(row + x, buf, n);
+        }
+        else
+        {
+            unpacked4 src = { buf };
+            blit4<false>(row, x, src, 0, n, 0);
+        }
+        x += n;
+        count -= n;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Offscreen Displays
+//-----------------------------------------------------------------------------
+
+void Span::install(tDisplay* display) {
+    // call after GrOffScreen8BPPInit/4BPPInit; 1 bpp displays are left alone
+    uint8_t* image = (uint8_t*)display->pvDisplayData;
+    if (image[0] == IMAGE_FMT_8BPP_UNCOMP)
+        translate8 = display->pfnColorTranslate;
+    else if (image[0] == IMAGE_FMT_4BPP_UNCOMP)
+        translate4 = display->pfnColorTranslate;
+    else
+        return;
+
+    display->pfnPixelDrawMultiple = pixelDrawMultiple;
+    bool eight = (image[0] == IMAGE_FMT_8BPP_UNCOMP);
+    display->pfnLineDrawH = eight ? lineDrawH8 : lineDrawH4;
+    display->pfnRectFill = eight ? rectFill8 : rectFill4;
+    paletteChanged();
+}
+
+void Span::paletteChanged() {
+    // call after GrOffScreen8BPPPaletteSet/4BPPPaletteSet
+    lutImage = 0;
+}
+
+uint8_t* Span::row(const tDisplay* display, int32_t y) {
+    return rowOf((uint8_t*)display->pvDisplayData, y);
+}
+
+void Span::blit(const tDisplay* dst, int32_t x, int32_t y, const tDisplay* src, const tRectangle* rect, int32_t key) {
+    // copies rect of src to (x, y) on dst; same format, both already in bounds
+    int32_t width = rect->i16XMax - rect->i16XMin + 1;
+    bool eight = is8bpp((uint8_t*)dst->pvDisplayData);
+
+    for (int32_t r = rect->i16YMin; r <= rect->i16YMax; r++, y++)
+    {
+        uint8_t* to = row(dst, y);
+        const uint8_t* from = row(src, r);
+        if (eight)
+        {
+            if (key == SPAN_OPAQUE)
+                copy8(to + x, from + rect->i16XMin, width);
+            else
+                blitKey8(to + x, from + rect->i16XMin, width, key);
+        }
+        else
+        {
+            if (key == SPAN_OPAQUE)
+                copy4(to, x, from, rect->i16XMin, width);
+            else
+                blitKey4(to, x, from, rect->i16XMin, width, key);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <stdint.h>
+#include "grlib/grlib.h"
+
+//-----------------------------------------------------------------------------
+// Span Kernels
+//-----------------------------------------------------------------------------
+
+/// Fill, copy and colour-keyed blit of one row of an 8 bpp or 4 bpp offscreen
+/// buffer, 32 bits at a time. The bytes before the first word boundary and
+/// after the last are stored as a byte and a halfword, so a kernel never
+/// touches memory outside its span beyond the other nibble of a 4 bpp end
+/// byte, and buffers need no alignment or padding. Keyed blits skip source pixels equal to the
+/// key; on the Cortex-M4 the 8 bpp kernel picks per byte with UADD8/SEL.
+///
+/// install() points an offscreen display's LineDrawH, RectFill and
+/// PixelDrawMultiple at these kernels. PixelDrawMultiple also caches the
+/// translation of image palette entries to display indices, which grlib
+/// otherwise repeats for every pixel of a 4/8 bpp image; the cache is reset
+/// at each new image and by paletteChanged(). All drawing through installed
+/// displays must come from one task.
+
+#define SPAN_OPAQUE     -1      // blit() key: copy every pixel
+#define SPAN_CHUNK      64      // pixels translated per PixelDrawMultiple pass
+
+/// Class for span kernels
+class Span
+{
+public:
+    // one row; row points at pixel 0, x0..x1 inclusive
+    static void fill8(uint8_t* row, int32_t x0, int32_t x1, uint8_t index);
+    static void fill4(uint8_t* row, int32_t x0, int32_t x1, uint8_t index);
+    static void copy8(uint8_t* dst, const uint8_t* src, int32_t count);
+    static void copy4(uint8_t* dstRow, int32_t x, const uint8_t* srcRow, int32_t sx, int32_t count);
+    static void blitKey8(uint8_t* dst, const uint8_t* src, int32_t count, uint8_t key);
+    static void blitKey4(uint8_t* dstRow, int32_t x, const uint8_t* srcRow, int32_t sx, int32_t count, uint8_t key);
+
+    // offscreen displays
+    static void install(tDisplay* display);
+    static void paletteChanged();
+    static uint8_t* row(const tDisplay* display, int32_t y);
+    static void blit(const tDisplay* dst, int32_t x, int32_t y, const tDisplay* src, const tRectangle* rect, int32_t key);
+};
+
+#endif // SPAN_H
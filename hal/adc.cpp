@@ -0,0 +1,186 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "adc.h"
+#include "udma.h"
+#include "port.h"
+#include "rtos.h"
+#include "tm4c123gh6pm.h"
+
+#define DMA_CONTROL  (UDMA_PERIPH_TO_MEM_16 | UDMA_CHCTL_ARBSIZE_1 | UDMA_CHCTL_XFERMODE_PINGPONG)
+
+// Define variables
+static uint16_t samples[2][ADC_BLOCK_SAMPLES];
+static volatile uint32_t blocksDone;     // halves completed by the DMA
+static uint32_t blocksTaken;             // halves handed to the consumer
+static volatile uint8_t dmaActive;       // half the DMA is filling
+static uint8_t decimate = 1;
+static uint32_t lostBlocks;
+static volatile uint8_t waiter = NO_TASK;
+
+// analog inputs on port E (the others share pins with I2C3 and the LEDs)
+static const uint8_t ainPin[10] = { 0x08, 0x04, 0x02, 0x01, 0, 0, 0, 0, 0x20, 0x10 };
+
+static void arm(uint8_t half) {
+    Udma::setTransfer(UDMA_CH_ADC0SS0, half, DMA_CONTROL, &ADC0_SSFIFO0_R, samples[half], ADC_BLOCK_SAMPLES);
+}
+
+extern "C" void ADC0Seq0_Handler() {
+    ADC0_ISC_R = ADC_ISC_IN0;
+    UDMA_CHIS_R = 1u << UDMA_CH_ADC0SS0;
+
+    // re-arm each half that filled; the DMA has moved on to the other
+    while (Udma::remaining(UDMA_CH_ADC0SS0, dmaActive) == 0)
+    {
+        arm(dmaActive);
+        dmaActive ^= 1;
+        blocksDone++;
+    }
+
+    uint8_t task = waiter;
+    if (task != NO_TASK)
+    {
+        waiter = NO_TASK;
+        RTOS::notify(task);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// ADC Acquisition
+//-----------------------------------------------------------------------------
+
+bool Adc::init(uint8_t channel, uint32_t rate, uint8_t oversample, uint8_t decimation) {
+    // channel: AIN0..AIN3, AIN8, AIN9; oversample: 1..64, power of two, with
+    // oversample * rate at most 1 Msps; decimation divides ADC_BLOCK_SAMPLES
+    if (channel >= 10 || ainPin[channel] == 0 || rate == 0)
+        return false;
+    if (oversample == 0 || oversample > 64 || (oversample & (oversample - 1)) != 0)
+        return false;
+    if (decimation == 0 || ADC_BLOCK_SAMPLES % decimation != 0)
+        return false;
+
+    uint8_t averaging = 0;
+    while ((1 << averaging) < oversample)
+    {
+        averaging++;
+    }
+
+    decimate = decimation;
+    blocksDone = 0;
+    blocksTaken = 0;
+    dmaActive = 0;
+    lostBlocks = 0;
+
+    SYSCTL_RCGCADC_R   |= SYSCTL_RCGCADC_R0;        // turn-on ADC0
+    SYSCTL_RCGCTIMER_R |= SYSCTL_RCGCTIMER_R0;      // turn-on Timer 0
+    SYSCTL_RCGC2_R     |= SYSCTL_RCGC2_GPIOE;
+    (void)SYSCTL_RCGC2_R;
+
+    // analog function on the input pin
+    GPIO_PORTE_AFSEL_R |= ainPin[channel];
+    GPIO_PORTE_DEN_R   &= ~ainPin[channel];
+    GPIO_PORTE_AMSEL_R |= ainPin[channel];
+
+    // one-step sequence triggered by the timer; IE is what raises the DMA request
+    ADC0_ACTSS_R &= ~ADC_ACTSS_ASEN0;
+    ADC0_EMUX_R   = (ADC0_EMUX_R & ~0x0F) | ADC_EMUX_EM0_TIMER;
+    ADC0_SSMUX0_R = channel;
+    ADC0_SSCTL0_R = ADC_SSCTL0_END0 | ADC_SSCTL0_IE0;
+    ADC0_SAC_R    = averaging;
+    ADC0_IM_R    &= ~1;                             // no per-sample interrupt
+    ADC0_ISC_R    = ADC_ISC_IN0;
+
+    // Timer 0A periodic at the sample rate, trigger output to the ADC
+    TIMER0_CTL_R  = 0;
+    TIMER0_CFG_R  = TIMER_CFG_32_BIT_TIMER;
+    TIMER0_TAMR_R = TIMER_TAMR_TAMR_PERIOD;
+    TIMER0_TAILR_R = SYSTEM_CLOCK / rate - 1;
+
+    Udma::assign(UDMA_CH_ADC0SS0, 0);
+    UDMA_REQMASKCLR_R = 1u << UDMA_CH_ADC0SS0;
+    arm(0);
+    arm(1);
+
+    NVIC_EN0_R = 1 << 14;                           // turn-on interrupt 30 (ADC0 SS0)
+    return true;
+}
+
+void Adc::start() {
+    Udma::enable(UDMA_CH_ADC0SS0);
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0;
+    TIMER0_CTL_R = TIMER_CTL_TAEN | TIMER_CTL_TAOTE;
+}
+
+void Adc::stop() {
+    TIMER0_CTL_R = 0;
+    ADC0_ACTSS_R &= ~ADC_ACTSS_ASEN0;
+    Udma::disable(UDMA_CH_ADC0SS0);
+}
+
+uint32_t Adc::overruns() {
+    return lostBlocks;
+}
+
+bool Adc::waitBlock(adcBlock* block, uint32_t timeout) {
+    // blocks the consumer until the next half is full; the block must be
+    // processed before the DMA comes back around to it (one block time)
+    uint32_t start = tickCount;
+    while (blocksDone == blocksTaken)
+    {
+        uint32_t elapsed = tickCount - start;
+        if (timeout != WAIT_FOREVER && elapsed >= timeout)
+            return false;
+        waiter = taskCurrent;
+        if (blocksDone == blocksTaken)
+            RTOS::waitNotify(timeout == WAIT_FOREVER ? WAIT_FOREVER : timeout - elapsed);
+        waiter = NO_TASK;
+    }
+
+    // consumer fell behind: skip to the newest complete block
+    uint32_t done = blocksDone;
+    if (done - blocksTaken > 1)
+    {
+        lostBlocks += done - blocksTaken - 1;
+        blocksTaken = done - 1;
+    }
+
+    uint16_t* data = samples[blocksTaken % 2];
+    uint32_t count = ADC_BLOCK_SAMPLES;
+    if (decimate > 1)
+    {
+        // boxcar average in place; the output never overtakes the input
+        count = ADC_BLOCK_SAMPLES / decimate;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t sum = 0;
+            for (uint8_t j = 0; j < decimate; j++)
+            {
+                sum += data[i * decimate + j];
+            }
+            data[i] = sum / decimate;
+        }
+    }
+
+    block->samples = data;
+    block->count = count;
+    block->sequence = blocksTaken++;
+    return true;
+}
@@ -0,0 +1,59 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef ADC_H
+#define ADC_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// ADC Acquisition
+//-----------------------------------------------------------------------------
+
+/// Timer-triggered sampling on ADC0 sequencer 0 with no per-sample CPU work.
+///
+/// Timer 0A fires the sequencer at the sample rate, each conversion is
+/// optionally averaged in hardware (oversampling), and the uDMA ping-pongs
+/// the results into two block buffers. The ADC interrupt fires once per
+/// block and notifies the consumer task, which may further decimate the
+/// block by averaging groups of samples.
+
+#define ADC_BLOCK_SAMPLES   256    // samples per ping-pong half
+
+struct adcBlock
+{
+  const uint16_t* samples;   // decimated samples, valid until the next waitBlock()
+  uint32_t count;            // samples in the block
+  uint32_t sequence;         // running block number, gaps mean overruns
+};
+
+/// Class for ADC acquisition
+class Adc
+{
+public:
+    static bool init(uint8_t channel, uint32_t rate, uint8_t oversample, uint8_t decimation);
+    static void start();
+    static void stop();
+    static bool waitBlock(adcBlock* block, uint32_t timeout);
+    static uint32_t overruns();
+};
+
+#endif // ADC_H
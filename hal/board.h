@@ -0,0 +1,58 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include "gpio.h"
+
+//-----------------------------------------------------------------------------
+// EK-TM4C123GXL Pin Map
+//-----------------------------------------------------------------------------
+
+/// on-board LEDs and switches
+using RedLedB       = Pin<Port::F, 1, Dir::Output>;
+using BlueLedB      = Pin<Port::F, 2, Dir::Output>;
+using Sw1           = Pin<Port::F, 4, Dir::InputPullUp>;
+using Sw2           = Pin<Port::F, 0, Dir::InputPullUp>;
+
+/// PA0/PA1 carry UART0 and PA2..PA5 the SSI0 flash (see SpiFlash)
+
+/// external LEDs
+using OrangeLed     = Pin<Port::B, 4, Dir::Output>;
+using GreenLed      = Pin<Port::B, 5, Dir::Output>;
+using YellowLed     = Pin<Port::B, 6, Dir::Output>;
+using RedLed        = Pin<Port::B, 7, Dir::Output>;
+
+/// external push buttons
+using Pb0           = Pin<Port::C, 4, Dir::InputPullUp>;
+using Pb1           = Pin<Port::C, 5, Dir::InputPullUp>;
+using Pb2           = Pin<Port::C, 6, Dir::InputPullUp>;
+using Pb3           = Pin<Port::C, 7, Dir::InputPullUp>;
+
+/// SensHub BoosterPack motion sensor data-ready (see Imu)
+using ImuInt        = Pin<Port::B, 2, Dir::Input>;
+
+using BoardPins = PortConfig<RedLedB, BlueLedB, Sw1, Sw2,
+                             OrangeLed, GreenLed, YellowLed, RedLed,
+                             Pb0, Pb1, Pb2, Pb3, ImuInt>;
+
+#endif // BOARD_H
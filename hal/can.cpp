@@ -0,0 +1,352 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "can.h"
+#include "port.h"
+#include "rtos.h"
+#include "sync.h"
+#include "tm4c123gh6pm.h"
+
+#define CAN_TQ_PER_BIT  20      // 1 sync + 15 TSEG1 + 4 TSEG2, sample point at 80%
+#define CAN_IF_BUSY     CAN_IF1CRQ_BUSY
+
+// Define variables
+static canSubscriber* objectOwner[CAN_MAX_OBJECTS + 1];   // indexed by message object
+static uint8_t nextObject = CAN_FIRST_RX_OBJECT;
+static canFrame txQueue[CAN_TX_QUEUE_SIZE];               // sorted, highest priority first
+static uint8_t txCount;
+static volatile bool txBusy;                              // transmit object loaded
+static volatile uint8_t txWaiter = NO_TASK;
+static uint32_t busErrors;
+static mutex txLock;
+
+// arbitration order of an identifier: lower key wins the bus. The 11 base
+// bits compare first, and a standard frame beats an extended one with the
+// same base because its IDE bit is dominant.
+static uint32_t priority(uint32_t id) {
+    if (id & CAN_ID_EXTENDED)
+        return ((id >> 18) & 0x7FF) << 19 | 1u << 18 | (id & 0x3FFFF);
+    return (id & 0x7FF) << 19;
+}
+
+static void arbitration(uint32_t id, bool transmit, uint32_t* arb1, uint32_t* arb2) {
+    uint32_t dir = transmit ? CAN_IF1ARB2_DIR : 0;
+    if (id & CAN_ID_EXTENDED)
+    {
+        *arb1 = id & 0xFFFF;
+        *arb2 = CAN_IF1ARB2_MSGVAL | CAN_IF1ARB2_XTD | dir | ((id >> 16) & 0x1FFF);
+    }
+    else
+    {
+        *arb1 = 0;
+        *arb2 = CAN_IF1ARB2_MSGVAL | dir | ((id & 0x7FF) << 2);
+    }
+}
+
+// IF1 belongs to task context and the transmit path, IF2 to the receive ISR
+static void if1Write(uint8_t object) {
+    CAN0_IF1CRQ_R = object;
+    while (CAN0_IF1CRQ_R & CAN_IF_BUSY)
+    {
+    }
+}
+
+// load the head of the transmit queue into the transmit object;
+// caller has interrupts disabled
+static void txLoad() {
+    if (txCount == 0)
+    {
+        txBusy = false;
+        return;
+    }
+
+    const canFrame* f = &txQueue[0];
+    uint32_t arb1, arb2;
+    arbitration(f->id, true, &arb1, &arb2);
+    CAN0_IF1CMSK_R = CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_ARB | CAN_IF1CMSK_CONTROL
+                   | CAN_IF1CMSK_DATAA | CAN_IF1CMSK_DATAB;
+    CAN0_IF1MSK1_R = 0;
+    CAN0_IF1MSK2_R = 0;
+    CAN0_IF1ARB1_R = arb1;
+    CAN0_IF1ARB2_R = arb2;
+    CAN0_IF1MCTL_R = CAN_IF1MCTL_NEWDAT | CAN_IF1MCTL_TXIE | CAN_IF1MCTL_TXRQST
+                   | CAN_IF1MCTL_EOB | f->length;
+    CAN0_IF1DA1_R = f->data[0] | f->data[1] << 8;
+    CAN0_IF1DA2_R = f->data[2] | f->data[3] << 8;
+    CAN0_IF1DB1_R = f->data[4] | f->data[5] << 8;
+    CAN0_IF1DB2_R = f->data[6] | f->data[7] << 8;
+    if1Write(CAN_TX_OBJECT);
+
+    for (uint8_t i = 1; i < txCount; i++)
+    {
+        txQueue[i - 1] = txQueue[i];
+    }
+    txCount--;
+    txBusy = true;
+}
+
+static void receiveObject(uint8_t object) {
+    // read and release the object in one command
+    CAN0_IF2CMSK_R = CAN_IF1CMSK_ARB | CAN_IF1CMSK_CONTROL | CAN_IF1CMSK_CLRINTPND
+                   | CAN_IF1CMSK_NEWDAT | CAN_IF1CMSK_DATAA | CAN_IF1CMSK_DATAB;
+    CAN0_IF2CRQ_R = object;
+    while (CAN0_IF2CRQ_R & CAN_IF_BUSY)
+    {
+    }
+
+    uint32_t mctl = CAN0_IF2MCTL_R;
+    uint32_t arb2 = CAN0_IF2ARB2_R;
+    canSubscriber* sub = objectOwner[object];
+
+    if (mctl & CAN_IF1MCTL_MSGLST)
+    {
+        // the controller overwrote an unread frame; clear the flag
+        CAN0_IF2CMSK_R = CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_CONTROL;
+        CAN0_IF2MCTL_R = mctl & ~(CAN_IF1MCTL_MSGLST | CAN_IF1MCTL_NEWDAT | CAN_IF1MCTL_INTPND);
+        CAN0_IF2CRQ_R = object;
+        while (CAN0_IF2CRQ_R & CAN_IF_BUSY)
+        {
+        }
+        if (sub != 0)
+            sub->lost++;
+    }
+    if (sub == 0 || (mctl & CAN_IF1MCTL_NEWDAT) == 0)
+        return;
+
+    canFrame f;
+    f.timestamp = tickCount;
+    if (arb2 & CAN_IF1ARB2_XTD)
+        f.id = CAN_ID_EXTENDED | (arb2 & 0x1FFF) << 16 | CAN0_IF2ARB1_R;
+    else
+        f.id = (arb2 & 0x1FFF) >> 2;
+    f.length = mctl & CAN_IF1MCTL_DLC_M;
+    if (f.length > 8)
+        f.length = 8;
+
+    uint32_t data[4] = { CAN0_IF2DA1_R, CAN0_IF2DA2_R, CAN0_IF2DB1_R, CAN0_IF2DB2_R };
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        f.data[i] = data[i >> 1] >> ((i & 1) * 8);
+    }
+
+    if (!StreamBuffer::send(&sub->queue, &f, sizeof(f)))
+        sub->dropped++;
+}
+
+extern "C" void CAN0_Handler() {
+    // INT reports the lowest-numbered pending object first, which keeps
+    // the objects of a FIFO chain in arrival order
+    uint32_t source;
+    while ((source = CAN0_INT_R & 0xFFFF) != 0)
+    {
+        if (source == CAN_INT_INTID_STATUS)
+        {
+            uint32_t status = CAN0_STS_R;           // reading clears the interrupt
+            CAN0_STS_R = CAN_STS_LEC_NOEVENT;
+            busErrors++;
+            if (status & CAN_STS_BOFF)
+                CAN0_CTL_R &= ~CAN_CTL_INIT;        // start bus-off recovery
+        }
+        else if (source == CAN_TX_OBJECT)
+        {
+            CAN0_IF2CMSK_R = CAN_IF1CMSK_CLRINTPND;
+            CAN0_IF2CRQ_R = source;
+            while (CAN0_IF2CRQ_R & CAN_IF_BUSY)
+            {
+            }
+            txLoad();
+            uint8_t task = txWaiter;
+            if (task != NO_TASK)
+            {
+                txWaiter = NO_TASK;
+                RTOS::notify(task);
+            }
+        }
+        else
+        {
+            receiveObject(source);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// CAN Driver
+//-----------------------------------------------------------------------------
+
+bool Can::init(uint32_t bitRate, bool loopback) {
+    // bitRate must divide SYSTEM_CLOCK / 20 into 1..64 quanta prescaler
+    // (40 MHz: 1 Mbit/s, 500k, 250k, 125k, ...); loopback routes TX to RX
+    // internally so the driver runs without a bus or transceiver
+    if (bitRate == 0 || SYSTEM_CLOCK % (bitRate * CAN_TQ_PER_BIT) != 0)
+        return false;
+    uint32_t prescaler = SYSTEM_CLOCK / (bitRate * CAN_TQ_PER_BIT);
+    if (prescaler == 0 || prescaler > 64)
+        return false;
+
+    Mutex::init(&txLock);
+    for (uint8_t i = 0; i <= CAN_MAX_OBJECTS; i++)
+    {
+        objectOwner[i] = 0;
+    }
+    nextObject = CAN_FIRST_RX_OBJECT;
+    txCount = 0;
+    txBusy = false;
+    busErrors = 0;
+
+    SYSCTL_RCGCCAN_R |= SYSCTL_RCGCCAN_R0;
+    SYSCTL_RCGC2_R   |= SYSCTL_RCGC2_GPIOE;
+    (void)SYSCTL_RCGC2_R;
+
+    // PE4 = CAN0RX, PE5 = CAN0TX
+    GPIO_PORTE_AFSEL_R |= 0x30;
+    GPIO_PORTE_PCTL_R   = (GPIO_PORTE_PCTL_R & ~0x00FF0000) | GPIO_PCTL_PE4_CAN0RX | GPIO_PCTL_PE5_CAN0TX;
+    GPIO_PORTE_AMSEL_R &= ~0x30;
+    GPIO_PORTE_DEN_R   |= 0x30;
+
+    CAN0_CTL_R = CAN_CTL_INIT | CAN_CTL_CCE;
+    CAN0_BIT_R = (prescaler - 1) | (3 << 6) | (14 << 8) | (3 << 12);   // SJW 4, TSEG1 15, TSEG2 4
+    CAN0_BRPE_R = 0;
+
+    // invalidate every message object
+    CAN0_IF1CMSK_R = CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_ARB | CAN_IF1CMSK_CONTROL;
+    CAN0_IF1ARB1_R = 0;
+    CAN0_IF1ARB2_R = 0;
+    CAN0_IF1MCTL_R = 0;
+    for (uint8_t i = 1; i <= CAN_MAX_OBJECTS; i++)
+    {
+        if1Write(i);
+    }
+
+    uint32_t ctl = CAN_CTL_IE | CAN_CTL_EIE;
+    if (loopback)
+    {
+        CAN0_CTL_R |= CAN_CTL_TEST;
+        CAN0_TST_R = CAN_TST_LBACK;
+        ctl |= CAN_CTL_TEST;
+    }
+
+    NVIC_EN1_R = 1 << 7;                        // turn-on interrupt 55 (CAN0)
+    CAN0_CTL_R = ctl;                           // leave init, join the bus
+    return true;
+}
+
+bool Can::subscribe(canSubscriber* sub, uint32_t id, uint32_t mask, uint8_t depth,
+                    uint8_t* buf, uint32_t size) {
+    // frames whose id matches on the bits set in mask are delivered to sub;
+    // depth objects are chained into a hardware FIFO for high-rate ids.
+    // buf/size back the subscriber's stream buffer (24 bytes per frame)
+    if (depth == 0 || nextObject + depth - 1 > CAN_MAX_OBJECTS)
+        return false;
+    if (!StreamBuffer::init(&sub->queue, buf, size, 1))
+        return false;
+
+    sub->firstObject = nextObject;
+    sub->lastObject = nextObject + depth - 1;
+    sub->dropped = 0;
+    sub->lost = 0;
+    nextObject += depth;
+
+    uint32_t arb1, arb2, msk1, msk2;
+    arbitration(id, false, &arb1, &arb2);
+    if (id & CAN_ID_EXTENDED)
+    {
+        msk1 = mask & 0xFFFF;
+        msk2 = (mask >> 16) & 0x1FFF;
+    }
+    else
+    {
+        msk1 = 0;
+        msk2 = (mask & 0x7FF) << 2;
+    }
+    // always match on IDE and direction so standard filters never see
+    // extended frames and remote requests stay out of the queues
+    msk2 |= CAN_IF1MSK2_MXTD | CAN_IF1MSK2_MDIR;
+
+    for (uint8_t object = sub->firstObject; object <= sub->lastObject; object++)
+    {
+        uint32_t eob = object == sub->lastObject ? CAN_IF1MCTL_EOB : 0;
+        uint32_t primask = disableInterrupts();
+        objectOwner[object] = sub;
+        CAN0_IF1CMSK_R = CAN_IF1CMSK_WRNRD | CAN_IF1CMSK_MASK | CAN_IF1CMSK_ARB | CAN_IF1CMSK_CONTROL;
+        CAN0_IF1MSK1_R = msk1;
+        CAN0_IF1MSK2_R = msk2;
+        CAN0_IF1ARB1_R = arb1;
+        CAN0_IF1ARB2_R = arb2;
+        CAN0_IF1MCTL_R = CAN_IF1MCTL_UMASK | CAN_IF1MCTL_RXIE | eob | 8;
+        if1Write(object);
+        restoreInterrupts(primask);
+    }
+    return true;
+}
+
+bool Can::receive(canSubscriber* sub, canFrame* frame, uint32_t timeout) {
+    // one reader task per subscriber
+    return StreamBuffer::receive(&sub->queue, frame, sizeof(*frame), timeout) == sizeof(*frame);
+}
+
+bool Can::send(const canFrame* frame, uint32_t timeout) {
+    // queues the frame behind any of higher priority; waits for room while
+    // the queue is full; returns false on timeout
+    if (frame->length > 8)
+        return false;
+
+    uint32_t key = priority(frame->id);
+    uint32_t start = tickCount;
+    bool queued = false;
+
+    Mutex::lock(&txLock);
+    for (;;)
+    {
+        uint32_t primask = disableInterrupts();
+        if (txCount < CAN_TX_QUEUE_SIZE)
+        {
+            // insert after frames of equal priority to keep their order
+            uint8_t i = txCount;
+            while (i > 0 && priority(txQueue[i - 1].id) > key)
+            {
+                txQueue[i] = txQueue[i - 1];
+                i--;
+            }
+            txQueue[i] = *frame;
+            txCount++;
+            if (!txBusy)
+                txLoad();
+            queued = true;
+        }
+        else
+        {
+            txWaiter = taskCurrent;
+        }
+        restoreInterrupts(primask);
+
+        uint32_t elapsed = tickCount - start;
+        if (queued || timeout == NO_WAIT || (timeout != WAIT_FOREVER && elapsed >= timeout))
+            break;
+        RTOS::waitNotify(timeout == WAIT_FOREVER ? WAIT_FOREVER : timeout - elapsed);
+    }
+    txWaiter = NO_TASK;
+    Mutex::unlock(&txLock);
+    return queued;
+}
+
+uint32_t Can::errors() {
+    return busErrors;
+}
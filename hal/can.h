@@ -0,0 +1,79 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef CAN_H
+#define CAN_H
+
+#include <stdint.h>
+#include "streambuf.h"
+
+//-----------------------------------------------------------------------------
+// CAN Bus
+//-----------------------------------------------------------------------------
+
+/// CAN0 on PE4 (RX) / PE5 (TX) with acceptance filtering done in hardware.
+///
+/// Message object 1 transmits; objects 2..32 are handed out to subscribers.
+/// Each subscriber gets an ID/mask filter on one or more consecutive objects;
+/// with more than one, the objects form a hardware FIFO (EOB on the last) so
+/// a burst of a high-rate ID is absorbed while the ISR is still running.
+///
+/// The ISR copies every received frame, stamped with the kernel tick, into
+/// the subscriber's stream buffer and wakes its reader. Frames to send wait
+/// in a queue sorted by CAN ID, so the lowest ID (highest bus priority)
+/// always goes out next, as it would win arbitration anyway.
+
+#define CAN_TX_OBJECT       1      // message object used for transmit
+#define CAN_FIRST_RX_OBJECT 2
+#define CAN_MAX_OBJECTS     32
+#define CAN_TX_QUEUE_SIZE   16     // frames waiting for the transmit object
+#define CAN_ID_EXTENDED     0x80000000   // OR into id/filter for 29-bit IDs
+
+struct canFrame
+{
+  uint32_t id;          // 11 or 29 bit identifier, CAN_ID_EXTENDED for 29 bit
+  uint32_t timestamp;   // tickCount when received
+  uint8_t length;       // 0..8
+  uint8_t data[8];
+};
+
+struct canSubscriber
+{
+  streamBuffer queue;   // received frames, one record each
+  uint8_t firstObject;  // message objects owned by this subscriber
+  uint8_t lastObject;
+  uint32_t dropped;     // frames lost because the queue was full
+  uint32_t lost;        // frames overwritten in hardware (MSGLST)
+};
+
+/// Class for the CAN controller
+class Can
+{
+public:
+    static bool init(uint32_t bitRate, bool loopback);
+    static bool subscribe(canSubscriber* sub, uint32_t id, uint32_t mask, uint8_t depth,
+                          uint8_t* buf, uint32_t size);
+    static bool receive(canSubscriber* sub, canFrame* frame, uint32_t timeout);
+    static bool send(const canFrame* frame, uint32_t timeout);
+    static uint32_t errors();
+};
+
+#endif // CAN_H
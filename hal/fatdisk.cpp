@@ -0,0 +1,280 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "fatdisk.h"
+#include "sdcard.h"
+#include "rtos.h"
+#include "sync.h"
+#include "ff.h"
+#include "diskio.h"
+
+#define NO_SECTOR   0xFFFFFFFF
+
+struct cacheSector
+{
+  uint32_t sector;          // card sector, or NO_SECTOR
+  uint32_t lastUse;         // LRU stamp
+  bool dirty;
+  uint8_t data[SDCARD_BLOCK_SIZE];
+};
+
+// Define variables
+static cacheSector cache[FATDISK_CACHE_SECTORS];
+static uint32_t useCounter;
+static fatDiskStats counters;
+static volatile DSTATUS diskStatus = STA_NOINIT;
+static mutex volumeLock[_VOLUMES];
+
+static cacheSector* lookup(uint32_t sector) {
+    for (uint8_t i = 0; i < FATDISK_CACHE_SECTORS; i++)
+    {
+        if (cache[i].sector == sector)
+        {
+            cache[i].lastUse = ++useCounter;
+            return &cache[i];
+        }
+    }
+    return 0;
+}
+
+static void invalidate() {
+    for (uint8_t i = 0; i < FATDISK_CACHE_SECTORS; i++)
+    {
+        cache[i].sector = NO_SECTOR;
+        cache[i].lastUse = 0;
+        cache[i].dirty = false;
+    }
+    useCounter = 0;
+}
+
+// write every dirty sector, lowest first, one multi-block write per run
+static bool writeBack() {
+    bool ok = true;
+    for (;;)
+    {
+        cacheSector* first = 0;
+        for (uint8_t i = 0; i < FATDISK_CACHE_SECTORS; i++)
+        {
+            if (cache[i].dirty && (first == 0 || cache[i].sector < first->sector))
+                first = &cache[i];
+        }
+        if (first == 0)
+            return ok;
+
+        cacheSector* run[FATDISK_CACHE_SECTORS];
+        uint8_t count = 0;
+        for (cacheSector* c = first; c != 0 && c->dirty; c = lookup(first->sector + count))
+        {
+            run[count++] = c;
+        }
+
+        bool written = SdCard::beginWrite(first->sector, count);
+        for (uint8_t i = 0; i < count; i++)
+        {
+            written = written && SdCard::writeNext(run[i]->data);
+        }
+        written = SdCard::endWrite() && written;
+        counters.writeBacks++;
+
+        // clear dirty either way so a failing card cannot wedge the loop
+        for (uint8_t i = 0; i < count; i++)
+        {
+            run[i]->dirty = false;
+        }
+        ok = ok && written;
+    }
+}
+
+// claim the least recently used slot, flushing dirty sectors if it is one
+static cacheSector* claim(uint32_t sector) {
+    cacheSector* v = &cache[0];
+    for (uint8_t i = 1; i < FATDISK_CACHE_SECTORS && v->sector != NO_SECTOR; i++)
+    {
+        if (cache[i].sector == NO_SECTOR || cache[i].lastUse < v->lastUse)
+            v = &cache[i];
+    }
+    if (v->dirty)
+        writeBack();
+    v->sector = sector;
+    v->lastUse = ++useCounter;
+    v->dirty = false;
+    return v;
+}
+
+static bool dirtyInRange(uint32_t sector, uint32_t count) {
+    for (uint8_t i = 0; i < FATDISK_CACHE_SECTORS; i++)
+    {
+        if (cache[i].dirty && cache[i].sector - sector < count)
+            return true;
+    }
+    return false;
+}
+
+static void copy(uint8_t* dst, const uint8_t* src) {
+    // both may be unaligned; FatFs hands out byte buffers
+    for (uint32_t i = 0; i < SDCARD_BLOCK_SIZE; i++)
+    {
+        dst[i] = src[i];
+    }
+}
+
+//-----------------------------------------------------------------------------
+// FatFs disk interface
+//-----------------------------------------------------------------------------
+
+extern "C" DSTATUS disk_initialize(BYTE pdrv) {
+    if (pdrv != 0)
+        return STA_NOINIT;
+    invalidate();
+    diskStatus = SdCard::init() ? 0 : STA_NOINIT;
+    return diskStatus;
+}
+
+extern "C" DSTATUS disk_status(BYTE pdrv) {
+    return (pdrv != 0) ? STA_NOINIT : diskStatus;
+}
+
+extern "C" DRESULT disk_read(BYTE pdrv, BYTE* buff, DWORD sector, BYTE count) {
+    if (pdrv != 0 || count == 0)
+        return RES_PARERR;
+    if (diskStatus & STA_NOINIT)
+        return RES_NOTRDY;
+
+    if (count == 1)
+    {
+        cacheSector* c = lookup(sector);
+        if (c != 0)
+        {
+            counters.hits++;
+        }
+        else
+        {
+            counters.misses++;
+            c = claim(sector);
+            if (!SdCard::readBlocks(sector, c->data, 1))
+            {
+                c->sector = NO_SECTOR;
+                return RES_ERROR;
+            }
+        }
+        copy(buff, c->data);
+        return RES_OK;
+    }
+
+    // the card must see cached writes before a direct read of the range
+    if (dirtyInRange(sector, count) && !writeBack())
+        return RES_ERROR;
+    return SdCard::readBlocks(sector, buff, count) ? RES_OK : RES_ERROR;
+}
+
+extern "C" DRESULT disk_write(BYTE pdrv, const BYTE* buff, DWORD sector, BYTE count) {
+    if (pdrv != 0 || count == 0)
+        return RES_PARERR;
+    if (diskStatus & STA_NOINIT)
+        return RES_NOTRDY;
+
+    if (count == 1)
+    {
+        // whole sector overwritten, so a miss needs no read
+        cacheSector* c = lookup(sector);
+        if (c == 0)
+            c = claim(sector);
+        copy(c->data, buff);
+        c->dirty = true;
+        return RES_OK;
+    }
+
+    // cached copies in the range are superseded
+    for (uint8_t i = 0; i < FATDISK_CACHE_SECTORS; i++)
+    {
+        if (cache[i].sector - sector < count)
+        {
+            cache[i].sector = NO_SECTOR;
+            cache[i].dirty = false;
+        }
+    }
+    return SdCard::writeBlocks(sector, buff, count) ? RES_OK : RES_ERROR;
+}
+
+extern "C" DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
+    if (pdrv != 0)
+        return RES_PARERR;
+    if (diskStatus & STA_NOINIT)
+        return RES_NOTRDY;
+
+    switch (cmd)
+    {
+    case CTRL_SYNC:
+        return writeBack() ? RES_OK : RES_ERROR;
+    case GET_SECTOR_COUNT:
+        *(DWORD*)buff = SdCard::sectors();
+        return RES_OK;
+    case GET_SECTOR_SIZE:
+        *(WORD*)buff = SDCARD_BLOCK_SIZE;
+        return RES_OK;
+    case GET_BLOCK_SIZE:
+        *(DWORD*)buff = 1;          // erase block size unknown
+        return RES_OK;
+    case MMC_GET_TYPE:
+        *(BYTE*)buff = SdCard::type();
+        return RES_OK;
+    default:
+        return RES_PARERR;
+    }
+}
+
+extern "C" DWORD get_fattime(void) {
+    // no RTC: 2025-01-01 00:00:00
+    return ((DWORD)(2025 - 1980) << 25) | ((DWORD)1 << 21) | ((DWORD)1 << 16);
+}
+
+//-----------------------------------------------------------------------------
+// FatFs sync hooks
+//-----------------------------------------------------------------------------
+
+extern "C" int ff_cre_syncobj(BYTE vol, _SYNC_t* sobj) {
+    Mutex::init(&volumeLock[vol]);
+    *sobj = &volumeLock[vol];
+    return 1;
+}
+
+extern "C" int ff_req_grant(_SYNC_t sobj) {
+    // blocks without the _FS_TIMEOUT limit so priority inheritance applies
+    Mutex::lock((mutex*)sobj);
+    return 1;
+}
+
+extern "C" void ff_rel_grant(_SYNC_t sobj) {
+    Mutex::unlock((mutex*)sobj);
+}
+
+extern "C" int ff_del_syncobj(_SYNC_t sobj) {
+    (void)sobj;
+    return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FatFs Disk Glue
+//-----------------------------------------------------------------------------
+
+void FatDisk::stats(fatDiskStats* s) {
+    *s = counters;
+}
@@ -0,0 +1,63 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef FATDISK_H
+#define FATDISK_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// FatFs Disk Glue
+//-----------------------------------------------------------------------------
+
+/// Implements the FatFs disk_* and ff_*_syncobj hooks on the SD card and
+/// kernel mutexes (ffconf.h: _FS_REENTRANT 1, _SYNC_t void*).
+///
+/// Single-sector accesses, which is how FatFs touches FAT and directory
+/// sectors, go through a write-back LRU sector cache. Dirty sectors are
+/// written on CTRL_SYNC (f_sync/f_close) or when one is evicted, sorted and
+/// merged so consecutive sectors go out in one multi-block write.
+/// Multi-sector accesses, i.e. whole-cluster file data, bypass the cache and
+/// stream straight between the caller's buffer and the card.
+///
+/// For long files, open with fast seek (_USE_FASTSEEK 1): build the cluster
+/// link map once with f_lseek(fp, CREATE_LINKMAP) and seeks no longer walk
+/// the FAT.
+
+#ifndef FATDISK_CACHE_SECTORS
+#define FATDISK_CACHE_SECTORS   8       // 512 bytes of SRAM each
+#endif
+
+struct fatDiskStats
+{
+  uint32_t hits;            // single-sector reads served from the cache
+  uint32_t misses;
+  uint32_t writeBacks;      // multi-block writes issued to flush dirty sectors
+};
+
+/// Class for FatFs disk glue
+class FatDisk
+{
+public:
+    static void stats(fatDiskStats* s);
+};
+
+#endif // FATDISK_H
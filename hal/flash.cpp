@@ -0,0 +1,68 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "flash.h"
+#include "tm4c123gh6pm.h"
+
+#define FLASH_ERRORS    (FLASH_FCRIS_ARIS | FLASH_FCRIS_VOLTRIS | FLASH_FCRIS_INVDRIS | FLASH_FCRIS_PROGRIS | FLASH_FCRIS_ERRIS)
+
+//-----------------------------------------------------------------------------
+// Internal Flash
+//-----------------------------------------------------------------------------
+
+bool Flash::erase(uint32_t address) {
+    // address is rounded down to its 1 KB page
+    FLASH_FCMISC_R = FLASH_ERRORS;
+    FLASH_FMA_R = address & ~(FLASH_PAGE_SIZE - 1);
+    FLASH_FMC_R = FLASH_FMC_WRKEY | FLASH_FMC_ERASE;
+    while (FLASH_FMC_R & FLASH_FMC_ERASE)
+    {
+    }
+    return (FLASH_FCRIS_R & FLASH_ERRORS) == 0;
+}
+
+bool Flash::program(uint32_t address, const uint32_t* data, uint32_t count) {
+    // address word aligned; the area should be erased
+    FLASH_FCMISC_R = FLASH_ERRORS;
+    while (count > 0)
+    {
+        // fill the buffer up to the end of the current 32-word block
+        uint32_t block = address & ~(FLASH_BUFFER_SIZE - 1);
+        uint32_t first = (address - block) / 4;
+        uint32_t n = 0;
+        while (first + n < FLASH_BUFFER_SIZE / 4 && n < count)
+        {
+            (&FLASH_FWBN_R)[first + n] = data[n];
+            n++;
+        }
+
+        FLASH_FMA_R = block;
+        FLASH_FMC2_R = FLASH_FMC_WRKEY | FLASH_FMC2_WRBUF;
+        while (FLASH_FMC2_R & FLASH_FMC2_WRBUF)
+        {
+        }
+
+        address += n * 4;
+        data += n;
+        count -= n;
+    }
+    return (FLASH_FCRIS_R & FLASH_ERRORS) == 0;
+}
@@ -0,0 +1,48 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef FLASH_H
+#define FLASH_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Internal Flash
+//-----------------------------------------------------------------------------
+
+/// Erase and program of the on-chip flash. Erase works on 1 KB pages;
+/// programming goes through the 32-word write buffer, so a run of words
+/// inside one 128-byte block costs a single program cycle. As with any NOR
+/// flash, programming only clears bits. Code keeps running from flash; the
+/// CPU just stalls on fetches while an operation is in progress.
+
+#define FLASH_PAGE_SIZE     1024
+#define FLASH_BUFFER_SIZE   128     // bytes covered by the write buffer
+
+/// Class for internal flash
+class Flash
+{
+public:
+    static bool erase(uint32_t address);
+    static bool program(uint32_t address, const uint32_t* data, uint32_t count);
+};
+
+#endif // FLASH_H
@@ -0,0 +1,171 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+//-----------------------------------------------------------------------------
+// Typed GPIO Pins
+//-----------------------------------------------------------------------------
+
+/// Pin<Port, N, Dir> resolves the bit-band alias of a GPIO data bit at compile
+/// time, so set/clear/write/read each compile to a single load or store.
+/// PortConfig<Pins...> derives the DIR/DR2R/PUR/DEN values of every port from
+/// a list of pins and rejects pins that are configured twice.
+
+/// GPIO ports on the APB aperture
+enum class Port : uint32_t
+{
+    A = 0x40004000,
+    B = 0x40005000,
+    C = 0x40006000,
+    D = 0x40007000,
+    E = 0x40024000,
+    F = 0x40025000,
+};
+
+enum class Dir : uint8_t
+{
+    Input,          // digital input
+    InputPullUp,    // digital input with internal pull-up (push buttons)
+    Output,         // digital output, 2mA drive
+};
+
+/// GPIO register offsets
+#define GPIO_OFFSET_DATA   0x3FC    // data register with all address mask bits set
+#define GPIO_OFFSET_DIR    0x400
+#define GPIO_OFFSET_DR2R   0x500
+#define GPIO_OFFSET_PUR    0x510
+#define GPIO_OFFSET_DEN    0x51C
+#define GPIO_OFFSET_LOCK   0x520
+#define GPIO_OFFSET_CR     0x524
+
+constexpr uint32_t bitBandAlias(uint32_t address, uint8_t bit) {
+    return 0x42000000 + (address - 0x40000000) * 32 + bit * 4;
+}
+
+template <Port P, uint8_t N, Dir D>
+struct Pin
+{
+    static_assert(N < 8, "GPIO ports have 8 pins");
+
+    static constexpr Port port = P;
+    static constexpr uint8_t pin = N;
+    static constexpr Dir dir = D;
+    static constexpr uint8_t mask = 1 << N;
+    static constexpr uint32_t alias = bitBandAlias((uint32_t)P + GPIO_OFFSET_DATA, N);
+
+    static inline volatile uint32_t& bit() {
+        return *reinterpret_cast<volatile uint32_t*>(alias);
+    }
+
+    static inline void set() {
+        static_assert(D == Dir::Output, "pin is not an output");
+        bit() = 1;
+    }
+
+    static inline void clear() {
+        static_assert(D == Dir::Output, "pin is not an output");
+        bit() = 0;
+    }
+
+    static inline void write(uint32_t value) {
+        static_assert(D == Dir::Output, "pin is not an output");
+        bit() = value;
+    }
+
+    static inline void toggle() {
+        static_assert(D == Dir::Output, "pin is not an output");
+        bit() ^= 1;
+    }
+
+    static inline uint32_t read() {
+        return bit();
+    }
+};
+
+template <typename... Pins>
+struct PortConfig
+{
+    // number of entries in the table naming the same port and pin as Q
+    template <typename Q>
+    static constexpr int occurrences() {
+        return ((Pins::port == Q::port && Pins::pin == Q::pin ? 1 : 0) + ... + 0);
+    }
+
+    static_assert(((occurrences<Pins>() == 1) && ...), "GPIO pin configured more than once");
+
+    static constexpr uint8_t pins(Port p) {
+        return ((Pins::port == p ? Pins::mask : 0) | ... | 0);
+    }
+
+    static constexpr uint8_t outputs(Port p) {
+        return ((Pins::port == p && Pins::dir == Dir::Output ? Pins::mask : 0) | ... | 0);
+    }
+
+    static constexpr uint8_t pullUps(Port p) {
+        return ((Pins::port == p && Pins::dir == Dir::InputPullUp ? Pins::mask : 0) | ... | 0);
+    }
+
+    // RCGC2 clock gate bits for every port in the table
+    static constexpr uint32_t clocks() {
+        return (pins(Port::A) ? SYSCTL_RCGC2_GPIOA : 0) | (pins(Port::B) ? SYSCTL_RCGC2_GPIOB : 0) |
+               (pins(Port::C) ? SYSCTL_RCGC2_GPIOC : 0) | (pins(Port::D) ? SYSCTL_RCGC2_GPIOD : 0) |
+               (pins(Port::E) ? SYSCTL_RCGC2_GPIOE : 0) | (pins(Port::F) ? SYSCTL_RCGC2_GPIOF : 0);
+    }
+
+    template <Port P>
+    static inline void applyPort() {
+        if constexpr (pins(P) != 0)
+        {
+            volatile uint32_t* base = reinterpret_cast<volatile uint32_t*>((uint32_t)P);
+            // PD7 and PF0 are locked after reset; unlock them if the table uses them
+            constexpr uint8_t locked = (P == Port::D ? 0x80 : 0) | (P == Port::F ? 0x01 : 0);
+            if constexpr ((pins(P) & locked) != 0)
+            {
+                base[GPIO_OFFSET_LOCK / 4] = GPIO_LOCK_KEY;
+                base[GPIO_OFFSET_CR / 4] |= locked;
+                base[GPIO_OFFSET_LOCK / 4] = 0;
+            }
+            base[GPIO_OFFSET_DIR / 4]  = outputs(P);
+            base[GPIO_OFFSET_DR2R / 4] = outputs(P);
+            base[GPIO_OFFSET_PUR / 4]  = pullUps(P);
+            base[GPIO_OFFSET_DEN / 4]  = pins(P);
+        }
+    }
+
+    // configure every port named in the table (clocks, direction, pull-ups)
+    static void apply() {
+        SYSCTL_RCGC2_R |= clocks();
+        (void)SYSCTL_RCGC2_R;   // read back: a few clocks must pass before port access
+        applyPort<Port::A>();
+        applyPort<Port::B>();
+        applyPort<Port::C>();
+        applyPort<Port::D>();
+        applyPort<Port::E>();
+        applyPort<Port::F>();
+    }
+};
+
+#endif // GPIO_H
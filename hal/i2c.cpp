@@ -0,0 +1,304 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "i2c.h"
+#include "port.h"
+#include "rtos.h"
+#include "tm4c123gh6pm.h"
+
+#define I2C_MAX_WRITE   32    // register address + payload for writeRegisters()
+
+// Define variables
+static i2cRequest* pending = 0;        // sorted by priority
+static i2cRequest* active = 0;         // request on the bus
+static uint8_t step;                   // transaction index within active
+static uint16_t position;              // byte index within the current phase
+static bool reading;                   // current phase is the read
+static bool stopping;                  // bus not yet free after a failed or timed-out request
+
+// sensorlib-style status from a failed MCS
+static uint8_t errorStatus(uint32_t mcs) {
+    if (mcs & I2C_MCS_ARBLST)
+        return I2C_STATUS_ARB_LOST;
+    if (mcs & I2C_MCS_ADRACK)
+        return I2C_STATUS_ADDR_NACK;
+    if (mcs & I2C_MCS_DATACK)
+        return I2C_STATUS_DATA_NACK;
+    return I2C_STATUS_ERROR;
+}
+
+// begin the read phase of the current transaction (START or repeated START)
+static void startRead(i2cTransaction* t) {
+    reading = true;
+    position = 0;
+    I2C3_MSA_R = (t->address << 1) | 1;
+    if (t->readLength == 1)
+        I2C3_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
+    else
+        I2C3_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_ACK;
+}
+
+// begin transaction number step of the active request
+static void startTransaction() {
+    i2cTransaction* t = &active->transactions[step];
+    if (t->writeLength == 0)
+    {
+        startRead(t);
+        return;
+    }
+    reading = false;
+    position = 1;
+    I2C3_MSA_R = t->address << 1;
+    I2C3_MDR_R = t->writeData[0];
+    if (t->writeLength == 1 && t->readLength == 0)
+        I2C3_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
+    else
+        I2C3_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
+}
+
+// take the next request off the pending list if the bus is free;
+// caller masks interrupts
+static void startNext() {
+    if (active != 0 || pending == 0)
+        return;
+    if (stopping)
+    {
+        // normally the STOP's completion interrupt restarts the queue, or
+        // the tick poll once another master has released the bus
+        if (I2C3_MCS_R & I2C_MCS_BUSBSY)
+            return;
+        stopping = false;
+        // a completion still on its way belongs to the STOP, not to us
+        I2C3_MICR_R = I2C_MICR_IC;
+        NVIC_UNPEND2_R = 1 << 5;
+    }
+    active = pending;
+    pending = pending->next;
+    step = 0;
+    startTransaction();
+}
+
+// finish the active request and move on
+static void complete(uint8_t status) {
+    i2cRequest* done = active;
+    active = 0;
+    done->status = status;
+    if (done->callback != 0)
+        done->callback(done->callbackData, status);
+    startNext();
+}
+
+extern "C" void I2C3_Handler() {
+    I2C3_MICR_R = I2C_MICR_IC;
+    if (active == 0)
+    {
+        // a failed or timed-out request's STOP has gone out; the bus is ours again
+        stopping = false;
+        startNext();
+        return;
+    }
+
+    uint32_t mcs = I2C3_MCS_R;
+    i2cTransaction* t = &active->transactions[step];
+
+    if (mcs & (I2C_MCS_ERROR | I2C_MCS_ARBLST))
+    {
+        // the controller stops by itself on arbitration loss, otherwise we
+        // must; either way the next START waits for the bus to be free
+        if (!(mcs & I2C_MCS_ARBLST))
+            I2C3_MCS_R = I2C_MCS_STOP;
+        stopping = true;
+        complete(errorStatus(mcs));
+        return;
+    }
+
+    if (!reading)
+    {
+        if (position < t->writeLength)
+        {
+            I2C3_MDR_R = t->writeData[position++];
+            if (position == t->writeLength && t->readLength == 0)
+                I2C3_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
+            else
+                I2C3_MCS_R = I2C_MCS_RUN;
+            return;
+        }
+        if (t->readLength != 0)
+        {
+            startRead(t);
+            return;
+        }
+    }
+    else
+    {
+        t->readData[position++] = I2C3_MDR_R;
+        if (position < t->readLength)
+        {
+            if (position == t->readLength - 1)
+                I2C3_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
+            else
+                I2C3_MCS_R = I2C_MCS_RUN | I2C_MCS_ACK;
+            return;
+        }
+    }
+
+    // transaction finished with a STOP
+    if (++step < active->count)
+        startTransaction();
+    else
+        complete(I2C_STATUS_SUCCESS);
+}
+
+// after arbitration loss the other master's STOP raises no interrupt here,
+// so the tick restarts the queue once the bus is free
+static void busPoll() {
+    uint32_t primask = disableInterrupts();
+    if (stopping && active == 0 && pending != 0)
+        startNext();
+    restoreInterrupts(primask);
+}
+
+// callback used by the blocking calls
+static void wakeCaller(void* data, uint8_t) {
+    RTOS::notify((uint8_t)(uint32_t)data);
+}
+
+//-----------------------------------------------------------------------------
+// I2C Transaction Engine
+//-----------------------------------------------------------------------------
+
+void I2c::init(uint32_t speed) {
+    SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R3;       // turn-on I2C3
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOD;
+    (void)SYSCTL_RCGC2_R;
+
+    // PD0 = SCL, PD1 = SDA (open drain)
+    GPIO_PORTD_AFSEL_R |= 0x03;
+    GPIO_PORTD_ODR_R   |= 0x02;
+    GPIO_PORTD_DEN_R   |= 0x03;
+    GPIO_PORTD_PCTL_R   = (GPIO_PORTD_PCTL_R & ~0xFF) | GPIO_PCTL_PD0_I2C3SCL | GPIO_PCTL_PD1_I2C3SDA;
+
+    I2C3_MCR_R  = I2C_MCR_MFE;                   // master mode
+    I2C3_MTPR_R = SYSTEM_CLOCK / (20 * speed) - 1;   // SCL period = 20 * (TPR + 1) clocks
+    I2C3_MICR_R = I2C_MICR_IC;
+    I2C3_MIMR_R = I2C_MIMR_IM;
+    NVIC_EN2_R  = 1 << 5;                        // turn-on interrupt 85 (I2C3)
+
+    pending = 0;
+    active = 0;
+    stopping = false;
+    RTOS::addTickHook(busPoll);
+}
+
+bool I2c::submit(i2cRequest* request) {
+    // queues a batch without blocking; callable from tasks and ISRs. The
+    // request and its buffers must stay valid until the callback runs.
+    if (request->count == 0)
+        return false;
+    for (uint8_t i = 0; i < request->count; i++)
+    {
+        if (request->transactions[i].writeLength == 0 && request->transactions[i].readLength == 0)
+            return false;
+    }
+
+    uint32_t primask = disableInterrupts();
+    request->status = I2C_STATUS_PENDING;
+
+    // insert behind everything of equal or higher priority
+    i2cRequest** link = &pending;
+    while (*link != 0 && (*link)->priority <= request->priority)
+    {
+        link = &(*link)->next;
+    }
+    request->next = *link;
+    *link = request;
+
+    startNext();
+    restoreInterrupts(primask);
+    return true;
+}
+
+uint8_t I2c::transfer(i2cTransaction* transactions, uint8_t count, uint32_t timeout) {
+    // runs a batch at the calling task's priority and blocks until it is done
+    i2cRequest request;
+    request.transactions = transactions;
+    request.count = count;
+    request.priority = tcb[taskCurrent].priority;
+    request.callback = wakeCaller;
+    request.callbackData = (void*)(uint32_t)taskCurrent;
+
+    if (!submit(&request))
+        return I2C_STATUS_ERROR;
+
+    uint32_t start = tickCount;
+    while (request.status == I2C_STATUS_PENDING)
+    {
+        uint32_t elapsed = tickCount - start;
+        if (timeout != WAIT_FOREVER && elapsed >= timeout)
+            break;
+        RTOS::waitNotify(timeout == WAIT_FOREVER ? WAIT_FOREVER : timeout - elapsed);
+    }
+
+    uint32_t primask = disableInterrupts();
+    if (request.status == I2C_STATUS_PENDING)
+    {
+        // timed out: the request lives on our stack, so it must not stay visible
+        if (active == &request)
+        {
+            // the next START waits for the STOP's completion interrupt
+            I2C3_MCS_R = I2C_MCS_STOP;
+            active = 0;
+            stopping = true;
+        }
+        else
+        {
+            i2cRequest** link = &pending;
+            while (*link != &request)
+            {
+                link = &(*link)->next;
+            }
+            *link = request.next;
+        }
+        request.status = I2C_STATUS_TIMEOUT;
+    }
+    restoreInterrupts(primask);
+    return request.status;
+}
+
+uint8_t I2c::readRegisters(uint8_t address, uint8_t reg, uint8_t* data, uint16_t length, uint32_t timeout) {
+    // burst read starting at a register: write the register, repeated start, read
+    i2cTransaction t = { address, &reg, 1, data, length };
+    return transfer(&t, 1, timeout);
+}
+
+uint8_t I2c::writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, uint16_t length, uint32_t timeout) {
+    uint8_t buffer[I2C_MAX_WRITE];
+    if (length >= I2C_MAX_WRITE)
+        return I2C_STATUS_ERROR;
+
+    buffer[0] = reg;
+    for (uint16_t i = 0; i < length; i++)
+    {
+        buffer[i + 1] = data[i];
+    }
+    i2cTransaction t = { address, buffer, (uint16_t)(length + 1), 0, 0 };
+    return transfer(&t, 1, timeout);
+}
@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef I2C_H
+#define I2C_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// I2C Transaction Engine
+//-----------------------------------------------------------------------------
+
+/// Interrupt-driven I2C3 master (PD0/PD1, the SensHub BoosterPack bus) shared
+/// by any number of tasks. A request is a batch of transactions, each an
+/// optional write followed by an optional read with a repeated start, run
+/// back to back without CPU involvement between bytes beyond the ISR.
+/// Pending requests are served in priority order, then in submission order.
+///
+/// Tasks either block in transfer() or submit() a request with a callback in
+/// the style of sensorlib's tSensorCallback, using the same status codes.
+
+/// request status, numbered like sensorlib's I2CM_STATUS_ values
+#define I2C_STATUS_SUCCESS     0
+#define I2C_STATUS_ADDR_NACK   1
+#define I2C_STATUS_DATA_NACK   2
+#define I2C_STATUS_ARB_LOST    3
+#define I2C_STATUS_ERROR       4
+#define I2C_STATUS_TIMEOUT     5
+#define I2C_STATUS_PENDING     0xFF
+
+#define I2C_SPEED_STANDARD     100000
+#define I2C_SPEED_FAST         400000
+
+struct i2cTransaction
+{
+  uint8_t address;             // 7-bit slave address
+  const uint8_t* writeData;    // bytes to write first, may be 0
+  uint16_t writeLength;
+  uint8_t* readData;           // bytes to read after a repeated start, may be 0
+  uint16_t readLength;
+};
+
+typedef void (*_i2cCallback)(void* data, uint8_t status);
+
+struct i2cRequest
+{
+  struct i2cRequest* next;          // link in the pending list
+  struct i2cTransaction* transactions;
+  uint8_t count;                    // transactions in the batch
+  uint8_t priority;                 // 0=highest, 7=lowest
+  volatile uint8_t status;          // see I2C_STATUS_ values above
+  _i2cCallback callback;            // called from the ISR when done, may be 0
+  void* callbackData;
+};
+
+/// Class for I2C
+class I2c
+{
+public:
+    static void init(uint32_t speed);
+    static bool submit(i2cRequest* request);
+    static uint8_t transfer(i2cTransaction* transactions, uint8_t count, uint32_t timeout);
+    static uint8_t readRegisters(uint8_t address, uint8_t reg, uint8_t* data, uint16_t length, uint32_t timeout);
+    static uint8_t writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, uint16_t length, uint32_t timeout);
+};
+
+#endif // I2C_H
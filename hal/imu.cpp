@@ -0,0 +1,337 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+#include "imu.h"
+#include "i2c.h"
+#include "port.h"
+#include "rtos.h"
+#include "sensorlib/hw_mpu9150.h"
+#include "sensorlib/hw_ak8975.h"
+#include "tm4c123gh6pm.h"
+
+#define INT_PIN         0x04    // PB2, data-ready pulse
+#define AK8975_ADDRESS  0x0C    // on the MPU9150 auxiliary bus
+#define RECORD_IMU      12      // accel then gyro, big-endian
+#define RECORD_MAG      8       // ST1, HXL..HZH, ST2 via EXT_SENS_DATA
+#define FIFO_SIZE       1024
+#define CONFIG_TIMEOUT  10      // ticks per configuration write
+
+struct imuRaw
+{
+  uint8_t count[2];                     // FIFO_COUNTH/L, read just before the data
+  volatile uint8_t status;              // I2C_STATUS_ of the read
+  uint16_t samples;                     // records in data
+  uint32_t newestSample;                // number of the newest sample when the read was queued
+  uint32_t newestTime;                  // its data-ready time in microseconds
+  uint8_t data[IMU_BLOCK_MAX * (RECORD_IMU + RECORD_MAG)];
+};
+
+// Define variables
+static imuRaw raw[2];                   // ping-pong, the reader unpacks one while the other fills
+static volatile uint8_t full;           // raw slots waiting for the reader
+static uint8_t writeSlot;               // ISR: next slot to fill
+static uint8_t readSlot;                // reader: next slot to unpack
+static volatile bool reading;           // a block read is queued or on the bus
+static volatile bool arming;            // next data-ready edge enables the FIFO
+static volatile uint8_t edges;          // samples in the FIFO not yet asked for
+static volatile uint32_t sampleCount;   // samples since init
+static volatile uint32_t newestTime;
+static uint32_t delivered;              // number of the next sample handed to the reader
+static uint32_t resyncCount;
+static volatile uint8_t reader = NO_TASK;
+
+static uint8_t watermark;
+static uint8_t record;
+static uint32_t period;
+static bool hasMag;
+static uint8_t userCtrl;                // USER_CTRL without FIFO_EN
+
+static uint8_t countRegister = MPU9150_O_FIFO_COUNTH;
+static uint8_t fifoRegister = MPU9150_O_FIFO_R_W;
+static i2cTransaction readTransactions[2] =
+{
+    { IMU_ADDRESS, &countRegister, 1, 0, 2 },
+    { IMU_ADDRESS, &fifoRegister, 1, 0, 0 },
+};
+static i2cRequest readRequest;
+static uint8_t enableWrite[2];
+static i2cTransaction enableTransaction = { IMU_ADDRESS, enableWrite, 2, 0, 0 };
+static i2cRequest enableRequest;
+
+// free-running microseconds from the tick count and the SysTick down-counter
+static uint32_t micros() {
+    uint32_t ticks = tickCount;
+    uint32_t reload = NVIC_ST_RELOAD_R;
+    uint32_t current = NVIC_ST_CURRENT_R;
+    if ((NVIC_INT_CTRL_R & NVIC_INT_CTRL_PENDSTSET) && current > reload / 2)
+        ticks++;                        // wrapped, tick not serviced yet
+    return ticks * 1000 + (reload - current) / (SYSTEM_CLOCK / 1000000);
+}
+
+static void wake(volatile uint8_t* waiter) {
+    uint8_t task = *waiter;
+    if (task != NO_TASK)
+    {
+        *waiter = NO_TASK;
+        RTOS::notify(task);
+    }
+}
+
+// queue a read of the next watermark samples; ISR or interrupts disabled
+static void submitRead() {
+    imuRaw* r = &raw[writeSlot];
+    r->samples = watermark;
+    r->newestSample = sampleCount - 1;
+    r->newestTime = newestTime;
+    edges -= watermark;
+
+    readTransactions[0].readData = r->count;
+    readTransactions[1].readData = r->data;
+    readTransactions[1].readLength = watermark * record;
+    reading = true;
+    I2c::submit(&readRequest);
+}
+
+static bool canRead() {
+    return !reading && !arming && edges >= watermark && !(full & (1 << writeSlot));
+}
+
+// I2C callback, runs in the I2C ISR
+static void readDone(void*, uint8_t status) {
+    raw[writeSlot].status = status;
+    full |= 1 << writeSlot;
+    writeSlot ^= 1;
+    reading = false;
+    if (canRead())
+        submitRead();                   // a backlog built up while the bus was busy
+    wake(&reader);
+}
+
+extern "C" void GPIOPortB_Handler() {
+    GPIO_PORTB_ICR_R = INT_PIN;
+    uint32_t now = micros();
+
+    if (arming)
+    {
+        // enable the FIFO right after a sample so the next edge is its first record
+        arming = false;
+        I2c::submit(&enableRequest);
+        return;
+    }
+    sampleCount++;
+    newestTime = now;
+    if (edges < 0xFF)
+        edges++;
+    if (canRead())
+        submitRead();
+}
+
+static bool set(uint8_t reg, uint8_t value) {
+    return I2c::writeRegisters(IMU_ADDRESS, reg, &value, 1, CONFIG_TIMEOUT) == I2C_STATUS_SUCCESS;
+}
+
+// reset the FIFO and restart counting; called with the pin masked and no read in flight
+static bool start() {
+    if (!set(MPU9150_O_USER_CTRL, userCtrl | MPU9150_USER_CTRL_FIFO_RESET))
+        return false;
+
+    uint32_t primask = disableInterrupts();
+    full = 0;
+    writeSlot = 0;
+    readSlot = 0;
+    edges = 0;
+    delivered = sampleCount;
+    arming = true;
+    GPIO_PORTB_ICR_R = INT_PIN;
+    GPIO_PORTB_IM_R |= INT_PIN;
+    restoreInterrupts(primask);
+    return true;
+}
+
+static void resync() {
+    GPIO_PORTB_IM_R &= ~INT_PIN;
+    while (reading || enableRequest.status == I2C_STATUS_PENDING)
+        RTOS::sleep(1);
+    resyncCount++;
+    start();
+}
+
+static int16_t bigEndian(const uint8_t* p) {
+    return (int16_t)(p[0] << 8 | p[1]);
+}
+
+static int16_t littleEndian(const uint8_t* p) {
+    return (int16_t)(p[1] << 8 | p[0]);
+}
+
+static void unpack(const imuRaw* r, imuBlock* block) {
+    const uint8_t* p = r->data;
+    for (uint16_t i = 0; i < r->samples; i++)
+    {
+        block->ax[i] = bigEndian(p);
+        block->ay[i] = bigEndian(p + 2);
+        block->az[i] = bigEndian(p + 4);
+        block->gx[i] = bigEndian(p + 6);
+        block->gy[i] = bigEndian(p + 8);
+        block->gz[i] = bigEndian(p + 10);
+        if (hasMag)
+        {
+            // AK8975 X/Y are swapped and Z inverted relative to the accel/gyro axes
+            block->mx[i] = littleEndian(p + 15);
+            block->my[i] = littleEndian(p + 13);
+            block->mz[i] = -littleEndian(p + 17);
+        }
+        else
+        {
+            block->mx[i] = 0;
+            block->my[i] = 0;
+            block->mz[i] = 0;
+        }
+        p += record;
+    }
+    block->count = r->samples;
+    block->period = period;
+    block->sequence = delivered;
+    block->timestamp = r->newestTime - (r->newestSample - delivered) * period;
+    delivered += r->samples;
+}
+
+//-----------------------------------------------------------------------------
+// MPU9150/MPU6050 FIFO Acquisition
+//-----------------------------------------------------------------------------
+
+bool Imu::init(uint16_t rate, uint8_t samples, bool magnetometer) {
+    // call after I2c::init and hwInit (PB2 input); rate in Hz from 4 to 1000,
+    // samples per block from 1 to IMU_BLOCK_MAX
+    if (rate < 4 || rate > 1000 || samples == 0 || samples > IMU_BLOCK_MAX)
+        return false;
+
+    uint8_t who;
+    if (I2c::readRegisters(IMU_ADDRESS, MPU9150_O_WHO_AM_I, &who, 1, CONFIG_TIMEOUT) != I2C_STATUS_SUCCESS ||
+        (who & MPU9150_WHO_AM_I_M) != MPU9150_WHO_AM_I_MPU9150)
+        return false;
+
+    uint8_t divider = 1000 / rate - 1;   // from the 1 kHz gyro rate with the DLPF on
+    watermark = samples;
+    hasMag = magnetometer;
+    record = RECORD_IMU + (magnetometer ? RECORD_MAG : 0);
+    period = 1000 * (divider + 1);
+    userCtrl = magnetometer ? MPU9150_USER_CTRL_I2C_MST_EN : 0;
+
+    readRequest.transactions = readTransactions;
+    readRequest.count = 2;
+    readRequest.priority = 1;
+    readRequest.callback = readDone;
+    readRequest.callbackData = 0;
+    enableWrite[0] = MPU9150_O_USER_CTRL;
+    enableWrite[1] = userCtrl | MPU9150_USER_CTRL_FIFO_EN;
+    enableRequest.transactions = &enableTransaction;
+    enableRequest.count = 1;
+    enableRequest.priority = 0;
+    enableRequest.callback = 0;
+    enableRequest.callbackData = 0;
+    enableRequest.status = I2C_STATUS_SUCCESS;
+
+    set(MPU9150_O_PWR_MGMT_1, MPU9150_PWR_MGMT_1_DEVICE_RESET);
+    RTOS::sleep(100);
+    bool ok = set(MPU9150_O_PWR_MGMT_1, MPU9150_PWR_MGMT_1_CLKSEL_XG);
+    ok = ok && set(MPU9150_O_SMPLRT_DIV, divider);
+    ok = ok && set(MPU9150_O_CONFIG, MPU9150_CONFIG_DLPF_CFG_184_188);
+    ok = ok && set(MPU9150_O_GYRO_CONFIG, MPU9150_GYRO_CONFIG_FS_SEL_2000);
+    ok = ok && set(MPU9150_O_ACCEL_CONFIG, MPU9150_ACCEL_CONFIG_AFS_SEL_8G);
+    ok = ok && set(MPU9150_O_INT_PIN_CFG, 0);            // active high 50 us pulse
+    ok = ok && set(MPU9150_O_INT_ENABLE, MPU9150_INT_ENABLE_DATA_RDY_EN);
+
+    uint8_t fifoEnable = MPU9150_FIFO_EN_ACCEL | MPU9150_FIFO_EN_XG | MPU9150_FIFO_EN_YG | MPU9150_FIFO_EN_ZG;
+    if (magnetometer)
+    {
+        // slave 0 reads the last measurement into EXT_SENS_DATA, slave 1 starts the next;
+        // both run every (1 + delay) samples, about 100 Hz
+        uint8_t delay = rate > 100 ? rate / 100 - 1 : 0;
+        if (delay > MPU9150_I2C_SLV4_CTRL_I2C_MST_DLY_M)
+            delay = MPU9150_I2C_SLV4_CTRL_I2C_MST_DLY_M;
+        ok = ok && set(MPU9150_O_I2C_MST_CTRL, MPU9150_I2C_MST_CTRL_WAIT_FOR_ES | MPU9150_I2C_MST_CTRL_I2C_MST_CLK_400);
+        ok = ok && set(MPU9150_O_I2C_SLV0_ADDR, MPU9150_I2C_SLV0_ADDR_RW | AK8975_ADDRESS);
+        ok = ok && set(MPU9150_O_I2C_SLV0_REG, AK8975_O_ST1);
+        ok = ok && set(MPU9150_O_I2C_SLV0_CTRL, MPU9150_I2C_SLV0_CTRL_EN | RECORD_MAG);
+        ok = ok && set(MPU9150_O_I2C_SLV1_ADDR, AK8975_ADDRESS);
+        ok = ok && set(MPU9150_O_I2C_SLV1_REG, AK8975_O_CNTL);
+        ok = ok && set(MPU9150_O_I2C_SLV1_DO, AK8975_CNTL_MODE_SINGLE);
+        ok = ok && set(MPU9150_O_I2C_SLV1_CTRL, MPU9150_I2C_SLV1_CTRL_EN | 1);
+        ok = ok && set(MPU9150_O_I2C_SLV4_CTRL, delay);
+        ok = ok && set(MPU9150_O_I2C_MST_DELAY_CTRL,
+                       MPU9150_I2C_MST_DELAY_CTRL_I2C_SLV0_DLY_EN | MPU9150_I2C_MST_DELAY_CTRL_I2C_SLV1_DLY_EN);
+        fifoEnable |= MPU9150_FIFO_EN_SLV0;
+    }
+    ok = ok && set(MPU9150_O_FIFO_EN, fifoEnable);
+    if (!ok)
+        return false;
+
+    // rising edge on PB2
+    GPIO_PORTB_IM_R  &= ~INT_PIN;
+    GPIO_PORTB_IS_R  &= ~INT_PIN;
+    GPIO_PORTB_IBE_R &= ~INT_PIN;
+    GPIO_PORTB_IEV_R |= INT_PIN;
+    NVIC_EN0_R = 1 << 1;                // turn-on interrupt 17 (GPIOB)
+    return start();
+}
+
+bool Imu::read(imuBlock* block, uint32_t timeout) {
+    // blocks the (single) reader task until a block of watermark samples is ready
+    uint32_t start = tickCount;
+    while (true)
+    {
+        if (full & (1 << readSlot))
+        {
+            const imuRaw* r = &raw[readSlot];
+            uint32_t fifoCount = r->count[0] << 8 | r->count[1];
+            if (r->status != I2C_STATUS_SUCCESS || fifoCount < (uint32_t)r->samples * record ||
+                fifoCount + record > FIFO_SIZE)
+            {
+                // bus error, or the FIFO overflowed and records are no longer aligned
+                resync();
+                continue;
+            }
+            unpack(r, block);
+
+            uint32_t primask = disableInterrupts();
+            full &= ~(1 << readSlot);
+            readSlot ^= 1;
+            if (canRead())
+                submitRead();
+            restoreInterrupts(primask);
+            return true;
+        }
+
+        uint32_t elapsed = tickCount - start;
+        if (timeout != WAIT_FOREVER && elapsed >= timeout)
+            return false;
+        reader = taskCurrent;
+        if (!(full & (1 << readSlot)))
+            RTOS::waitNotify(timeout == WAIT_FOREVER ? WAIT_FOREVER : timeout - elapsed);
+        reader = NO_TASK;
+    }
+}
+
+uint32_t Imu::resyncs() {
+    return resyncCount;
+}
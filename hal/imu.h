@@ -0,0 +1,81 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+#ifndef IMU_H
+#define IMU_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// MPU9150/MPU6050 FIFO Acquisition
+//-----------------------------------------------------------------------------
+
+/// Batched acquisition from the motion sensor on the SensHub BoosterPack
+/// (I2C3, INT on PB2). Samples collect in the sensor's own FIFO instead of
+/// being read one at a time as MPU9150DataRead does. The part has no FIFO
+/// watermark interrupt, so the data-ready pulses are counted in the GPIO ISR
+/// and every watermark samples one I2C request reads the FIFO count and
+/// bursts the whole block out. The reader task wakes once per block and
+/// gets it unpacked into a structure of arrays.
+///
+/// On an MPU9150 the AK8975 magnetometer is read by the sensor's auxiliary
+/// I2C master at about 100 Hz and lands in the same FIFO records, rotated
+/// into the accel/gyro frame; between updates the last reading repeats.
+///
+/// Samples are numbered from init. A FIFO overflow or bus error resets the
+/// FIFO, which shows up as a gap in imuBlock::sequence.
+
+#define IMU_BLOCK_MAX          32       // samples per block
+#define IMU_ADDRESS            0x68     // AD0 low, as on the SensHub
+
+/// full-scale ranges set by init
+#define IMU_ACCEL_LSB_PER_G    4096     // +/-8 g
+#define IMU_GYRO_LSB_PER_DPS   16.4f    // +/-2000 deg/s
+#define IMU_MAG_UT_PER_LSB     0.3f     // AK8975
+
+struct imuBlock
+{
+  uint32_t sequence;              // number of the first sample since init
+  uint32_t timestamp;             // microseconds (free-running) of the first sample
+  uint32_t period;                // microseconds between samples
+  uint16_t count;                 // samples in this block
+  int16_t ax[IMU_BLOCK_MAX];
+  int16_t ay[IMU_BLOCK_MAX];
+  int16_t az[IMU_BLOCK_MAX];
+  int16_t gx[IMU_BLOCK_MAX];
+  int16_t gy[IMU_BLOCK_MAX];
+  int16_t gz[IMU_BLOCK_MAX];
+  int16_t mx[IMU_BLOCK_MAX];      // zero without a magnetometer
+  int16_t my[IMU_BLOCK_MAX];
+  int16_t mz[IMU_BLOCK_MAX];
+};
+
+/// Class for MPU9150/MPU6050 FIFO acquisition
+class Imu
+{
+public:
+    static bool init(uint16_t rate, uint8_t samples, bool magnetometer);
+    static bool read(imuBlock* block, uint32_t timeout);
+    static uint32_t resyncs();
+};
+
+#endif // IMU_H
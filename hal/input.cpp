@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "input.h"
+#include "rtos.h"
+#include "streambuf.h"
+#include "workqueue.h"
+#include "tm4c123gh6pm.h"
+
+#define PORTC_PINS   0xF0   // PC7..PC4
+#define PORTF_PINS   0x11   // PF4, PF0
+
+// Define variables
+static streamBuffer events;
+static uint8_t eventBuf[128] __attribute__((aligned(4)));
+static workItem debounceWork;
+static volatile uint8_t pending;                 // buttons waiting to be debounced
+static volatile uint32_t edgeTime[INPUT_BUTTONS];
+static uint8_t stable;                           // debounced pressed state
+
+// pressed buttons as INPUT_ bits (buttons pull the pin low)
+static uint8_t readRaw() {
+    uint8_t raw = (~GPIO_PORTC_DATA_R >> 4) & 0x0F;
+    uint32_t portF = ~GPIO_PORTF_DATA_R;
+    if (portF & 0x10)
+        raw |= INPUT_SW1;
+    if (portF & 0x01)
+        raw |= INPUT_SW2;
+    return raw;
+}
+
+// clear stale edges and unmask the pins of the given buttons
+static void arm(uint8_t buttons) {
+    uint32_t portC = (buttons & 0x0F) << 4;
+    uint32_t portF = ((buttons & INPUT_SW1) ? 0x10 : 0) | ((buttons & INPUT_SW2) ? 0x01 : 0);
+    GPIO_PORTC_ICR_R = portC;
+    GPIO_PORTC_IM_R |= portC;
+    GPIO_PORTF_ICR_R = portF;
+    GPIO_PORTF_IM_R |= portF;
+}
+
+// ISR side: note the edge time, mask the pin until it settles
+static void edge(uint8_t buttons) {
+    for (uint8_t i = 0; i < INPUT_BUTTONS; i++)
+    {
+        if ((buttons & (1 << i)) && !(pending & (1 << i)))
+            edgeTime[i] = tickCount;
+    }
+    pending |= buttons;
+    WorkQueue::submitDelayed(&debounceWork, INPUT_DEBOUNCE_TICKS);
+}
+
+// runs on a worker once the debounce time has passed
+static void debounce(workItem*) {
+    uint32_t primask = disableInterrupts();
+    uint8_t buttons = pending;
+    pending = 0;
+    restoreInterrupts(primask);
+
+    uint8_t raw = readRaw();
+    uint8_t changed = (raw ^ stable) & buttons;
+    for (uint8_t i = 0; i < INPUT_BUTTONS; i++)
+    {
+        if (changed & (1 << i))
+        {
+            inputEvent event;
+            event.timestamp = edgeTime[i];
+            event.button = 1 << i;
+            event.pressed = (raw & (1 << i)) != 0;
+            StreamBuffer::send(&events, &event, sizeof(event));
+        }
+    }
+    stable = (stable & ~buttons) | (raw & buttons);
+
+    // an edge between sampling and re-arming would be lost, so check again
+    arm(buttons);
+    uint8_t missed = (readRaw() ^ stable) & buttons;
+    if (missed)
+    {
+        primask = disableInterrupts();
+        edge(missed);
+        restoreInterrupts(primask);
+    }
+}
+
+extern "C" void GPIOPortC_Handler() {
+    uint32_t mis = GPIO_PORTC_MIS_R & PORTC_PINS;
+    GPIO_PORTC_ICR_R = mis;
+    GPIO_PORTC_IM_R &= ~mis;
+    edge(mis >> 4);
+}
+
+extern "C" void GPIOPortF_Handler() {
+    uint32_t mis = GPIO_PORTF_MIS_R & PORTF_PINS;
+    GPIO_PORTF_ICR_R = mis;
+    GPIO_PORTF_IM_R &= ~mis;
+    edge(((mis & 0x10) ? INPUT_SW1 : 0) | ((mis & 0x01) ? INPUT_SW2 : 0));
+}
+
+//-----------------------------------------------------------------------------
+// Input Service
+//-----------------------------------------------------------------------------
+
+void Input::init() {
+    // call after hwInit, which enables the ports and pull-ups (BoardPins)
+    StreamBuffer::init(&events, eventBuf, sizeof(eventBuf), 1);
+    WorkQueue::initWork(&debounceWork, debounce, WORK_QUEUE_HIGH);
+    pending = 0;
+
+    // interrupt on both edges
+    GPIO_PORTC_IS_R  &= ~PORTC_PINS;
+    GPIO_PORTC_IBE_R |= PORTC_PINS;
+    GPIO_PORTF_IS_R  &= ~PORTF_PINS;
+    GPIO_PORTF_IBE_R |= PORTF_PINS;
+
+    stable = readRaw();
+    arm(INPUT_PB0 | INPUT_PB1 | INPUT_PB2 | INPUT_PB3 | INPUT_SW1 | INPUT_SW2);
+    NVIC_EN0_R = (1 << 2) | (1 << 30);    // turn-on interrupts 18 (GPIOC) and 46 (GPIOF)
+}
+
+bool Input::waitEvent(inputEvent* event, uint32_t timeout) {
+    // blocks the (single) consumer task until a debounced event arrives
+    return StreamBuffer::receive(&events, event, sizeof(*event), timeout) == sizeof(*event);
+}
+
+uint8_t Input::state() {
+    return stable;
+}
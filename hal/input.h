@@ -0,0 +1,63 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Input Service
+//-----------------------------------------------------------------------------
+
+/// Push buttons are reported through edge interrupts instead of polling.
+/// The ISR timestamps the edge and masks the pin, a delayed work item samples
+/// the pins once they have settled, and debounced press/release events are
+/// queued for a single consumer task.
+
+/// button bits, matching readPbs() in the application
+#define INPUT_PB0             0x01    // PC4
+#define INPUT_PB1             0x02    // PC5
+#define INPUT_PB2             0x04    // PC6
+#define INPUT_PB3             0x08    // PC7
+#define INPUT_SW1             0x10    // PF4, on-board
+#define INPUT_SW2             0x20    // PF0, on-board
+#define INPUT_BUTTONS         6
+
+#define INPUT_DEBOUNCE_TICKS  10      // settle time before sampling
+
+struct inputEvent
+{
+  uint32_t timestamp;   // tick of the first edge
+  uint8_t button;       // one of the INPUT_ bits above
+  bool pressed;         // true on press, false on release
+};
+
+/// Class for input service
+class Input
+{
+public:
+    static void init();
+    static bool waitEvent(inputEvent* event, uint32_t timeout);
+    static uint8_t state();
+};
+
+#endif // INPUT_H
@@ -0,0 +1,109 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "lcd.h"
+#include "spibus.h"
+#include "port.h"
+#include "rtos.h"
+#include "tm4c123gh6pm.h"
+
+#define CS_PIN          0x80    // PA7
+#define DC_PIN          0x04    // PD2, low for a command byte
+
+#define CMD_SWRESET     0x01
+#define CMD_SLPOUT      0x11
+#define CMD_DISPON      0x29
+#define CMD_CASET       0x2A
+#define CMD_RASET       0x2B
+#define CMD_RAMWR       0x2C
+#define CMD_MADCTL      0x36
+#define CMD_COLMOD      0x3A
+#define COLMOD_RGB565   0x55
+
+// the bus is held from select to end()
+static void select() {
+    SpiBus::acquire(LCD_BIT_RATE);
+    GPIO_PORTA_DATA_R &= ~CS_PIN;
+}
+
+// send() returns once every byte has shifted out, so D/C can change after it
+static void command(uint8_t cmd, const uint8_t* params, uint8_t length) {
+    GPIO_PORTD_DATA_R &= ~DC_PIN;
+    SpiBus::send(&cmd, 1);
+    GPIO_PORTD_DATA_R |= DC_PIN;
+    if (length > 0)
+        SpiBus::send(params, length);
+}
+
+//-----------------------------------------------------------------------------
+// SPI LCD Panel
+//-----------------------------------------------------------------------------
+
+void Lcd::init(uint8_t madctl) {
+    // call from a task after SpiBus::init; madctl sets rotation and RGB/BGR order
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOA | SYSCTL_RCGC2_GPIOD;
+    (void)SYSCTL_RCGC2_R;
+    GPIO_PORTA_AFSEL_R &= ~CS_PIN;
+    GPIO_PORTA_DIR_R   |= CS_PIN;
+    GPIO_PORTA_DATA_R  |= CS_PIN;
+    GPIO_PORTA_DEN_R   |= CS_PIN;
+    GPIO_PORTD_AFSEL_R &= ~DC_PIN;
+    GPIO_PORTD_DIR_R   |= DC_PIN;
+    GPIO_PORTD_DATA_R  |= DC_PIN;
+    GPIO_PORTD_DEN_R   |= DC_PIN;
+
+    select();
+    command(CMD_SWRESET, 0, 0);
+    end();
+    RTOS::sleep(150);
+
+    select();
+    command(CMD_SLPOUT, 0, 0);
+    end();
+    RTOS::sleep(120);
+
+    uint8_t colmod = COLMOD_RGB565;
+    select();
+    command(CMD_COLMOD, &colmod, 1);
+    command(CMD_MADCTL, &madctl, 1);
+    command(CMD_DISPON, 0, 0);
+    end();
+}
+
+void Lcd::setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    // inclusive bounds; leaves the panel in RAMWR for writePixels()
+    uint8_t columns[4] = { (uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1 };
+    uint8_t rows[4] = { (uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1 };
+    select();
+    command(CMD_CASET, columns, 4);
+    command(CMD_RASET, rows, 4);
+    command(CMD_RAMWR, 0, 0);
+}
+
+void Lcd::writePixels(const uint8_t* data, uint32_t length) {
+    SpiBus::transfer(data, 0, length);
+}
+
+void Lcd::end() {
+    SpiBus::waitIdle();
+    GPIO_PORTA_DATA_R |= CS_PIN;
+    SpiBus::release();
+}
@@ -0,0 +1,50 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef LCD_H
+#define LCD_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// SPI LCD Panel
+//-----------------------------------------------------------------------------
+
+/// MIPI DCS panel (ST7735, ST7789, ILI9341 class) on the shared SSI0 bus, with
+/// chip select on PA7 and data/command on PD2; reset is tied to the board
+/// reset. Pixels are RGB565, most significant byte first.
+///
+/// A region update is setWindow(), any number of writePixels() DMA transfers,
+/// then end(); the bus is held in between.
+
+#define LCD_BIT_RATE    (SYSTEM_CLOCK / 2)
+
+/// Class for the SPI LCD panel
+class Lcd
+{
+public:
+    static void init(uint8_t madctl);
+    static void setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    static void writePixels(const uint8_t* data, uint32_t length);
+    static void end();
+};
+
+#endif // LCD_H
@@ -21,8 +21,15 @@
 #include "port.h"
 #include <stdint.h>
 #include "rtos.h"
+#include "board.h"
+#include "udma.h"
+#include "uart.h"
 #include "tm4c123gh6pm.h"
 
+extern "C" void SysTick_Handler() {
+    RTOS::tickIsr();
+}
+
 void hwInit() {
     // Set PendSV to lowest priority (to ensure it runs only when needed)
     *(volatile uint32_t*)0xE000ED22 = 0xFF;
@@ -33,26 +40,8 @@ void hwInit() {
     // Set GPIO ports to use APB (not needed since default configuration -- for clarity)
     // Note UART on port A must use APB
     SYSCTL_GPIOHBCTL_R  = 0;//use of APB bus
-    SYSCTL_RCGC2_R      = SYSCTL_RCGC2_GPIOF | SYSCTL_RCGC2_GPIOA| SYSCTL_RCGC2_GPIOB| SYSCTL_RCGC2_GPIOC; //Enable port A and port F
-    //port F Configuration
-    GPIO_PORTF_DIR_R    = 0x06;//port F pins 1,2 are outputs and pins 0,4 are input
-    GPIO_PORTF_DR2R_R   = 0x06;//pins 1,2 has 2mA current drive strength
-    GPIO_PORTF_PUR_R    = 0x11;// enable internal pull-up for push button on pins 0,4
-    GPIO_PORTF_DEN_R    = 0x17;//enable(or make LED's and push buttons digital) LEDs and pushbuttons
-    //port F Configuration
-    GPIO_PORTA_DIR_R    = 0x0C;//port A pins 3,2 are outputs and pins 5,4 are input
-    GPIO_PORTA_DR2R_R   = 0x0C;//pins 3,2 has 2mA current drive strength
-    GPIO_PORTA_PUR_R    = 0x30;// enable internal pull-up for push button on pins 5,4
-    GPIO_PORTA_DEN_R    = 0x3C;//enable(or make LED's and push buttons digital) LEDs and pushbuttons
-
-    // Configure External LED and pushbutton pins
-    GPIO_PORTB_DIR_R  = 0xF0;                           // bits 1, 2, and 3 are outputs, other pins are inputs
-    GPIO_PORTB_DR2R_R = 0xF0;                           // set drive strength to 2mA (not needed since default configuration -- for clarity)
-    GPIO_PORTB_DEN_R  = 0xF0;                           // enable LEDs and pushbuttons
-
-    GPIO_PORTC_DIR_R = 0x00;                            // Bits PC7, PC6, PC5, and PC4 are Inputs for Push Buttons
-    GPIO_PORTC_DEN_R = 0xF0;                            // Enable digital functions for the Push Buttons
-    GPIO_PORTC_PUR_R = 0xF0;                            // Enable internal pull-up for push buttons
+    // Enable clocks and configure LEDs and pushbuttons from the board pin table
+    BoardPins::apply();
 
     //-----------------------------------Init of SysTick Timer--------------------------
     NVIC_ST_CTRL_R = 0;           // disable SysTick during setup
@@ -64,18 +53,12 @@ void hwInit() {
     //---------------------------Init Uart0 Module---------------------------------------
     // Configure UART0 pins
     SYSCTL_RCGCUART_R |= SYSCTL_RCGCUART_R0;         // turn-on UART0, leave other uarts in same status
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOA;            // port A is not in the board pin table
     GPIO_PORTA_DEN_R |= 3;                           // default, added for clarity
     GPIO_PORTA_AFSEL_R |= 3;                         // default, added for clarity
     GPIO_PORTA_PCTL_R |= GPIO_PCTL_PA1_U0TX | GPIO_PCTL_PA0_U0RX;
 
-    // Configure UART0 to 115200 baud, 8N1 format (must be 3 clocks from clock enable and config writes)
-    UART0_CTL_R  = 0;                                 // turn-off UART0 to allow safe programming
-    UART0_CC_R   = UART_CC_CS_SYSCLK;                  // use system clock (40 MHz)
-    UART0_IBRD_R = 21;                               // r = 40 MHz / (Nx115.2kHz), set floor(r)=21, where N=16
-    UART0_FBRD_R = 45;                               // round(fract(r)*64)=45
-    UART0_LCRH_R = UART_LCRH_WLEN_8;// | UART_LCRH_FEN; // configure for 8N1 w/ 16-level FIFO
-    UART0_IM_R   = UART_IM_RXIM;                       // turn-on RX interrupt
-    NVIC_EN0_R   = 1<<5;                               // turn-on interrupt 21 (UART0)
-    //NVIC_PRI1_R  |= 0x000040000                         //priority 2
-    UART0_CTL_R = UART_CTL_TXE | UART_CTL_RXE | UART_CTL_UARTEN; // enable TX, RX, and module
+    // UART0 at 115200 baud, 8N1 with FIFOs, both directions on the uDMA
+    Udma::init();
+    Uart::init(115200);
 }
\ No newline at end of file
@@ -21,6 +21,8 @@
 #ifndef PORT_H
 #define PORT_H
 
+#define SYSTEM_CLOCK 40000000   // Hz, set up by hwInit
+
 void hwInit();
 
 #endif // PORT_H
@@ -0,0 +1,348 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "sdcard.h"
+#include "spibus.h"
+#include "port.h"
+#include "rtos.h"
+#include "tm4c123gh6pm.h"
+
+// card commands; ACMDs are flagged and sent after CMD55
+#define CMD0            0       // GO_IDLE_STATE
+#define CMD1            1       // SEND_OP_COND (MMC)
+#define CMD8            8       // SEND_IF_COND
+#define CMD9            9       // SEND_CSD
+#define CMD12           12      // STOP_TRANSMISSION
+#define CMD16           16      // SET_BLOCKLEN
+#define CMD17           17      // READ_SINGLE_BLOCK
+#define CMD18           18      // READ_MULTIPLE_BLOCK
+#define CMD24           24      // WRITE_BLOCK
+#define CMD25           25      // WRITE_MULTIPLE_BLOCK
+#define CMD55           55      // APP_CMD
+#define CMD58           58      // READ_OCR
+#define ACMD23          (0x80 | 23)   // SET_WR_BLK_ERASE_COUNT
+#define ACMD41          (0x80 | 41)   // SD_SEND_OP_COND
+
+#define TOKEN_SINGLE    0xFE    // start of a block, single transfers and reads
+#define TOKEN_MULTI     0xFC    // start of a block in a multi-block write
+#define TOKEN_STOP      0xFD    // end of a multi-block write
+
+#define CS_PIN          0x40    // PA6, driven as GPIO around each command
+#define INIT_RATE       400000
+#define BIT_RATE        (SYSTEM_CLOCK / 2)
+
+#define INIT_TIMEOUT    1000    // ticks for the card to leave idle
+#define READ_TIMEOUT    100     // ticks for a data token
+#define BUSY_TIMEOUT    500     // ticks for programming to finish
+
+// Define variables
+static uint8_t cardType;
+static uint32_t cardSectors;
+static uint8_t writeToken;      // token of the open write, 0 when none
+static bool writeFailed;
+
+// the bus is held from select to deselect
+static void select(uint32_t bitRate) {
+    SpiBus::acquire(bitRate);
+    GPIO_PORTA_DATA_R &= ~CS_PIN;
+    SpiBus::exchange(0xFF);
+}
+
+static void deselect() {
+    SpiBus::waitIdle();
+    GPIO_PORTA_DATA_R |= CS_PIN;
+    SpiBus::exchange(0xFF);     // one more clock so the card releases MISO
+    SpiBus::release();
+}
+
+// wait for the card to leave busy (MISO held low), sleeping between polls
+static bool waitReady(uint32_t timeout) {
+    uint32_t start = tickCount;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        if (SpiBus::exchange(0xFF) == 0xFF)
+            return true;
+    }
+    while (tickCount - start < timeout)
+    {
+        if (SpiBus::exchange(0xFF) == 0xFF)
+            return true;
+        RTOS::sleep(1);
+    }
+    return false;
+}
+
+// returns the R1 response, or 0xFF when the card did not answer
+static uint8_t command(uint8_t cmd, uint32_t arg) {
+    if (cmd & 0x80)
+    {
+        cmd &= 0x7F;
+        uint8_t r = command(CMD55, 0);
+        if (r > 1)
+            return r;
+    }
+    if (cmd != CMD0 && cmd != CMD12 && !waitReady(BUSY_TIMEOUT))
+        return 0xFF;
+
+    // only CMD0 and CMD8 are CRC checked in SPI mode
+    uint8_t crc = (cmd == CMD0) ? 0x95 : (cmd == CMD8) ? 0x87 : 0x01;
+    uint8_t frame[6] = { (uint8_t)(0x40 | cmd), (uint8_t)(arg >> 24), (uint8_t)(arg >> 16),
+                         (uint8_t)(arg >> 8), (uint8_t)arg, crc };
+    SpiBus::send(frame, 6);
+    if (cmd == CMD12)
+        SpiBus::exchange(0xFF);     // stuff byte
+
+    uint8_t r = 0xFF;
+    for (uint8_t i = 0; i < 10 && (r & 0x80); i++)
+    {
+        r = SpiBus::exchange(0xFF);
+    }
+    return r;
+}
+
+static void receive(uint8_t* data, uint8_t length) {
+    for (uint8_t i = 0; i < length; i++)
+    {
+        data[i] = SpiBus::exchange(0xFF);
+    }
+}
+
+// one data block: wait for its token, DMA the payload, drop the CRC
+static bool readData(uint8_t* data, uint32_t length) {
+    uint32_t start = tickCount;
+    uint8_t token;
+    while ((token = SpiBus::exchange(0xFF)) == 0xFF)
+    {
+        if (tickCount - start >= READ_TIMEOUT)
+            return false;
+    }
+    if (token != TOKEN_SINGLE)
+        return false;
+
+    if (length == SDCARD_BLOCK_SIZE)
+        SpiBus::transfer(0, data, length);
+    else
+        receive(data, length);
+    SpiBus::exchange(0xFF);
+    SpiBus::exchange(0xFF);
+    return true;
+}
+
+static uint32_t blockAddress(uint32_t sector) {
+    return (cardType & SDCARD_BLOCK) ? sector : sector * SDCARD_BLOCK_SIZE;
+}
+
+static uint32_t csdSectors(const uint8_t* csd) {
+    if ((csd[0] >> 6) == 1)
+    {
+        // CSD v2: capacity in 512 KB units
+        uint32_t size = csd[9] + ((uint32_t)csd[8] << 8) + ((uint32_t)(csd[7] & 0x3F) << 16) + 1;
+        return size << 10;
+    }
+    uint8_t shift = (csd[5] & 15) + ((csd[10] & 128) >> 7) + ((csd[9] & 3) << 1) + 2;
+    uint32_t size = (csd[8] >> 6) + ((uint32_t)csd[7] << 2) + ((uint32_t)(csd[6] & 3) << 10) + 1;
+    return size << (shift - 9);
+}
+
+//-----------------------------------------------------------------------------
+// SD Card (SPI mode)
+//-----------------------------------------------------------------------------
+
+bool SdCard::init() {
+    // call after SpiBus::init; safe to call again after a card change
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOA;
+    (void)SYSCTL_RCGC2_R;
+    GPIO_PORTA_AFSEL_R &= ~CS_PIN;
+    GPIO_PORTA_DIR_R   |= CS_PIN;
+    GPIO_PORTA_DATA_R  |= CS_PIN;
+    GPIO_PORTA_DEN_R   |= CS_PIN;
+
+    cardType = 0;
+    cardSectors = 0;
+    writeToken = 0;
+
+    // 80 clocks with chip select high put the card in SPI mode
+    SpiBus::acquire(INIT_RATE);
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        SpiBus::exchange(0xFF);
+    }
+    SpiBus::release();
+
+    uint8_t type = 0;
+    uint8_t ocr[4];
+    select(INIT_RATE);
+    if (command(CMD0, 0) == 1)
+    {
+        uint32_t start = tickCount;
+        bool ready = false;
+        if (command(CMD8, 0x1AA) == 1)
+        {
+            // SD v2: accepts 2.7-3.6 V
+            receive(ocr, 4);
+            if (ocr[2] == 0x01 && ocr[3] == 0xAA)
+            {
+                while (!(ready = command(ACMD41, 1u << 30) == 0) && tickCount - start < INIT_TIMEOUT)
+                {
+                    RTOS::sleep(1);
+                }
+                if (ready && command(CMD58, 0) == 0)
+                {
+                    receive(ocr, 4);
+                    type = (ocr[0] & 0x40) ? SDCARD_SD2 | SDCARD_BLOCK : SDCARD_SD2;
+                }
+            }
+        }
+        else
+        {
+            // SD v1 or MMC v3
+            uint8_t cmd = ACMD41;
+            type = SDCARD_SD1;
+            if (command(ACMD41, 0) > 1)
+            {
+                cmd = CMD1;
+                type = SDCARD_MMC;
+            }
+            while (!(ready = command(cmd, 0) == 0) && tickCount - start < INIT_TIMEOUT)
+            {
+                RTOS::sleep(1);
+            }
+            if (!ready || command(CMD16, SDCARD_BLOCK_SIZE) != 0)
+                type = 0;
+        }
+    }
+
+    uint8_t csd[16];
+    if (type != 0 && command(CMD9, 0) == 0 && readData(csd, 16))
+        cardSectors = csdSectors(csd);
+    deselect();
+
+    cardType = type;
+    return type != 0;
+}
+
+uint8_t SdCard::type() {
+    return cardType;
+}
+
+uint32_t SdCard::sectors() {
+    return cardSectors;
+}
+
+bool SdCard::readBlocks(uint32_t sector, uint8_t* data, uint32_t count) {
+    if (cardType == 0 || count == 0)
+        return false;
+
+    bool ok;
+    select(BIT_RATE);
+    if (count == 1)
+    {
+        ok = command(CMD17, blockAddress(sector)) == 0 && readData(data, SDCARD_BLOCK_SIZE);
+    }
+    else
+    {
+        ok = command(CMD18, blockAddress(sector)) == 0;
+        for (; ok && count > 0; count--)
+        {
+            ok = readData(data, SDCARD_BLOCK_SIZE);
+            data += SDCARD_BLOCK_SIZE;
+        }
+        command(CMD12, 0);
+    }
+    deselect();
+    return ok;
+}
+
+bool SdCard::writeBlocks(uint32_t sector, const uint8_t* data, uint32_t count) {
+    if (!beginWrite(sector, count))
+        return false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        writeNext(data + i * SDCARD_BLOCK_SIZE);
+    }
+    return endWrite();
+}
+
+bool SdCard::beginWrite(uint32_t sector, uint32_t count) {
+    // holds the bus until endWrite(); exactly count blocks must follow
+    if (cardType == 0 || count == 0)
+        return false;
+
+    select(BIT_RATE);
+    bool ok;
+    if (count == 1)
+    {
+        ok = command(CMD24, blockAddress(sector)) == 0;
+        writeToken = TOKEN_SINGLE;
+    }
+    else
+    {
+        // pre-erase hint lets the card program the run faster
+        if (cardType & (SDCARD_SD1 | SDCARD_SD2))
+            command(ACMD23, count);
+        ok = command(CMD25, blockAddress(sector)) == 0;
+        writeToken = TOKEN_MULTI;
+    }
+    if (!ok)
+    {
+        writeToken = 0;
+        deselect();
+        return false;
+    }
+    writeFailed = false;
+    return true;
+}
+
+bool SdCard::writeNext(const uint8_t* block) {
+    if (writeToken == 0 || writeFailed)
+        return false;
+
+    if (!waitReady(BUSY_TIMEOUT))
+    {
+        writeFailed = true;
+        return false;
+    }
+    SpiBus::exchange(writeToken);
+    SpiBus::transfer(block, 0, SDCARD_BLOCK_SIZE);
+    SpiBus::exchange(0xFF);     // CRC, not checked
+    SpiBus::exchange(0xFF);
+
+    // data response xxx0sss1: 010 accepted
+    if ((SpiBus::exchange(0xFF) & 0x1F) != 0x05)
+        writeFailed = true;
+    return !writeFailed;
+}
+
+bool SdCard::endWrite() {
+    if (writeToken == 0)
+        return false;
+
+    bool ok = waitReady(BUSY_TIMEOUT);
+    if (writeToken == TOKEN_MULTI)
+    {
+        SpiBus::exchange(TOKEN_STOP);
+        SpiBus::exchange(0xFF);
+        ok = waitReady(BUSY_TIMEOUT) && ok;
+    }
+    deselect();
+    writeToken = 0;
+    return ok && !writeFailed;
+}
@@ -0,0 +1,62 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef SDCARD_H
+#define SDCARD_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// SD Card (SPI mode)
+//-----------------------------------------------------------------------------
+
+/// SD/SDHC/MMC card on the shared SSI0 bus (spibus.h), chip select on PA6.
+///
+/// Runs of blocks use READ_MULTIPLE_BLOCK (CMD18) and WRITE_MULTIPLE_BLOCK
+/// (CMD25) so a run costs one command, and each 512-byte block moves on the
+/// uDMA. While the card is busy programming, the task sleeps between polls
+/// instead of spinning. A multi-block write may also be streamed one block
+/// at a time with beginWrite/writeNext/endWrite, so blocks need not be
+/// contiguous in memory.
+
+#define SDCARD_BLOCK_SIZE   512
+
+// card type flags
+#define SDCARD_MMC          0x01    // MMC ver 3
+#define SDCARD_SD1          0x02    // SD ver 1
+#define SDCARD_SD2          0x04    // SD ver 2
+#define SDCARD_BLOCK        0x08    // block addressing (SDHC/SDXC)
+
+/// Class for the SD card
+class SdCard
+{
+public:
+    static bool init();
+    static uint8_t type();
+    static uint32_t sectors();
+    static bool readBlocks(uint32_t sector, uint8_t* data, uint32_t count);
+    static bool writeBlocks(uint32_t sector, const uint8_t* data, uint32_t count);
+    static bool beginWrite(uint32_t sector, uint32_t count);
+    static bool writeNext(const uint8_t* block);
+    static bool endWrite();
+};
+
+#endif // SDCARD_H
@@ -0,0 +1,172 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "spibus.h"
+#include "udma.h"
+#include "port.h"
+#include "rtos.h"
+#include "sync.h"
+#include "tm4c123gh6pm.h"
+
+#define RX_CONTROL      (UDMA_PERIPH_TO_MEM_8 | UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_BASIC)
+#define TX_CONTROL      (UDMA_MEM_TO_PERIPH_8 | UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_BASIC)
+#define DUMMY_CONTROL   (UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_SRCINC_NONE | UDMA_CHCTL_SRCSIZE_8 | UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_BASIC)
+
+// Define variables
+static mutex busLock;
+static uint32_t currentRate;
+static volatile uint8_t dmaWaiter = NO_TASK;
+static uint8_t dummyTx = 0xFF;
+static uint8_t dummyRx;
+
+extern "C" void SSI0_Handler() {
+    uint32_t done = UDMA_CHIS_R & ((1u << UDMA_CH_SSI0RX) | (1u << UDMA_CH_SSI0TX));
+    UDMA_CHIS_R = done;
+    SSI0_ICR_R = SSI0_MIS_R;
+
+    // receive finishing means every byte has been clocked on the wire
+    if ((done & (1u << UDMA_CH_SSI0RX)) && dmaWaiter != NO_TASK)
+    {
+        uint8_t task = dmaWaiter;
+        dmaWaiter = NO_TASK;
+        RTOS::notify(task);
+    }
+}
+
+// fastest rate not above bitRate: clk / (CPSDVSR * (1 + SCR)), CPSDVSR even
+static void setRate(uint32_t bitRate) {
+    uint32_t divider = (SYSTEM_CLOCK + bitRate - 1) / bitRate;
+    uint32_t prescale = 2;
+    uint32_t scr = (divider + prescale - 1) / prescale - 1;
+    while (scr > 255 && prescale < 254)
+    {
+        prescale += 2;
+        scr = (divider + prescale - 1) / prescale - 1;
+    }
+
+    SSI0_CR1_R  = 0;
+    SSI0_CPSR_R = prescale;
+    SSI0_CR0_R  = (scr << SSI_CR0_SCR_S) | SSI_CR0_FRF_MOTO | SSI_CR0_DSS_8;
+    SSI0_CR1_R  = SSI_CR1_SSE;
+    currentRate = bitRate;
+}
+
+//-----------------------------------------------------------------------------
+// SSI0 SPI Bus
+//-----------------------------------------------------------------------------
+
+void SpiBus::init() {
+    // call after Udma::init
+    Mutex::init(&busLock);
+
+    SYSCTL_RCGCSSI_R |= SYSCTL_RCGCSSI_R0;          // turn-on SSI0
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOA;
+    (void)SYSCTL_RCGC2_R;
+
+    // PA2 CLK, PA4 RX, PA5 TX on SSI0
+    GPIO_PORTA_AFSEL_R |= 0x34;
+    GPIO_PORTA_PCTL_R   = (GPIO_PORTA_PCTL_R & ~0x00FF0F00) | GPIO_PCTL_PA2_SSI0CLK | GPIO_PCTL_PA4_SSI0RX | GPIO_PCTL_PA5_SSI0TX;
+    GPIO_PORTA_PUR_R   |= 0x10;                     // SD cards leave MISO floating when deselected
+    GPIO_PORTA_DEN_R   |= 0x34;
+
+    // master, mode 0, 8-bit
+    SSI0_CC_R   = SSI_CC_CS_SYSPLL;
+    SSI0_DMACTL_R = SSI_DMACTL_RXDMAE | SSI_DMACTL_TXDMAE;
+    setRate(SYSTEM_CLOCK / 2);
+
+    Udma::assign(UDMA_CH_SSI0RX, 0);
+    Udma::assign(UDMA_CH_SSI0TX, 0);
+    UDMA_REQMASKCLR_R = (1u << UDMA_CH_SSI0RX) | (1u << UDMA_CH_SSI0TX);
+    NVIC_EN0_R = 1 << 7;                            // turn-on interrupt 23 (SSI0)
+}
+
+void SpiBus::acquire(uint32_t bitRate) {
+    // the caller selects its device only after this returns
+    Mutex::lock(&busLock);
+    if (bitRate != currentRate)
+        setRate(bitRate);
+}
+
+void SpiBus::release() {
+    Mutex::unlock(&busLock);
+}
+
+uint8_t SpiBus::exchange(uint8_t data) {
+    SSI0_DR_R = data;
+    while ((SSI0_SR_R & SSI_SR_RNE) == 0)
+    {
+    }
+    return SSI0_DR_R;
+}
+
+void SpiBus::send(const uint8_t* data, uint8_t length) {
+    // up to the FIFO depth (8); the bytes clocked in alongside are discarded
+    // so the data phase that follows starts clean
+    for (uint8_t i = 0; i < length; i++)
+    {
+        SSI0_DR_R = data[i];
+    }
+    for (uint8_t i = 0; i < length; i++)
+    {
+        while ((SSI0_SR_R & SSI_SR_RNE) == 0)
+        {
+        }
+        (void)SSI0_DR_R;
+    }
+}
+
+void SpiBus::transfer(const uint8_t* tx, uint8_t* rx, uint32_t length) {
+    // rx or tx may be 0 to discard / send 0xFF
+    while (length > 0)
+    {
+        uint32_t chunk = (length > UDMA_MAX_TRANSFER) ? UDMA_MAX_TRANSFER : length;
+
+        if (rx != 0)
+            Udma::setTransfer(UDMA_CH_SSI0RX, false, RX_CONTROL, &SSI0_DR_R, rx, chunk);
+        else
+            Udma::setTransfer(UDMA_CH_SSI0RX, false, DUMMY_CONTROL, &SSI0_DR_R, &dummyRx, chunk);
+        if (tx != 0)
+            Udma::setTransfer(UDMA_CH_SSI0TX, false, TX_CONTROL, tx, &SSI0_DR_R, chunk);
+        else
+            Udma::setTransfer(UDMA_CH_SSI0TX, false, DUMMY_CONTROL, &dummyTx, &SSI0_DR_R, chunk);
+
+        dmaWaiter = taskCurrent;
+        Udma::enable(UDMA_CH_SSI0RX);
+        Udma::enable(UDMA_CH_SSI0TX);
+        while (Udma::isEnabled(UDMA_CH_SSI0RX))
+        {
+            RTOS::waitNotify(WAIT_FOREVER);
+        }
+        dmaWaiter = NO_TASK;
+
+        length -= chunk;
+        if (tx != 0)
+            tx += chunk;
+        if (rx != 0)
+            rx += chunk;
+    }
+}
+
+void SpiBus::waitIdle() {
+    while (SSI0_SR_R & SSI_SR_BSY)
+    {
+    }
+}
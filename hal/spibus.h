@@ -0,0 +1,51 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef SPIBUS_H
+#define SPIBUS_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// SSI0 SPI Bus
+//-----------------------------------------------------------------------------
+
+/// SSI0 master on PA2 (CLK), PA4 (MISO) and PA5 (MOSI), shared by the SPI
+/// flash and the SD card. Each device drives its own chip select as a GPIO.
+///
+/// A device acquires the bus for a whole command sequence, which also sets
+/// the clock rate it needs. Short command phases are polled through the
+/// FIFO; data phases run on the uDMA while the calling task blocks.
+
+/// Class for the SSI0 bus
+class SpiBus
+{
+public:
+    static void init();
+    static void acquire(uint32_t bitRate);
+    static void release();
+    static uint8_t exchange(uint8_t data);
+    static void send(const uint8_t* data, uint8_t length);
+    static void transfer(const uint8_t* tx, uint8_t* rx, uint32_t length);
+    static void waitIdle();
+};
+
+#endif // SPIBUS_H
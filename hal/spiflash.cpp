@@ -0,0 +1,301 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "spiflash.h"
+#include "spibus.h"
+#include "port.h"
+#include "rtos.h"
+#include "sync.h"
+#include "tm4c123gh6pm.h"
+
+// flash commands
+#define CMD_PP          0x02    // page program
+#define CMD_READ        0x03    // read data
+#define CMD_RDSR        0x05    // read status register
+#define CMD_WREN        0x06    // enable writes
+#define CMD_SE          0x20    // 4 KB sector erase
+#define STATUS_WIP      0x01    // write in progress
+
+#define CS_PIN          0x08    // PA3, driven as GPIO around each command
+#define NO_PAGE         0xFFFFFFFF
+
+#define BIT_RATE        (SYSTEM_CLOCK / 2)
+
+struct cachePage
+{
+  uint32_t page;            // flash page number, or NO_PAGE
+  uint32_t lastUse;         // LRU stamp
+  uint16_t dirtyStart;      // dirty byte span [dirtyStart, dirtyEnd)
+  uint16_t dirtyEnd;
+  uint8_t data[SPIFLASH_PAGE_SIZE];
+};
+
+// Define variables
+static cachePage cache[SPIFLASH_CACHE_PAGES];
+static uint32_t useCounter;
+static uint32_t nextSequential = NO_PAGE;   // page that would continue the last read
+static mutex flashLock;
+
+// the bus is held from select to deselect
+static void select() {
+    SpiBus::acquire(BIT_RATE);
+    GPIO_PORTA_DATA_R &= ~CS_PIN;
+}
+
+static void deselect() {
+    SpiBus::waitIdle();
+    GPIO_PORTA_DATA_R |= CS_PIN;
+    SpiBus::release();
+}
+
+static void sendCommand(uint8_t command, uint32_t address, bool hasAddress) {
+    uint8_t bytes[4] = { command, (uint8_t)(address >> 16), (uint8_t)(address >> 8), (uint8_t)address };
+    SpiBus::send(bytes, hasAddress ? 4 : 1);
+}
+
+static uint8_t readStatus() {
+    uint8_t status;
+    select();
+    sendCommand(CMD_RDSR, 0, false);
+    status = SpiBus::exchange(0xFF);
+    deselect();
+    return status;
+}
+
+static void writeEnable() {
+    select();
+    sendCommand(CMD_WREN, 0, false);
+    deselect();
+}
+
+// sleep between status polls instead of spinning on the bus
+static void waitReady(uint32_t pollTicks) {
+    while (readStatus() & STATUS_WIP)
+    {
+        RTOS::sleep(pollTicks);
+    }
+}
+
+static cachePage* lookup(uint32_t page) {
+    for (uint8_t i = 0; i < SPIFLASH_CACHE_PAGES; i++)
+    {
+        if (cache[i].page == page)
+        {
+            cache[i].lastUse = ++useCounter;
+            return &cache[i];
+        }
+    }
+    return 0;
+}
+
+static bool programDirty(cachePage* c) {
+    if (c->page == NO_PAGE || c->dirtyEnd <= c->dirtyStart)
+        return true;
+
+    writeEnable();
+    select();
+    sendCommand(CMD_PP, c->page * SPIFLASH_PAGE_SIZE + c->dirtyStart, true);
+    SpiBus::transfer(&c->data[c->dirtyStart], 0, c->dirtyEnd - c->dirtyStart);
+    deselect();
+    waitReady(1);
+
+    c->dirtyStart = SPIFLASH_PAGE_SIZE;
+    c->dirtyEnd = 0;
+    return true;
+}
+
+// claim the least recently used slot for a page, writing it back first if dirty
+static cachePage* claim(uint32_t page) {
+    cachePage* v = &cache[0];
+    for (uint8_t i = 1; i < SPIFLASH_CACHE_PAGES && v->page != NO_PAGE; i++)
+    {
+        if (cache[i].page == NO_PAGE || cache[i].lastUse < v->lastUse)
+            v = &cache[i];
+    }
+    programDirty(v);
+    v->page = page;
+    v->lastUse = ++useCounter;
+    v->dirtyStart = SPIFLASH_PAGE_SIZE;
+    v->dirtyEnd = 0;
+    return v;
+}
+
+// bring a page in, plus read-ahead pages when the access is sequential
+static cachePage* load(uint32_t page, uint32_t lastPage) {
+    cachePage* slots[1 + SPIFLASH_READ_AHEAD];
+    uint8_t count = 1;
+
+    slots[0] = claim(page);
+    if (page == nextSequential)
+    {
+        while (count < 1 + SPIFLASH_READ_AHEAD && page + count <= lastPage + SPIFLASH_READ_AHEAD && lookup(page + count) == 0)
+        {
+            slots[count] = claim(page + count);
+            count++;
+        }
+    }
+
+    // one read command streams consecutive pages into their slots
+    select();
+    sendCommand(CMD_READ, page * SPIFLASH_PAGE_SIZE, true);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        SpiBus::transfer(0, slots[i]->data, SPIFLASH_PAGE_SIZE);
+    }
+    deselect();
+
+    // the requested page is the most recent
+    slots[0]->lastUse = ++useCounter;
+    return slots[0];
+}
+
+//-----------------------------------------------------------------------------
+// SPI NOR Flash Block Device
+//-----------------------------------------------------------------------------
+
+void SpiFlash::init() {
+    // call after SpiBus::init
+    Mutex::init(&flashLock);
+    invalidate();
+
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOA;
+    (void)SYSCTL_RCGC2_R;
+
+    // PA3 chip select as GPIO, idle high
+    GPIO_PORTA_AFSEL_R &= ~CS_PIN;
+    GPIO_PORTA_DIR_R   |= CS_PIN;
+    GPIO_PORTA_DATA_R  |= CS_PIN;
+    GPIO_PORTA_DEN_R   |= CS_PIN;
+}
+
+void SpiFlash::invalidate() {
+    // drop every cached page without writing it back
+    for (uint8_t i = 0; i < SPIFLASH_CACHE_PAGES; i++)
+    {
+        cache[i].page = NO_PAGE;
+        cache[i].lastUse = 0;
+        cache[i].dirtyStart = SPIFLASH_PAGE_SIZE;
+        cache[i].dirtyEnd = 0;
+    }
+    useCounter = 0;
+    nextSequential = NO_PAGE;
+}
+
+bool SpiFlash::read(uint32_t address, void* data, uint32_t length) {
+    uint8_t* dst = (uint8_t*)data;
+    uint32_t lastPage = (address + length - 1) / SPIFLASH_PAGE_SIZE;
+
+    if (length == 0)
+        return true;
+
+    Mutex::lock(&flashLock);
+    while (length > 0)
+    {
+        uint32_t page = address / SPIFLASH_PAGE_SIZE;
+        uint32_t offset = address % SPIFLASH_PAGE_SIZE;
+        uint32_t chunk = SPIFLASH_PAGE_SIZE - offset;
+        if (chunk > length)
+            chunk = length;
+
+        cachePage* c = lookup(page);
+        if (c == 0)
+            c = load(page, lastPage);
+        for (uint32_t i = 0; i < chunk; i++)
+        {
+            dst[i] = c->data[offset + i];
+        }
+
+        nextSequential = page + 1;
+        address += chunk;
+        dst += chunk;
+        length -= chunk;
+    }
+    Mutex::unlock(&flashLock);
+    return true;
+}
+
+bool SpiFlash::write(uint32_t address, const void* data, uint32_t length) {
+    // buffered: programmed on flush() or when the page is evicted
+    const uint8_t* src = (const uint8_t*)data;
+
+    Mutex::lock(&flashLock);
+    while (length > 0)
+    {
+        uint32_t page = address / SPIFLASH_PAGE_SIZE;
+        uint32_t offset = address % SPIFLASH_PAGE_SIZE;
+        uint32_t chunk = SPIFLASH_PAGE_SIZE - offset;
+        if (chunk > length)
+            chunk = length;
+
+        cachePage* c = lookup(page);
+        if (c == 0)
+            c = load(page, page);
+        for (uint32_t i = 0; i < chunk; i++)
+        {
+            c->data[offset + i] &= src[i];
+        }
+        if (offset < c->dirtyStart)
+            c->dirtyStart = offset;
+        if (offset + chunk > c->dirtyEnd)
+            c->dirtyEnd = offset + chunk;
+
+        address += chunk;
+        src += chunk;
+        length -= chunk;
+    }
+    Mutex::unlock(&flashLock);
+    return true;
+}
+
+bool SpiFlash::eraseSector(uint32_t address) {
+    uint32_t first = (address / SPIFLASH_SECTOR_SIZE) * (SPIFLASH_SECTOR_SIZE / SPIFLASH_PAGE_SIZE);
+
+    Mutex::lock(&flashLock);
+    // pending writes to this sector are moot; drop its pages
+    for (uint8_t i = 0; i < SPIFLASH_CACHE_PAGES; i++)
+    {
+        if (cache[i].page != NO_PAGE && cache[i].page - first < SPIFLASH_SECTOR_SIZE / SPIFLASH_PAGE_SIZE)
+        {
+            cache[i].page = NO_PAGE;
+            cache[i].dirtyStart = SPIFLASH_PAGE_SIZE;
+            cache[i].dirtyEnd = 0;
+        }
+    }
+
+    writeEnable();
+    select();
+    sendCommand(CMD_SE, first * SPIFLASH_PAGE_SIZE, true);
+    deselect();
+    waitReady(10);
+    Mutex::unlock(&flashLock);
+    return true;
+}
+
+bool SpiFlash::flush() {
+    bool ok = true;
+    Mutex::lock(&flashLock);
+    for (uint8_t i = 0; i < SPIFLASH_CACHE_PAGES; i++)
+    {
+        ok &= programDirty(&cache[i]);
+    }
+    Mutex::unlock(&flashLock);
+    return ok;
+}
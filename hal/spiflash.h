@@ -0,0 +1,58 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef SPIFLASH_H
+#define SPIFLASH_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// SPI NOR Flash Block Device
+//-----------------------------------------------------------------------------
+
+/// SPI NOR flash on the shared SSI0 bus (spibus.h), chip select on PA3, with
+/// a small page cache in SRAM.
+///
+/// Data phases run on the uDMA while the calling task blocks. Pages are kept
+/// in an LRU cache; a miss that continues a sequential run also fetches the
+/// following pages in the same read command. Writes are merged into cached
+/// pages and only the dirty span of each page is programmed on flush(), so
+/// many small writes to a page cost a single page program. As on the device,
+/// writes can only clear bits: the cached copy is ANDed with new data.
+
+#define SPIFLASH_PAGE_SIZE     256
+#define SPIFLASH_SECTOR_SIZE   4096
+#define SPIFLASH_CACHE_PAGES   8      // 2 KB of SRAM
+#define SPIFLASH_READ_AHEAD    2      // extra pages fetched on a sequential miss
+
+/// Class for SPI flash
+class SpiFlash
+{
+public:
+    static void init();
+    static bool read(uint32_t address, void* data, uint32_t length);
+    static bool write(uint32_t address, const void* data, uint32_t length);
+    static bool eraseSector(uint32_t address);
+    static bool flush();
+    static void invalidate();
+};
+
+#endif // SPIFLASH_H
@@ -0,0 +1,247 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "uart.h"
+#include "udma.h"
+#include "port.h"
+#include "rtos.h"
+#include "sync.h"
+#include "tm4c123gh6pm.h"
+
+#define RX_CONTROL  (UDMA_PERIPH_TO_MEM_8 | UDMA_CHCTL_ARBSIZE_8 | UDMA_CHCTL_XFERMODE_PINGPONG)
+#define TX_CONTROL  (UDMA_MEM_TO_PERIPH_8 | UDMA_CHCTL_ARBSIZE_4 | UDMA_CHCTL_XFERMODE_BASIC)
+
+// Define variables
+static uint8_t rxBuf[2 * UART_RX_BLOCK];     // ping-pong halves, back to back
+static volatile uint32_t rxBlocks;     // halves completed since init
+static volatile uint8_t rxActive;      // half the DMA is filling
+static volatile bool rxIdle;           // receive time-out seen, not yet consumed
+static uint32_t rxRead;                // free-running read position
+static uint32_t rxOverruns;
+static volatile uint8_t rxWaiter = NO_TASK;
+static volatile uint8_t txWaiter = NO_TASK;
+static mutex txLock;
+static mutex rxLock;
+
+// free-running count of bytes the DMA has stored
+static uint32_t rxWritten() {
+    uint32_t primask = disableInterrupts();
+    uint32_t written = rxBlocks * UART_RX_BLOCK + UART_RX_BLOCK - Udma::remaining(UDMA_CH_UART0RX, rxActive);
+    restoreInterrupts(primask);
+    return written;
+}
+
+static void rxArm(uint8_t half) {
+    Udma::setTransfer(UDMA_CH_UART0RX, half, RX_CONTROL, &UART0_DR_R, &rxBuf[half * UART_RX_BLOCK], UART_RX_BLOCK);
+}
+
+// once the DMA has drained the tail, go back to bursts and time-outs
+static bool rxRearm() {
+    uint32_t primask = disableInterrupts();
+    bool drained = (UART0_FR_R & UART_FR_RXFE) != 0;
+    if (drained)
+    {
+        rxIdle = false;
+        UDMA_USEBURSTSET_R = 1u << UDMA_CH_UART0RX;
+        UART0_IM_R |= UART_IM_RTIM;
+    }
+    restoreInterrupts(primask);
+    return drained;
+}
+
+static void wake(volatile uint8_t* waiter) {
+    uint8_t task = *waiter;
+    if (task != NO_TASK)
+    {
+        *waiter = NO_TASK;
+        RTOS::notify(task);
+    }
+}
+
+extern "C" void UART0_Handler() {
+    uint32_t mis = UART0_MIS_R;
+    UART0_ICR_R = mis;
+
+    uint32_t done = UDMA_CHIS_R & ((1u << UDMA_CH_UART0RX) | (1u << UDMA_CH_UART0TX));
+    UDMA_CHIS_R = done;
+
+    if (done & (1u << UDMA_CH_UART0RX))
+    {
+        // re-arm every half that has filled; the DMA is already on the other one
+        while (Udma::remaining(UDMA_CH_UART0RX, rxActive) == 0)
+        {
+            rxArm(rxActive);
+            rxActive ^= 1;
+            rxBlocks++;
+        }
+        wake(&rxWaiter);
+    }
+
+    if (mis & UART_MIS_RTMIS)
+    {
+        // line idle with a tail shorter than a burst: let single requests drain
+        // it, and leave time-outs off until the reader has seen the idle
+        UDMA_USEBURSTCLR_R = 1u << UDMA_CH_UART0RX;
+        UART0_IM_R &= ~UART_IM_RTIM;
+        rxIdle = true;
+        wake(&rxWaiter);
+    }
+
+    if (done & (1u << UDMA_CH_UART0TX))
+    {
+        wake(&txWaiter);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// UART0 Driver
+//-----------------------------------------------------------------------------
+
+void Uart::init(uint32_t baud) {
+    // call after hwInit (pins, clocks) and Udma::init
+    Mutex::init(&txLock);
+    Mutex::init(&rxLock);
+    rxBlocks = 0;
+    rxActive = 0;
+    rxIdle = false;
+    rxRead = 0;
+    rxOverruns = 0;
+
+    // baud divisor in 1/64ths: clk / (16 * baud) * 64, rounded
+    uint32_t divisor = (SYSTEM_CLOCK * 4 + baud / 2) / baud;
+
+    UART0_CTL_R  = 0;                                   // turn-off UART0 to allow safe programming
+    UART0_CC_R   = UART_CC_CS_SYSCLK;
+    UART0_IBRD_R = divisor >> 6;
+    UART0_FBRD_R = divisor & 63;
+    UART0_LCRH_R = UART_LCRH_WLEN_8 | UART_LCRH_FEN;    // 8N1 w/ 16-level FIFO
+    UART0_IFLS_R = UART_IFLS_RX4_8 | UART_IFLS_TX4_8;   // DMA burst at half full
+    // no DMAERR: a framing error or break (a peer at the wrong baud rate,
+    // a terminal plugged in) must not stop receive DMA for good
+    UART0_DMACTL_R = UART_DMACTL_RXDMAE | UART_DMACTL_TXDMAE;
+    UART0_ICR_R  = 0xFFFFFFFF;
+    UART0_IM_R   = UART_IM_RTIM;                        // receive time-out only, DMA does the rest
+
+    Udma::assign(UDMA_CH_UART0RX, 0);
+    Udma::assign(UDMA_CH_UART0TX, 0);
+    UDMA_USEBURSTSET_R = 1u << UDMA_CH_UART0RX;
+    UDMA_REQMASKCLR_R = (1u << UDMA_CH_UART0RX) | (1u << UDMA_CH_UART0TX);
+    rxArm(0);
+    rxArm(1);
+    Udma::enable(UDMA_CH_UART0RX);
+
+    NVIC_EN0_R = 1 << 5;                                // turn-on interrupt 21 (UART0)
+    UART0_CTL_R = UART_CTL_TXE | UART_CTL_RXE | UART_CTL_UARTEN;
+}
+
+uint32_t Uart::available() {
+    return rxWritten() - rxRead;
+}
+
+uint32_t Uart::overruns() {
+    return rxOverruns;
+}
+
+uint32_t Uart::read(void* data, uint32_t length, uint32_t timeout) {
+    // returns once length bytes arrived, the receive time-out marked the line
+    // idle after some data, or the timeout expired; returns the bytes copied
+    uint8_t* dst = (uint8_t*)data;
+    uint32_t count = 0;
+    uint32_t start = tickCount;
+
+    Mutex::lock(&rxLock);
+    while (count < length)
+    {
+        // sample the idle state before the data, so the copy covers the tail
+        bool drained = rxIdle && rxRearm();
+        uint32_t written = rxWritten();
+        if (written - rxRead > 2 * UART_RX_BLOCK)
+        {
+            // reader fell a full ring behind; skip to the oldest intact byte
+            rxOverruns++;
+            rxRead = written - 2 * UART_RX_BLOCK;
+        }
+        while (rxRead != written && count < length)
+        {
+            dst[count++] = rxBuf[rxRead % (2 * UART_RX_BLOCK)];
+            rxRead++;
+        }
+        if (count == length || (drained && count > 0))
+            break;
+
+        uint32_t elapsed = tickCount - start;
+        if (timeout == NO_WAIT || (timeout != WAIT_FOREVER && elapsed >= timeout))
+            break;
+        uint32_t wait = (timeout == WAIT_FOREVER) ? WAIT_FOREVER : timeout - elapsed;
+        if (rxIdle)
+        {
+            // the tail is a few byte times from drained; poll for it each tick
+            wait = 1;
+        }
+        rxWaiter = taskCurrent;
+        if (rxWritten() == written)
+            RTOS::waitNotify(wait);
+        rxWaiter = NO_TASK;
+    }
+    Mutex::unlock(&rxLock);
+    return count;
+}
+
+uint32_t Uart::write(const void* data, uint32_t length, uint32_t timeout) {
+    // DMAs from the caller's buffer, which must stay valid until this returns;
+    // returns the number of bytes handed to the UART
+    const uint8_t* src = (const uint8_t*)data;
+    uint32_t count = 0;
+    uint32_t start = tickCount;
+
+    Mutex::lock(&txLock);
+    while (count < length)
+    {
+        uint32_t chunk = length - count;
+        if (chunk > UDMA_MAX_TRANSFER)
+            chunk = UDMA_MAX_TRANSFER;
+
+        txWaiter = taskCurrent;
+        Udma::setTransfer(UDMA_CH_UART0TX, false, TX_CONTROL, src + count, &UART0_DR_R, chunk);
+        Udma::enable(UDMA_CH_UART0TX);
+
+        // completion clears the channel enable; a stale notification just loops
+        while (Udma::isEnabled(UDMA_CH_UART0TX))
+        {
+            uint32_t elapsed = tickCount - start;
+            if (timeout != WAIT_FOREVER && elapsed >= timeout)
+                break;
+            RTOS::waitNotify(timeout == WAIT_FOREVER ? WAIT_FOREVER : timeout - elapsed);
+        }
+        txWaiter = NO_TASK;
+
+        if (Udma::isEnabled(UDMA_CH_UART0TX))
+        {
+            // timed out: stop the channel and report what actually went out
+            Udma::disable(UDMA_CH_UART0TX);
+            count += chunk - Udma::remaining(UDMA_CH_UART0TX, false);
+            break;
+        }
+        count += chunk;
+    }
+    Mutex::unlock(&txLock);
+    return count;
+}
@@ -0,0 +1,56 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef UART_H
+#define UART_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// UART0 Driver
+//-----------------------------------------------------------------------------
+
+/// UART0 with FIFOs enabled and both directions on the uDMA.
+///
+/// Receive runs continuously in ping-pong mode into two halves of a ring, so
+/// the CPU is interrupted once per half rather than once per byte. Bursts of
+/// UART_RX_BURST bytes keep a short tail in the FIFO, which raises the receive
+/// time-out interrupt when the line goes idle; that ISR switches the channel
+/// to single requests so the DMA drains the tail, and wakes the reader. The
+/// reader returns with what it has once the tail is drained, then restores
+/// bursts and the time-out. Transmit DMAs straight out of the caller's buffer
+/// while the caller blocks.
+
+#define UART_RX_BLOCK      128  // bytes per ping-pong half
+#define UART_RX_BURST      8    // DMA burst, matches the 1/2 FIFO trigger level
+
+/// Class for UART0
+class Uart
+{
+public:
+    static void init(uint32_t baud);
+    static uint32_t read(void* data, uint32_t length, uint32_t timeout);
+    static uint32_t write(const void* data, uint32_t length, uint32_t timeout);
+    static uint32_t available();
+    static uint32_t overruns();
+};
+
+#endif // UART_H
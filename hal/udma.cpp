@@ -0,0 +1,86 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "udma.h"
+
+// Define variables
+struct udmaControl udmaTable[2 * UDMA_CHANNELS] __attribute__((aligned(1024)));
+
+// bytes per item for an increment field, shifted down to bits 1:0
+static uint32_t increment(uint32_t inc) {
+    return (inc == 3) ? 0 : (1u << inc);
+}
+
+//-----------------------------------------------------------------------------
+// uDMA Controller
+//-----------------------------------------------------------------------------
+
+void Udma::init() {
+    SYSCTL_RCGCDMA_R |= SYSCTL_RCGCDMA_R0;     // turn-on uDMA
+    (void)SYSCTL_RCGCDMA_R;                    // wait for the clock before register access
+    UDMA_CFG_R = UDMA_CFG_MASTEN;
+    UDMA_CTLBASE_R = (uint32_t)udmaTable;
+}
+
+void Udma::assign(uint8_t channel, uint8_t encoding) {
+    // select the peripheral served by a channel (4 bits per channel, 8 per map register)
+    volatile uint32_t* map = &UDMA_CHMAP0_R + (channel / 8);
+    uint32_t shift = (channel % 8) * 4;
+    *map = (*map & ~(0xFu << shift)) | ((uint32_t)encoding << shift);
+}
+
+void Udma::setTransfer(uint8_t channel, bool alternate, uint32_t control,
+                       const volatile void* src, volatile void* dst, uint32_t count) {
+    // control holds size/increment/arbitration/mode bits; count is 1..1024 items
+    struct udmaControl* c = &udmaTable[channel + (alternate ? UDMA_CHANNELS : 0)];
+    uint32_t srcStep = increment((control & UDMA_CHCTL_SRCINC_M) >> 26);
+    uint32_t dstStep = increment((control & UDMA_CHCTL_DSTINC_M) >> 30);
+
+    c->srcEnd = (const volatile uint8_t*)src + (count - 1) * srcStep;
+    c->dstEnd = (volatile uint8_t*)dst + (count - 1) * dstStep;
+    c->control = (control & ~UDMA_CHCTL_XFERSIZE_M) | ((count - 1) << UDMA_CHCTL_XFERSIZE_S);
+}
+
+uint32_t Udma::remaining(uint8_t channel, bool alternate) {
+    // items left in a control structure, 0 once it has completed
+    uint32_t control = udmaTable[channel + (alternate ? UDMA_CHANNELS : 0)].control;
+    if ((control & UDMA_CHCTL_XFERMODE_M) == UDMA_CHCTL_XFERMODE_STOP)
+        return 0;
+    return ((control & UDMA_CHCTL_XFERSIZE_M) >> UDMA_CHCTL_XFERSIZE_S) + 1;
+}
+
+void Udma::enable(uint8_t channel) {
+    UDMA_CHIS_R = 1u << channel;
+    UDMA_ENASET_R = 1u << channel;
+}
+
+void Udma::disable(uint8_t channel) {
+    UDMA_ENACLR_R = 1u << channel;
+}
+
+bool Udma::isEnabled(uint8_t channel) {
+    return (UDMA_ENASET_R & (1u << channel)) != 0;
+}
+
+void Udma::request(uint8_t channel) {
+    // software request, used by the memory-to-memory channel
+    UDMA_SWREQ_R = 1u << channel;
+}
@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef UDMA_H
+#define UDMA_H
+
+#include <stdint.h>
+#include "tm4c123gh6pm.h"
+
+//-----------------------------------------------------------------------------
+// uDMA Controller
+//-----------------------------------------------------------------------------
+
+/// Thin register-level access to the uDMA channel control table, shared by
+/// the drivers that move data without per-byte interrupts. Completion of a
+/// peripheral channel is reported on that peripheral's interrupt vector and
+/// in UDMA_CHIS_R.
+
+/// channel assignments (encoding 0 unless noted)
+#define UDMA_CH_USB0EP1TX   1
+#define UDMA_CH_USB0EP2RX   2
+#define UDMA_CH_UART0RX     8
+#define UDMA_CH_UART0TX     9
+#define UDMA_CH_SSI0RX      10
+#define UDMA_CH_SSI0TX      11
+#define UDMA_CH_ADC0SS0     14
+#define UDMA_CH_SSI1RX      24
+#define UDMA_CH_SSI1TX      25
+#define UDMA_CH_SW          30   // software channel for memory-to-memory
+
+#define UDMA_CHANNELS       32
+#define UDMA_MAX_TRANSFER   1024 // items per control structure
+
+/// common control words (add transfer mode)
+#define UDMA_MEM_TO_PERIPH_8  (UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_SRCINC_8 | UDMA_CHCTL_SRCSIZE_8)
+#define UDMA_PERIPH_TO_MEM_8  (UDMA_CHCTL_DSTINC_8 | UDMA_CHCTL_DSTSIZE_8 | UDMA_CHCTL_SRCINC_NONE | UDMA_CHCTL_SRCSIZE_8)
+#define UDMA_PERIPH_TO_MEM_16 (UDMA_CHCTL_DSTINC_16 | UDMA_CHCTL_DSTSIZE_16 | UDMA_CHCTL_SRCINC_NONE | UDMA_CHCTL_SRCSIZE_16)
+#define UDMA_MEM_TO_MEM_32    (UDMA_CHCTL_DSTINC_32 | UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_SRCINC_32 | UDMA_CHCTL_SRCSIZE_32)
+
+/// channel control structure as laid out by the hardware
+struct udmaControl
+{
+  volatile const void* srcEnd;   // address of the last source item
+  volatile void* dstEnd;         // address of the last destination item
+  volatile uint32_t control;     // UDMA_CHCTL_ fields
+  uint32_t spare;
+};
+
+/// primary structures [0..31], alternate structures [32..63]
+extern struct udmaControl udmaTable[2 * UDMA_CHANNELS];
+
+/// Class for uDMA
+class Udma
+{
+public:
+    static void init();
+    static void assign(uint8_t channel, uint8_t encoding);
+    static void setTransfer(uint8_t channel, bool alternate, uint32_t control,
+                            const volatile void* src, volatile void* dst, uint32_t count);
+    static uint32_t remaining(uint8_t channel, bool alternate);
+    static void enable(uint8_t channel);
+    static void disable(uint8_t channel);
+    static bool isEnabled(uint8_t channel);
+    static void request(uint8_t channel);
+};
+
+#endif // UDMA_H
@@ -0,0 +1,678 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+#include "usb.h"
+#include "udma.h"
+#include "port.h"
+#include "rtos.h"
+#include "tm4c123gh6pm.h"
+
+#define TX_CONTROL  (UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_SRCINC_32 | UDMA_CHCTL_SRCSIZE_32 | \
+                     UDMA_CHCTL_ARBSIZE_16 | UDMA_CHCTL_XFERMODE_BASIC)
+#define RX_CONTROL  (UDMA_CHCTL_DSTINC_32 | UDMA_CHCTL_DSTSIZE_32 | UDMA_CHCTL_SRCINC_NONE | UDMA_CHCTL_SRCSIZE_32 | \
+                     UDMA_CHCTL_ARBSIZE_16 | UDMA_CHCTL_XFERMODE_BASIC)
+#define DMA_CHUNK   (4 * UDMA_MAX_TRANSFER)     // bytes per control structure, a whole number of packets
+
+#define EP0_SIZE    64
+#define CONFIG_SIZE 67
+
+// FIFO RAM: EP0 0-63, EP1 IN 64-191 (two packets), EP2 OUT 192-319 (two packets), EP3 IN 320-335
+#define EP1_FIFO    64
+#define EP2_FIFO    192
+#define EP3_FIFO    320
+
+enum ep0State
+{
+  EP0_IDLE,
+  EP0_TX,          // sending IN data packets
+  EP0_RX,          // waiting for the OUT data packet
+  EP0_STATUS       // waiting for the status stage to complete
+};
+
+struct usbTransfer
+{
+  uint8_t *buf;                 // caller's buffer, 4-byte aligned
+  uint32_t length;
+  volatile uint32_t done;       // bytes moved so far
+  volatile bool complete;
+  bool zlp;                     // write still owes a zero-length packet
+};
+
+struct usbQueue
+{
+  usbTransfer slot[USB_QUEUE_DEPTH];
+  volatile uint8_t head;        // transfer on the hardware, advanced by the ISR
+  volatile uint8_t tail;        // next free slot, advanced by the owning task
+  uint8_t wait;                 // oldest transfer not yet collected by *Wait
+  uint32_t dmaBytes;            // bytes in the armed DMA chunk, 0 when idle
+  volatile uint8_t waiter;      // task blocked in *Wait, or NO_TASK
+};
+
+// Define variables
+static const uint8_t deviceDescriptor[18] =
+{
+    18, 1, 0x00, 0x02,              // device, USB 2.0
+    0x02, 0x00, 0x00, EP0_SIZE,     // CDC class
+    0xBE, 0x1C, 0x02, 0x00,         // VID 0x1CBE, PID 0x0002
+    0x00, 0x01, 1, 2, 3, 1          // release 1.00, strings, one configuration
+};
+
+static const uint8_t configDescriptor[CONFIG_SIZE] =
+{
+    9, 2, CONFIG_SIZE, 0, 2, 1, 0, 0x80, 50,   // two interfaces, bus powered, 100 mA
+    9, 4, 0, 0, 1, 0x02, 0x02, 0x01, 0,        // interface 0: CDC ACM, AT commands
+    5, 0x24, 0x00, 0x10, 0x01,                 // header, CDC 1.10
+    5, 0x24, 0x01, 0x00, 1,                    // call management, data on interface 1
+    4, 0x24, 0x02, 0x02,                       // ACM: line coding and serial state
+    5, 0x24, 0x06, 0, 1,                       // union: control 0, data 1
+    7, 5, 0x83, 0x03, 16, 0, 255,              // EP3 IN interrupt, serial state
+    9, 4, 1, 0, 2, 0x0A, 0x00, 0x00, 0,        // interface 1: CDC data
+    7, 5, 0x81, 0x02, USB_PACKET, 0, 0,        // EP1 IN bulk
+    7, 5, 0x02, 0x02, USB_PACKET, 0, 0         // EP2 OUT bulk
+};
+
+static const uint8_t languageDescriptor[4] = { 4, 3, 0x09, 0x04 };   // US English
+static const char* const strings[3] = { "RTOS-Framework", "RTOS-Framework CDC", "0001" };
+
+static uint8_t lineCoding[7] = { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 };    // 115200 8N1
+static const uint8_t zeros[2] = { 0, 0 };
+
+static volatile uint8_t* const fifo0 = (volatile uint8_t*)&USB0_FIFO0_R;
+static volatile uint8_t* const fifo1 = (volatile uint8_t*)&USB0_FIFO1_R;
+static volatile uint8_t* const fifo2 = (volatile uint8_t*)&USB0_FIFO2_R;
+
+static uint8_t ep0Buf[EP0_SIZE];      // string descriptors are built here
+static uint8_t ep0;                   // ep0State
+static const uint8_t* ep0Data;
+static uint32_t ep0Left;
+static bool ep0Zlp;                   // reply is shorter than asked for and ends on a packet boundary
+static uint8_t address;
+static bool addressPending;
+static uint8_t configuration;
+static volatile bool configured;
+static volatile uint16_t controlLines;
+static usbQueue tx;
+static usbQueue rx;
+
+static void wake(volatile uint8_t* waiter) {
+    uint8_t task = *waiter;
+    if (task != NO_TASK)
+    {
+        *waiter = NO_TASK;
+        RTOS::notify(task);
+    }
+}
+
+static void finish(usbQueue* q) {
+    q->slot[q->head % USB_QUEUE_DEPTH].complete = true;
+    q->head++;
+    wake(&q->waiter);
+}
+
+//-----------------------------------------------------------------------------
+// Bulk IN (EP1)
+//-----------------------------------------------------------------------------
+
+static void txDma(bool on) {
+    if (on)
+    {
+        USB0_TXCSRH1_R = USB_TXCSRH1_MODE | USB_TXCSRH1_AUTOSET | USB_TXCSRH1_DMAEN | USB_TXCSRH1_DMAMOD;
+    }
+    else
+    {
+        // DMAEN must drop before DMAMOD
+        USB0_TXCSRH1_R = USB_TXCSRH1_MODE | USB_TXCSRH1_DMAMOD;
+        USB0_TXCSRH1_R = USB_TXCSRH1_MODE;
+    }
+}
+
+// runs in the ISR or with interrupts disabled
+static void txNext() {
+    while (configured && tx.head != tx.tail)
+    {
+        usbTransfer* t = &tx.slot[tx.head % USB_QUEUE_DEPTH];
+        uint32_t left = t->length - t->done;
+
+        if (left >= USB_PACKET)
+        {
+            // whole packets: AUTOSET commits each one as the DMA fills it
+            uint32_t chunk = left & ~(uint32_t)(USB_PACKET - 1);
+            if (chunk > DMA_CHUNK)
+                chunk = DMA_CHUNK;
+            Udma::setTransfer(UDMA_CH_USB0EP1TX, false, TX_CONTROL, t->buf + t->done, &USB0_FIFO1_R, chunk / 4);
+            Udma::enable(UDMA_CH_USB0EP1TX);
+            tx.dmaBytes = chunk;
+            txDma(true);
+            return;
+        }
+
+        if (left > 0 || t->zlp)
+        {
+            // short tail or ZLP by CPU once a packet buffer is free; the EP1 interrupt resumes here
+            if (USB0_TXCSRL1_R & USB_TXCSRL1_TXRDY)
+                return;
+            txDma(false);
+            for (uint32_t i = 0; i < left; i++)
+                *fifo1 = t->buf[t->done + i];
+            USB0_TXCSRL1_R = USB_TXCSRL1_TXRDY;
+            t->done += left;
+            t->zlp = false;
+        }
+        finish(&tx);
+    }
+}
+
+static void txAbort() {
+    usbTransfer* t = &tx.slot[tx.head % USB_QUEUE_DEPTH];
+    if (tx.dmaBytes)
+    {
+        // bursts are whole packets, so done stays on a packet boundary
+        Udma::disable(UDMA_CH_USB0EP1TX);
+        t->done += tx.dmaBytes - 4 * Udma::remaining(UDMA_CH_USB0EP1TX, false);
+        tx.dmaBytes = 0;
+        txDma(false);
+    }
+    finish(&tx);
+    txNext();
+}
+
+//-----------------------------------------------------------------------------
+// Bulk OUT (EP2)
+//-----------------------------------------------------------------------------
+
+static void rxDma(bool on) {
+    if (on)
+    {
+        USB0_RXCSRH2_R = USB_RXCSRH2_AUTOCL | USB_RXCSRH2_DMAEN | USB_RXCSRH2_DMAMOD;
+    }
+    else
+    {
+        USB0_RXCSRH2_R = USB_RXCSRH2_DMAMOD;
+        USB0_RXCSRH2_R = 0;
+    }
+}
+
+// runs in the ISR or with interrupts disabled
+static void rxNext() {
+    while (configured && rx.head != rx.tail)
+    {
+        usbTransfer* t = &rx.slot[rx.head % USB_QUEUE_DEPTH];
+        uint32_t room = t->length - t->done;
+
+        if (room > 0)
+        {
+            if ((USB0_RXCSRL2_R & USB_RXCSRL2_RXRDY) && USB0_RXCOUNT2_R < USB_PACKET)
+            {
+                // short packet (or ZLP) at the head of the FIFO ends the transfer; room >= USB_PACKET
+                uint32_t count = USB0_RXCOUNT2_R;
+                for (uint32_t i = 0; i < count; i++)
+                    t->buf[t->done + i] = *fifo2;
+                USB0_RXCSRL2_R = 0;
+                t->done += count;
+            }
+            else
+            {
+                // whole packets: mode 1 requests one burst per packet and AUTOCL releases it
+                uint32_t chunk = room > DMA_CHUNK ? DMA_CHUNK : room;
+                Udma::setTransfer(UDMA_CH_USB0EP2RX, false, RX_CONTROL, &USB0_FIFO2_R, t->buf + t->done, chunk / 4);
+                Udma::enable(UDMA_CH_USB0EP2RX);
+                rx.dmaBytes = chunk;
+                rxDma(true);
+                return;
+            }
+        }
+        finish(&rx);
+    }
+    // nothing posted: packets stay in the FIFO and the host is NAKed
+    rxDma(false);
+}
+
+static void rxStop() {
+    usbTransfer* t = &rx.slot[rx.head % USB_QUEUE_DEPTH];
+    Udma::disable(UDMA_CH_USB0EP2RX);
+    t->done += rx.dmaBytes - 4 * Udma::remaining(UDMA_CH_USB0EP2RX, false);
+    rx.dmaBytes = 0;
+}
+
+static void rxAbort() {
+    if (rx.dmaBytes)
+        rxStop();
+    finish(&rx);
+    rxNext();
+}
+
+//-----------------------------------------------------------------------------
+// Control (EP0)
+//-----------------------------------------------------------------------------
+
+static void configure(uint8_t value) {
+    configuration = value;
+    configured = false;
+    while (tx.head != tx.tail)
+        txAbort();
+    while (rx.head != rx.tail)
+        rxAbort();
+    if (value == 0)
+        return;
+
+    USB0_EPIDX_R = 1;
+    USB0_TXFIFOSZ_R = USB_TXFIFOSZ_DPB | USB_TXFIFOSZ_SIZE_64;
+    USB0_TXFIFOADD_R = EP1_FIFO / 8;
+    USB0_EPIDX_R = 2;
+    USB0_RXFIFOSZ_R = USB_RXFIFOSZ_DPB | USB_RXFIFOSZ_SIZE_64;
+    USB0_RXFIFOADD_R = EP2_FIFO / 8;
+    USB0_EPIDX_R = 3;
+    USB0_TXFIFOSZ_R = USB_TXFIFOSZ_SIZE_16;
+    USB0_TXFIFOADD_R = EP3_FIFO / 8;
+
+    USB0_TXMAXP1_R = USB_PACKET;
+    USB0_TXCSRH1_R = USB_TXCSRH1_MODE;
+    USB0_TXCSRL1_R = USB_TXCSRL1_CLRDT;
+    USB0_RXMAXP2_R = USB_PACKET;
+    USB0_RXCSRH2_R = 0;
+    USB0_RXCSRL2_R = USB_RXCSRL2_CLRDT;
+    USB0_TXMAXP3_R = 16;
+    USB0_TXCSRH3_R = USB_TXCSRH3_MODE;
+    USB0_TXCSRL3_R = USB_TXCSRL3_CLRDT;
+    configured = true;
+}
+
+static void ep0Load() {
+    uint32_t count = ep0Left < EP0_SIZE ? ep0Left : EP0_SIZE;
+    for (uint32_t i = 0; i < count; i++)
+        *fifo0 = ep0Data[i];
+    ep0Data += count;
+    ep0Left -= count;
+
+    if (ep0Left == 0 && !(count == EP0_SIZE && ep0Zlp))
+    {
+        USB0_CSRL0_R = USB_CSRL0_TXRDY | USB_CSRL0_DATAEND;
+        ep0 = EP0_STATUS;
+    }
+    else
+    {
+        USB0_CSRL0_R = USB_CSRL0_TXRDY;
+        ep0 = EP0_TX;
+    }
+}
+
+static void ep0Reply(const uint8_t* data, uint32_t length, uint16_t requested) {
+    USB0_CSRL0_R = USB_CSRL0_RXRDYC;
+    ep0Data = data;
+    ep0Left = length < requested ? length : requested;
+    ep0Zlp = ep0Left < requested && ep0Left % EP0_SIZE == 0;
+    ep0Load();
+}
+
+static void ep0Ack() {
+    USB0_CSRL0_R = USB_CSRL0_RXRDYC | USB_CSRL0_DATAEND;
+    ep0 = EP0_STATUS;
+}
+
+static void ep0Stall() {
+    USB0_CSRL0_R = USB_CSRL0_RXRDYC | USB_CSRL0_STALL;
+    ep0 = EP0_IDLE;
+}
+
+static void ep0String(uint8_t index, uint16_t requested) {
+    if (index == 0)
+    {
+        ep0Reply(languageDescriptor, sizeof(languageDescriptor), requested);
+        return;
+    }
+    if (index > 3)
+    {
+        ep0Stall();
+        return;
+    }
+    // ASCII to UTF-16LE
+    const char* s = strings[index - 1];
+    uint32_t length = 2;
+    while (*s && length < EP0_SIZE)
+    {
+        ep0Buf[length++] = *s++;
+        ep0Buf[length++] = 0;
+    }
+    ep0Buf[0] = length;
+    ep0Buf[1] = 3;
+    ep0Reply(ep0Buf, length, requested);
+}
+
+static void ep0Setup() {
+    uint8_t setup[8];
+    for (uint8_t i = 0; i < 8; i++)
+        setup[i] = *fifo0;
+    uint8_t type = setup[0];
+    uint8_t request = setup[1];
+    uint16_t value = setup[2] | setup[3] << 8;
+    uint16_t index = setup[4] | setup[5] << 8;
+    uint16_t length = setup[6] | setup[7] << 8;
+
+    if ((type & 0x60) == 0x20)
+    {
+        // CDC class requests
+        switch (request)
+        {
+        case 0x20:                                  // SET_LINE_CODING
+            USB0_CSRL0_R = USB_CSRL0_RXRDYC;
+            ep0 = EP0_RX;
+            break;
+        case 0x21:                                  // GET_LINE_CODING
+            ep0Reply(lineCoding, sizeof(lineCoding), length);
+            break;
+        case 0x22:                                  // SET_CONTROL_LINE_STATE
+            controlLines = value;
+            ep0Ack();
+            break;
+        case 0x23:                                  // SEND_BREAK
+            ep0Ack();
+            break;
+        default:
+            ep0Stall();
+        }
+        return;
+    }
+    if ((type & 0x60) != 0)
+    {
+        ep0Stall();
+        return;
+    }
+
+    switch (request)
+    {
+    case 0x00:                                      // GET_STATUS
+        ep0Reply(zeros, 2, length);
+        break;
+    case 0x01:                                      // CLEAR_FEATURE
+        if ((type & 0x1F) == 2 && (index & 0x7F) == 1)
+            USB0_TXCSRL1_R = USB_TXCSRL1_CLRDT;
+        else if ((type & 0x1F) == 2 && (index & 0x7F) == 2)
+            USB0_RXCSRL2_R = USB_RXCSRL2_CLRDT;
+        ep0Ack();
+        break;
+    case 0x03:                                      // SET_FEATURE
+    case 0x0B:                                      // SET_INTERFACE
+        ep0Ack();
+        break;
+    case 0x05:                                      // SET_ADDRESS, applied after the status stage
+        address = value & 0x7F;
+        addressPending = true;
+        ep0Ack();
+        break;
+    case 0x06:                                      // GET_DESCRIPTOR
+        switch (value >> 8)
+        {
+        case 1:
+            ep0Reply(deviceDescriptor, sizeof(deviceDescriptor), length);
+            break;
+        case 2:
+            ep0Reply(configDescriptor, sizeof(configDescriptor), length);
+            break;
+        case 3:
+            ep0String(value & 0xFF, length);
+            break;
+        default:
+            ep0Stall();
+        }
+        break;
+    case 0x08:                                      // GET_CONFIGURATION
+        ep0Reply(&configuration, 1, length);
+        break;
+    case 0x09:                                      // SET_CONFIGURATION
+        if (value > 1)
+        {
+            ep0Stall();
+            break;
+        }
+        configure(value);
+        ep0Ack();
+        break;
+    case 0x0A:                                      // GET_INTERFACE
+        ep0Reply(zeros, 1, length);
+        break;
+    default:
+        ep0Stall();
+    }
+}
+
+static void ep0Interrupt() {
+    uint8_t csr = USB0_CSRL0_R;
+
+    if (csr & USB_CSRL0_STALLED)
+    {
+        USB0_CSRL0_R = csr & ~USB_CSRL0_STALLED;
+        ep0 = EP0_IDLE;
+        return;
+    }
+    if (csr & USB_CSRL0_SETEND)
+    {
+        // host ended the transfer early
+        USB0_CSRL0_R = USB_CSRL0_SETENDC;
+        ep0 = EP0_IDLE;
+    }
+
+    switch (ep0)
+    {
+    case EP0_STATUS:
+        if (addressPending)
+        {
+            USB0_FADDR_R = address;
+            addressPending = false;
+        }
+        ep0 = EP0_IDLE;
+        break;
+    case EP0_TX:
+        ep0Load();
+        return;
+    case EP0_RX:
+        if (csr & USB_CSRL0_RXRDY)
+        {
+            uint8_t count = USB0_COUNT0_R;
+            for (uint8_t i = 0; i < count; i++)
+            {
+                uint8_t b = *fifo0;
+                if (i < sizeof(lineCoding))
+                    lineCoding[i] = b;
+            }
+            ep0Ack();
+        }
+        return;
+    }
+
+    if (csr & USB_CSRL0_RXRDY)
+        ep0Setup();
+}
+
+static void busReset() {
+    addressPending = false;
+    ep0 = EP0_IDLE;
+    controlLines = 0;
+    configure(0);
+}
+
+extern "C" void USB0_Handler() {
+    uint8_t is = USB0_IS_R;
+    uint16_t txis = USB0_TXIS_R;
+    uint16_t rxis = USB0_RXIS_R;
+
+    uint32_t done = UDMA_CHIS_R & ((1u << UDMA_CH_USB0EP1TX) | (1u << UDMA_CH_USB0EP2RX));
+    UDMA_CHIS_R = done;
+
+    if (is & USB_IS_RESET)
+        busReset();
+
+    if (txis & USB_TXIS_EP0)
+        ep0Interrupt();
+
+    if (done & (1u << UDMA_CH_USB0EP1TX))
+    {
+        tx.slot[tx.head % USB_QUEUE_DEPTH].done += tx.dmaBytes;
+        tx.dmaBytes = 0;
+        txNext();
+    }
+    else if ((txis & USB_TXIS_EP1) && tx.dmaBytes == 0)
+    {
+        // a packet buffer freed up for a pending short tail or ZLP
+        txNext();
+    }
+
+    if (done & (1u << UDMA_CH_USB0EP2RX))
+    {
+        rx.slot[rx.head % USB_QUEUE_DEPTH].done += rx.dmaBytes;
+        rx.dmaBytes = 0;
+        rxNext();
+    }
+    else if (rxis & USB_RXIS_EP2)
+    {
+        // only short packets interrupt in DMA mode 1; stop the DMA and let rxNext end the transfer
+        if (rx.dmaBytes && (USB0_RXCSRL2_R & USB_RXCSRL2_RXRDY) && USB0_RXCOUNT2_R < USB_PACKET)
+        {
+            rxStop();
+            rxDma(false);
+        }
+        if (rx.dmaBytes == 0)
+            rxNext();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// USB0 CDC Device
+//-----------------------------------------------------------------------------
+
+static uint32_t collect(usbQueue* q, uint32_t timeout, void (*abort)()) {
+    if (q->wait == q->tail)
+        return 0;
+    usbTransfer* t = &q->slot[q->wait % USB_QUEUE_DEPTH];
+    uint32_t start = tickCount;
+
+    // completion sets the flag before notifying; a stale notification just loops
+    q->waiter = taskCurrent;
+    while (!t->complete)
+    {
+        uint32_t elapsed = tickCount - start;
+        if (timeout != WAIT_FOREVER && elapsed >= timeout)
+            break;
+        RTOS::waitNotify(timeout == WAIT_FOREVER ? WAIT_FOREVER : timeout - elapsed);
+    }
+    q->waiter = NO_TASK;
+
+    if (!t->complete)
+    {
+        // timed out: transfers complete in order, so this one is on the hardware
+        uint32_t primask = disableInterrupts();
+        if (!t->complete)
+            abort();
+        restoreInterrupts(primask);
+    }
+    q->wait++;
+    return t->done;
+}
+
+static bool post(usbQueue* q, const void* data, uint32_t length, void (*next)()) {
+    if (!configured || (uint8_t)(q->tail - q->wait) == USB_QUEUE_DEPTH || ((uintptr_t)data & 3))
+        return false;
+
+    usbTransfer* t = &q->slot[q->tail % USB_QUEUE_DEPTH];
+    t->buf = (uint8_t*)data;
+    t->length = length;
+    t->done = 0;
+    t->complete = false;
+    t->zlp = length % USB_PACKET == 0;
+
+    uint32_t primask = disableInterrupts();
+    q->tail++;
+    if ((uint8_t)(q->head + 1) == q->tail)
+        next();                                     // hardware was idle
+    restoreInterrupts(primask);
+    return true;
+}
+
+void Usb::init() {
+    // call after Udma::init; PD4/PD5 carry USB0DM/USB0DP
+    tx.waiter = NO_TASK;
+    rx.waiter = NO_TASK;
+    busReset();
+
+    SYSCTL_RCC2_R &= ~SYSCTL_RCC2_USBPWRDN;            // USB PLL on
+    SYSCTL_RCGCUSB_R |= SYSCTL_RCGCUSB_R0;
+    SYSCTL_RCGC2_R |= SYSCTL_RCGC2_GPIOD;
+    (void)SYSCTL_RCGC2_R;
+    while ((SYSCTL_PRUSB_R & SYSCTL_PRUSB_R0) == 0)
+    {
+    }
+
+    GPIO_PORTD_DEN_R &= ~0x30;
+    GPIO_PORTD_AMSEL_R |= 0x30;                         // analog function on PD4, PD5
+    USB0_GPCS_R = USB_GPCS_DEVMODOTG | USB_GPCS_DEVMOD; // device mode without the ID pin
+
+    Udma::assign(UDMA_CH_USB0EP1TX, 0);
+    Udma::assign(UDMA_CH_USB0EP2RX, 0);
+    UDMA_USEBURSTSET_R = (1u << UDMA_CH_USB0EP1TX) | (1u << UDMA_CH_USB0EP2RX);
+    UDMA_REQMASKCLR_R = (1u << UDMA_CH_USB0EP1TX) | (1u << UDMA_CH_USB0EP2RX);
+
+    USB0_TXIE_R = USB_TXIE_EP0 | USB_TXIE_EP1;
+    USB0_RXIE_R = USB_RXIE_EP2;
+    USB0_IE_R = USB_IE_RESET;
+    NVIC_EN1_R = 1 << 12;                               // turn-on interrupt 60 (USB0)
+    USB0_POWER_R |= USB_POWER_SOFTCONN;
+}
+
+bool Usb::connected() {
+    return configured;
+}
+
+uint16_t Usb::lineState() {
+    // bit 0 DTR, bit 1 RTS, as last set by the host
+    return controlLines;
+}
+
+bool Usb::writeStart(const void* data, uint32_t length) {
+    return post(&tx, data, length, txNext);
+}
+
+uint32_t Usb::writeWait(uint32_t timeout) {
+    return collect(&tx, timeout, txAbort);
+}
+
+bool Usb::readStart(void* data, uint32_t length) {
+    // whole packets only, so a full-size packet always fits
+    length &= ~(uint32_t)(USB_PACKET - 1);
+    if (length == 0)
+        return false;
+    return post(&rx, data, length, rxNext);
+}
+
+uint32_t Usb::readWait(uint32_t timeout) {
+    return collect(&rx, timeout, rxAbort);
+}
+
+uint32_t Usb::write(const void* data, uint32_t length, uint32_t timeout) {
+    if (!writeStart(data, length))
+        return 0;
+    return writeWait(timeout);
+}
+
+uint32_t Usb::read(void* data, uint32_t length, uint32_t timeout) {
+    if (!readStart(data, length))
+        return 0;
+    return readWait(timeout);
+}
@@ -0,0 +1,71 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+#ifndef USB_H
+#define USB_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// USB0 CDC Device
+//-----------------------------------------------------------------------------
+
+/// Full-speed CDC ACM device driven at register level, bypassing usblib's
+/// byte-wise ring buffers. Bulk IN (EP1) and bulk OUT (EP2) use double-packet
+/// FIFOs and uDMA request mode 1, so whole runs of 64-byte packets move
+/// straight between the caller's buffer and the FIFO without the CPU.
+///
+/// Transfers are zero-copy: *Start queues a caller-owned buffer (4-byte
+/// aligned, left untouched until the matching *Wait returns) and *Wait blocks
+/// the task until the oldest queued buffer completes. Up to USB_QUEUE_DEPTH
+/// buffers may be queued per direction; the ISR chains straight into the next
+/// one, so a task that keeps two buffers in flight keeps the bus saturated.
+/// Each direction must be owned by one task.
+///
+/// A write ends with a short packet, or a zero-length packet when its length
+/// is a nonzero multiple of USB_PACKET. A read completes when its buffer is
+/// full or the host ends the transfer with a short packet; read lengths are
+/// rounded down to whole packets so any packet fits.
+
+#define USB_PACKET         64   // bulk max packet size
+#define USB_QUEUE_DEPTH    2    // buffers queued per direction
+
+/// Class for USB0 CDC device
+class Usb
+{
+public:
+    static void init();
+    static bool connected();
+    static uint16_t lineState();
+
+    // zero-copy
+    static bool writeStart(const void* data, uint32_t length);
+    static uint32_t writeWait(uint32_t timeout);
+    static bool readStart(void* data, uint32_t length);
+    static uint32_t readWait(uint32_t timeout);
+
+    // blocking
+    static uint32_t write(const void* data, uint32_t length, uint32_t timeout);
+    static uint32_t read(void* data, uint32_t length, uint32_t timeout);
+};
+
+#endif // USB_H
@@ -0,0 +1,172 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "crc.h"
+
+static_assert(CRC_SLICES == 4 || CRC_SLICES == 8, "CRC_SLICES must be 4 or 8");
+
+#define CRC32_POLY      0xEDB88320u     // reflected 0x04C11DB7
+#define CRC16_POLY      0x8408u         // reflected 0x1021
+
+// t[0] is the classic byte table; t[s][i] is the CRC of byte i followed by
+// s zero bytes, so CRC_SLICES table lookups advance CRC_SLICES bytes at once
+template <typename T>
+struct crcTables
+{
+  T t[CRC_SLICES][256];
+  T x2n[32];              // x^(2^n) mod P, for combine
+};
+
+template <typename T>
+static constexpr T multModP(T a, T b, T poly) {
+    // a * b mod P in the reflected representation (bit W-1 is x^0)
+    T m = (T)1 << (sizeof(T) * 8 - 1);
+    T p = 0;
+    while (m != 0)
+    {
+        if (a & m)
+            p ^= b;
+        m >>= 1;
+        b = (b & 1) ? (T)((b >> 1) ^ poly) : (T)(b >> 1);
+    }
+    return p;
+}
+
+// fills r in place, so Crc::init() needs no table-sized temporary on the stack
+template <typename T>
+static constexpr void fillTables(crcTables<T>& r, T poly) {
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        T c = (T)i;
+        for (uint8_t k = 0; k < 8; k++)
+        {
+            c = (c & 1) ? (T)((c >> 1) ^ poly) : (T)(c >> 1);
+        }
+        r.t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        for (uint8_t s = 1; s < CRC_SLICES; s++)
+        {
+            T c = r.t[s - 1][i];
+            r.t[s][i] = (T)((c >> 8) ^ r.t[0][c & 0xFF]);
+        }
+    }
+    T p = (T)1 << (sizeof(T) * 8 - 2);    // x^1
+    r.x2n[0] = p;
+    for (uint8_t n = 1; n < 32; n++)
+    {
+        p = multModP<T>(p, p, poly);
+        r.x2n[n] = p;
+    }
+}
+
+template <typename T>
+static constexpr crcTables<T> makeTables(T poly) {
+    crcTables<T> r = {};
+    fillTables<T>(r, poly);
+    return r;
+}
+
+// Define variables
+#ifdef CRC_TABLES_SRAM
+static crcTables<uint32_t> crc32Tables;
+static crcTables<uint16_t> crc16Tables;
+#else
+static constexpr crcTables<uint32_t> crc32Tables = makeTables<uint32_t>(CRC32_POLY);
+static constexpr crcTables<uint16_t> crc16Tables = makeTables<uint16_t>(CRC16_POLY);
+#endif
+
+//-----------------------------------------------------------------------------
+// Slice-by-N Update
+//-----------------------------------------------------------------------------
+
+static inline uint32_t load32(const uint8_t* p) {
+    uint32_t w;
+    __builtin_memcpy(&w, p, 4);     // a single LDR on the Cortex-M4
+    return w;
+}
+
+template <typename T>
+static T update(const crcTables<T>& tables, T crc, const uint8_t* p, uint32_t length) {
+    const T (*t)[256] = tables.t;
+    crc = (T)~crc;
+    while (length >= CRC_SLICES)
+    {
+        uint32_t one = load32(p) ^ crc;
+#if CRC_SLICES == 8
+        uint32_t two = load32(p + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+            ^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+#else
+        crc = t[3][one & 0xFF] ^ t[2][(one >> 8) & 0xFF] ^ t[1][(one >> 16) & 0xFF] ^ t[0][one >> 24];
+#endif
+        p += CRC_SLICES;
+        length -= CRC_SLICES;
+    }
+    while (length-- > 0)
+    {
+        crc = (T)((crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF]);
+    }
+    return (T)~crc;
+}
+
+template <typename T>
+static T combine(const crcTables<T>& tables, T poly, T crcA, T crcB, uint32_t lengthB) {
+    // shift crcA past lengthB zero bytes: multiply by x^(8 * lengthB) mod P
+    T p = (T)1 << (sizeof(T) * 8 - 1);    // x^0
+    uint8_t k = 3;                        // 8 = 2^3
+    while (lengthB != 0)
+    {
+        if (lengthB & 1)
+            p = multModP<T>(tables.x2n[k & 31], p, poly);
+        lengthB >>= 1;
+        k++;
+    }
+    return (T)(multModP<T>(p, crcA, poly) ^ crcB);
+}
+
+//-----------------------------------------------------------------------------
+// CRC Engines
+//-----------------------------------------------------------------------------
+
+void Crc::init() {
+#ifdef CRC_TABLES_SRAM
+    fillTables<uint32_t>(crc32Tables, CRC32_POLY);
+    fillTables<uint16_t>(crc16Tables, CRC16_POLY);
+#endif
+}
+
+uint32_t Crc::crc32(uint32_t crc, const void* data, uint32_t length) {
+    return update<uint32_t>(crc32Tables, crc, (const uint8_t*)data, length);
+}
+
+uint16_t Crc::crc16(uint16_t crc, const void* data, uint32_t length) {
+    return update<uint16_t>(crc16Tables, crc, (const uint8_t*)data, length);
+}
+
+uint32_t Crc::combine32(uint32_t crcA, uint32_t crcB, uint32_t lengthB) {
+    return combine<uint32_t>(crc32Tables, CRC32_POLY, crcA, crcB, lengthB);
+}
+
+uint16_t Crc::combine16(uint16_t crcA, uint16_t crcB, uint32_t lengthB) {
+    return combine<uint16_t>(crc16Tables, CRC16_POLY, crcA, crcB, lengthB);
+}
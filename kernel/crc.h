@@ -0,0 +1,58 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// CRC Engines
+//-----------------------------------------------------------------------------
+
+/// Table-driven CRC-32 (IEEE 802.3) and CRC-16/X.25 (PPP FCS-16), consuming
+/// CRC_SLICES bytes per step with one table per byte (slice-by-4 or -8).
+/// Words are loaded whole, which the Cortex-M4 does unaligned for free.
+///
+/// Both are streaming: start from 0 and feed the previous result back in, so
+/// crc32(crc32(0, a), b) is the CRC of a followed by b. combine32/16 give the
+/// same result from the two CRCs and the length of b alone.
+///
+/// Tables live in flash, built at compile time. Define CRC_TABLES_SRAM to
+/// build them into SRAM at Crc::init() instead, which avoids flash wait states
+/// above 40 MHz at the cost of the table RAM.
+
+#ifndef CRC_SLICES
+#define CRC_SLICES      8       // 4: 1K + 512 bytes per slice table set, 8: twice that
+#endif
+
+/// Class for CRC engines
+class Crc
+{
+public:
+    static void init();
+    static uint32_t crc32(uint32_t crc, const void* data, uint32_t length);
+    static uint16_t crc16(uint16_t crc, const void* data, uint32_t length);
+    static uint32_t combine32(uint32_t crcA, uint32_t crcB, uint32_t lengthB);
+    static uint16_t combine16(uint16_t crcA, uint16_t crcB, uint32_t lengthB);
+};
+
+#endif // CRC_H
@@ -0,0 +1,139 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "introspect.h"
+#include "sync.h"
+#include "streambuf.h"
+
+struct registeredObject
+{
+  const char* name;
+  uint8_t type;
+  void* object;
+};
+
+// Define variables
+static registeredObject registry[MAX_OBJECTS];
+static uint8_t registered;
+
+//-----------------------------------------------------------------------------
+// Kernel Snapshots
+//-----------------------------------------------------------------------------
+
+bool Introspect::registerObject(const char* name, uint8_t type, void* object) {
+    // call from main or once per object; entries are never removed
+    if (registered >= MAX_OBJECTS)
+        return false;
+    registry[registered].name = name;
+    registry[registered].type = type;
+    registry[registered].object = object;
+    registered++;
+    return true;
+}
+
+const char* Introspect::name(const void* object) {
+    for (uint8_t i = 0; i < registered; i++)
+    {
+        if (registry[i].object == object)
+            return registry[i].name;
+    }
+    return 0;
+}
+
+uint8_t Introspect::tasks(taskInfo* info, uint8_t max) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < MAX_TASKS && n < max; i++)
+    {
+        // one task's fields under a short, fixed-length mask
+        uint32_t primask = disableInterrupts();
+        uint8_t state = tcb[i].state;
+        info[n].index = i;
+        info[n].state = state;
+        info[n].priority = tcb[i].priority;
+        info[n].currentPriority = tcb[i].currentPriority;
+        info[n].pid = tcb[i].pid;
+        info[n].runTicks = tcb[i].runTicks;
+        info[n].wakeTick = (tcb[i].ticks != 0 && state != STATE_READY) ? tickCount + tcb[i].ticks : 0;
+        info[n].waitObject = (state == STATE_BLOCKED) ? tcb[i].waitObject : 0;
+        restoreInterrupts(primask);
+
+        if (state == STATE_INVALID)
+            continue;
+
+        // untouched fill words at the far end of the stack
+        uint16_t free = 0;
+        while (free < 240 && stack[i][free] == STACK_FILL)
+        {
+            free++;
+        }
+        info[n].stackFree = free;
+        n++;
+    }
+    return n;
+}
+
+uint8_t Introspect::objects(objectInfo* info, uint8_t max) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < registered && n < max; i++)
+    {
+        if (registry[i].type == OBJECT_TASK)
+            continue;
+
+        objectInfo* o = &info[n++];
+        o->name = registry[i].name;
+        o->type = registry[i].type;
+        o->object = registry[i].object;
+        o->capacity = 0;
+
+        uint32_t primask = disableInterrupts();
+        switch (registry[i].type)
+        {
+        case OBJECT_SEMAPHORE:
+        {
+            semaphore* s = (semaphore*)registry[i].object;
+            o->count = s->count;
+            o->waiters = s->queueSize;
+            break;
+        }
+        case OBJECT_MUTEX:
+        {
+            mutex* m = (mutex*)registry[i].object;
+            o->count = m->owner;
+            o->waiters = m->queueSize;
+            break;
+        }
+        case OBJECT_STREAM:
+        {
+            streamBuffer* sb = (streamBuffer*)registry[i].object;
+            o->count = sb->writeIndex - sb->readIndex;
+            o->capacity = sb->size;
+            o->waiters = (sb->reader != NO_TASK) ? 1 : 0;
+            break;
+        }
+        default:
+            o->count = 0;
+            o->waiters = 0;
+            break;
+        }
+        restoreInterrupts(primask);
+    }
+    return n;
+}
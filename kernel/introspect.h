@@ -0,0 +1,83 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef INTROSPECT_H
+#define INTROSPECT_H
+
+#include <stdint.h>
+#include "rtos.h"
+
+//-----------------------------------------------------------------------------
+// Kernel Snapshots
+//-----------------------------------------------------------------------------
+
+/// Read-only views of the task table and of registered kernel objects, for
+/// diagnostics on a running system.
+///
+/// Each task or object is copied with interrupts masked for a fixed handful
+/// of loads, never for a whole table walk; anything slower (the stack scan)
+/// runs with interrupts enabled on data only the owner writes. CPU time is
+/// sampled: the tick ISR charges each tick to the task it interrupted.
+///
+/// Objects are registered once by name so snapshots can report their
+/// occupancy and blocked tasks can be shown by what they wait on. Task entry
+/// functions may be registered too, purely to give them names.
+
+#define OBJECT_TASK         0    // object is a task entry function (_fn)
+#define OBJECT_SEMAPHORE    1
+#define OBJECT_MUTEX        2
+#define OBJECT_STREAM       3    // streamBuffer
+#define MAX_OBJECTS         16
+
+struct taskInfo
+{
+  uint8_t index;                 // tcb slot
+  uint8_t state;                 // STATE_ value
+  uint8_t priority;
+  uint8_t currentPriority;       // differs from priority while inheriting
+  void *pid;                     // entry function
+  uint32_t runTicks;             // sampled ticks spent running
+  uint32_t wakeTick;             // tick a sleep or timed wait ends, 0 if none
+  void *waitObject;              // object blocked on, 0 unless BLOCKED
+  uint16_t stackFree;            // words never used: the high-water margin
+};
+
+struct objectInfo
+{
+  const char *name;
+  uint8_t type;                  // OBJECT_ value
+  void *object;
+  uint32_t count;                // semaphore count, mutex owner, stream bytes used
+  uint32_t capacity;             // stream size; 0 otherwise
+  uint32_t waiters;              // tasks queued on it
+};
+
+/// Class for kernel snapshots
+class Introspect
+{
+public:
+    static bool registerObject(const char* name, uint8_t type, void* object);
+    static const char* name(const void* object);
+    static uint8_t tasks(taskInfo* info, uint8_t max);
+    static uint8_t objects(objectInfo* info, uint8_t max);
+};
+
+#endif // INTROSPECT_H
@@ -0,0 +1,434 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "kvstore.h"
+#include "flash.h"
+#include "rtos.h"
+#include "sync.h"
+#include "workqueue.h"
+#include "crc.h"
+
+#define PAGE_MAGIC      0x3153564B      // "KVS1"
+#define PAGE_HEADER     8               // magic, sequence
+#define RECORD_HEADER   8               // key | length << 16 | DELETED, CRC32
+#define ERASED          0xFFFFFFFF
+#define DELETED         0x80000000      // tombstone flag in the record header
+#define RESERVE_PAGES   1               // kept free so compaction can always copy
+#define GC_PAGES        3               // background compaction below this many free
+#define INDEX_SIZE      (1u << KV_INDEX_BITS)
+
+struct indexSlot
+{
+  uint16_t key;         // KV_NO_KEY when empty
+  uint16_t word;        // record position in words from KV_BASE
+};
+
+// Define variables
+static indexSlot slots[INDEX_SIZE];
+static uint32_t keyCount;
+static uint8_t tail;                // oldest page in use
+static uint8_t head;                // page being appended to
+static uint8_t usedPages;
+static uint32_t headOffset;         // bytes used in the head page
+static uint32_t sequence;           // sequence number of the head page
+static uint32_t record[(RECORD_HEADER + KV_MAX_VALUE) / 4];
+static mutex kvLock;
+static workItem gcWork;
+
+// CRC-32 of the header word followed by the value
+static uint32_t crc32(uint32_t header, const uint8_t* data, uint32_t length) {
+    return Crc::crc32(Crc::crc32(0, &header, 4), data, length);
+}
+
+static uint32_t recordSize(uint32_t length) {
+    return RECORD_HEADER + ((length + 3) & ~3u);
+}
+
+static uint8_t next(uint8_t page) {
+    return (page + 1) % KV_PAGES;
+}
+
+static const uint32_t* pageAddress(uint8_t page) {
+    return (const uint32_t*)(KV_BASE + page * FLASH_PAGE_SIZE);
+}
+
+static const uint32_t* recordAddress(uint16_t word) {
+    return (const uint32_t*)(KV_BASE + word * 4);
+}
+
+//-----------------------------------------------------------------------------
+// RAM index: open addressing with linear probing
+//-----------------------------------------------------------------------------
+
+static uint32_t hash(uint16_t key) {
+    return (key * 0x9E3779B1u) >> (32 - KV_INDEX_BITS);
+}
+
+static int32_t findSlot(uint16_t key) {
+    uint32_t i = hash(key);
+    while (slots[i].key != KV_NO_KEY)
+    {
+        if (slots[i].key == key)
+            return i;
+        i = (i + 1) & (INDEX_SIZE - 1);
+    }
+    return -1;
+}
+
+static bool insert(uint16_t key, uint16_t word) {
+    uint32_t i = hash(key);
+    while (slots[i].key != KV_NO_KEY && slots[i].key != key)
+    {
+        i = (i + 1) & (INDEX_SIZE - 1);
+    }
+    if (slots[i].key == KV_NO_KEY)
+    {
+        if (keyCount >= KV_MAX_KEYS)
+            return false;
+        keyCount++;
+    }
+    slots[i].key = key;
+    slots[i].word = word;
+    return true;
+}
+
+static void removeSlot(uint32_t i) {
+    // shift later members of the probe run back so no tombstones are needed
+    uint32_t j = i;
+    for (;;)
+    {
+        j = (j + 1) & (INDEX_SIZE - 1);
+        if (slots[j].key == KV_NO_KEY)
+            break;
+        uint32_t home = hash(slots[j].key);
+        if (((j - home) & (INDEX_SIZE - 1)) >= ((j - i) & (INDEX_SIZE - 1)))
+        {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i].key = KV_NO_KEY;
+    keyCount--;
+}
+
+//-----------------------------------------------------------------------------
+// Log
+//-----------------------------------------------------------------------------
+
+// length of a record at offset, or 0 if the page's log ends there
+static uint32_t validRecord(const uint8_t* page, uint32_t offset) {
+    if (offset + RECORD_HEADER > FLASH_PAGE_SIZE)
+        return 0;
+    const uint32_t* r = (const uint32_t*)(page + offset);
+    if (r[0] == ERASED)
+        return 0;
+    uint32_t length = (r[0] >> 16) & 0x7FFF;
+    uint32_t size = recordSize(length);
+    if (length > KV_MAX_VALUE || offset + size > FLASH_PAGE_SIZE)
+        return 0;
+    if (crc32(r[0], page + offset + RECORD_HEADER, length) != r[1])
+        return 0;
+    return size;
+}
+
+// apply a page's records to the index; returns the bytes in use
+static uint32_t replay(uint8_t page) {
+    const uint8_t* base = (const uint8_t*)pageAddress(page);
+    uint32_t offset = PAGE_HEADER;
+    uint32_t size;
+    while ((size = validRecord(base, offset)) != 0)
+    {
+        uint32_t header = *(const uint32_t*)(base + offset);
+        uint16_t key = header & 0xFFFF;
+        if (header & DELETED)
+        {
+            int32_t s = findSlot(key);
+            if (s >= 0)
+                removeSlot(s);
+        }
+        else
+        {
+            insert(key, (base + offset - (const uint8_t*)KV_BASE) / 4);
+        }
+        offset += size;
+    }
+
+    // anything after the last good record is a torn write: seal the page
+    if (offset + 4 <= FLASH_PAGE_SIZE && *(const uint32_t*)(base + offset) != ERASED)
+        offset = FLASH_PAGE_SIZE;
+    return offset;
+}
+
+static bool isErased(uint8_t page) {
+    const uint32_t* p = pageAddress(page);
+    for (uint32_t i = 0; i < FLASH_PAGE_SIZE / 4; i++)
+    {
+        if (p[i] != ERASED)
+            return false;
+    }
+    return true;
+}
+
+static bool openPage() {
+    if (usedPages >= KV_PAGES)
+        return false;
+    uint8_t page = (usedPages == 0) ? head : next(head);
+    uint32_t header[2] = { PAGE_MAGIC, sequence + 1 };
+    if (!Flash::program((uint32_t)pageAddress(page), header, 2))
+        return false;
+    sequence++;
+    head = page;
+    headOffset = PAGE_HEADER;
+    usedPages++;
+    return true;
+}
+
+// append a prepared record; returns its word position, or 0 on failure
+static uint16_t appendRaw(const uint32_t* words, uint32_t size) {
+    if (headOffset + size > FLASH_PAGE_SIZE && !openPage())
+        return 0;
+    uint32_t address = (uint32_t)pageAddress(head) + headOffset;
+    bool ok = Flash::program(address, words, size / 4);
+    headOffset += size;     // a failed spot stays consumed
+    return ok ? (address - KV_BASE) / 4 : 0;
+}
+
+static uint16_t append(uint32_t header, const void* data, uint16_t length) {
+    const uint8_t* src = (const uint8_t*)data;
+    uint8_t* dst = (uint8_t*)&record[2];
+    uint32_t size = recordSize(length);
+    for (uint32_t i = 0; i < size - RECORD_HEADER; i++)
+    {
+        dst[i] = (i < length) ? src[i] : 0xFF;
+    }
+    record[0] = header;
+    record[1] = crc32(header, dst, length);
+    return appendRaw(record, size);
+}
+
+// move the oldest page's live records to the head and erase it
+static bool compactOne() {
+    if (usedPages <= 1)
+        return false;
+
+    uint8_t victim = tail;
+    const uint8_t* base = (const uint8_t*)pageAddress(victim);
+    uint32_t offset = PAGE_HEADER;
+    uint32_t size;
+    while ((size = validRecord(base, offset)) != 0)
+    {
+        const uint32_t* r = (const uint32_t*)(base + offset);
+        uint16_t word = (base + offset - (const uint8_t*)KV_BASE) / 4;
+        int32_t s = (r[0] & DELETED) ? -1 : findSlot(r[0] & 0xFFFF);
+
+        // only the newest copy of a key is live; tombstones have nothing
+        // older left to hide once their page is the oldest
+        if (s >= 0 && slots[s].word == word)
+        {
+            for (uint32_t i = 0; i < size / 4; i++)
+            {
+                record[i] = r[i];
+            }
+            uint16_t moved = appendRaw(record, size);
+            if (moved == 0)
+                return false;
+            slots[s].word = moved;
+        }
+        offset += size;
+    }
+
+    if (!Flash::erase((uint32_t)base))
+        return false;
+    tail = next(victim);
+    usedPages--;
+    return true;
+}
+
+static void gcWorker(workItem* work) {
+    (void)work;
+    Mutex::lock(&kvLock);
+    for (uint8_t i = 0; i < KV_PAGES && KV_PAGES - usedPages < GC_PAGES; i++)
+    {
+        if (!compactOne())
+            break;
+    }
+    Mutex::unlock(&kvLock);
+}
+
+//-----------------------------------------------------------------------------
+// Key-Value Store
+//-----------------------------------------------------------------------------
+
+bool KvStore::init() {
+    // call from main after WorkQueue::init; scans the store once
+    Mutex::init(&kvLock);
+    WorkQueue::initWork(&gcWork, gcWorker, WORK_QUEUE_LOW);
+    for (uint32_t i = 0; i < INDEX_SIZE; i++)
+    {
+        slots[i].key = KV_NO_KEY;
+    }
+    keyCount = 0;
+    usedPages = 0;
+    sequence = 0;
+
+    // the page with the lowest sequence number is the oldest
+    uint32_t oldest = ERASED;
+    tail = 0;
+    head = 0;
+    for (uint8_t p = 0; p < KV_PAGES; p++)
+    {
+        const uint32_t* header = pageAddress(p);
+        if (header[0] == PAGE_MAGIC)
+        {
+            usedPages++;
+            if (header[1] < oldest)
+            {
+                oldest = header[1];
+                tail = p;
+            }
+            if (header[1] >= sequence)
+            {
+                sequence = header[1];
+                head = p;
+            }
+        }
+        else if (!isErased(p))
+        {
+            Flash::erase((uint32_t)header);     // erase cut short by a reset
+        }
+    }
+
+    if (usedPages == 0)
+        return openPage();
+
+    // replay in ring order, oldest to newest, so newer records win
+    for (uint8_t p = tail; ; p = next(p))
+    {
+        if (pageAddress(p)[0] == PAGE_MAGIC)
+            headOffset = replay(p);
+        if (p == head)
+            break;
+    }
+    return true;
+}
+
+bool KvStore::set(uint16_t key, const void* data, uint16_t length) {
+    if (key == KV_NO_KEY || length > KV_MAX_VALUE)
+        return false;
+
+    Mutex::lock(&kvLock);
+    int32_t s = findSlot(key);
+    if (s < 0 && keyCount >= KV_MAX_KEYS)
+    {
+        Mutex::unlock(&kvLock);
+        return false;
+    }
+
+    // rewriting an unchanged value only wears the flash
+    if (s >= 0)
+    {
+        const uint32_t* r = recordAddress(slots[s].word);
+        const uint8_t* old = (const uint8_t*)&r[2];
+        bool same = ((r[0] >> 16) & 0x7FFF) == length;
+        for (uint16_t i = 0; same && i < length; i++)
+        {
+            same = old[i] == ((const uint8_t*)data)[i];
+        }
+        if (same)
+        {
+            Mutex::unlock(&kvLock);
+            return true;
+        }
+    }
+
+    // never let a plain write take the compaction reserve
+    uint32_t size = recordSize(length);
+    for (uint8_t i = 0; i < KV_PAGES && headOffset + size > FLASH_PAGE_SIZE
+         && KV_PAGES - usedPages <= RESERVE_PAGES; i++)
+    {
+        if (!compactOne())
+            break;
+    }
+
+    bool ok = false;
+    if (headOffset + size <= FLASH_PAGE_SIZE || KV_PAGES - usedPages > RESERVE_PAGES)
+    {
+        uint16_t word = append(key | (uint32_t)length << 16, data, length);
+        ok = word != 0 && insert(key, word);
+    }
+    if (KV_PAGES - usedPages < GC_PAGES)
+        WorkQueue::submit(&gcWork);
+    Mutex::unlock(&kvLock);
+    return ok;
+}
+
+bool KvStore::get(uint16_t key, void* data, uint16_t* length) {
+    // length: buffer size in, value size out; false if missing or too small
+    Mutex::lock(&kvLock);
+    int32_t s = findSlot(key);
+    bool ok = s >= 0;
+    if (ok)
+    {
+        const uint32_t* r = recordAddress(slots[s].word);
+        uint16_t size = (r[0] >> 16) & 0x7FFF;
+        ok = size <= *length;
+        if (ok)
+        {
+            const uint8_t* src = (const uint8_t*)&r[2];
+            for (uint16_t i = 0; i < size; i++)
+            {
+                ((uint8_t*)data)[i] = src[i];
+            }
+        }
+        *length = size;
+    }
+    Mutex::unlock(&kvLock);
+    return ok;
+}
+
+bool KvStore::remove(uint16_t key) {
+    Mutex::lock(&kvLock);
+    int32_t s = findSlot(key);
+    bool ok = s >= 0;
+    if (ok)
+    {
+        for (uint8_t i = 0; i < KV_PAGES && headOffset + RECORD_HEADER > FLASH_PAGE_SIZE
+             && KV_PAGES - usedPages <= RESERVE_PAGES; i++)
+        {
+            if (!compactOne())
+                break;
+        }
+        s = findSlot(key);
+        ok = append(key | DELETED, 0, 0) != 0;
+        if (ok)
+            removeSlot(s);
+    }
+    Mutex::unlock(&kvLock);
+    return ok;
+}
+
+uint32_t KvStore::count() {
+    return keyCount;
+}
+
+uint32_t KvStore::freePages() {
+    return KV_PAGES - usedPages;
+}
@@ -0,0 +1,69 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef KVSTORE_H
+#define KVSTORE_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Key-Value Store
+//-----------------------------------------------------------------------------
+
+/// Persistent key-value store kept as an append-only log in the top pages of
+/// internal flash (linker.ld leaves them out of the image).
+///
+/// Every update appends a record {key, length, CRC32, value}; nothing is
+/// rewritten in place, so an update costs one short program instead of a
+/// page erase. A RAM hash table maps each key to its newest record, giving
+/// O(1) lookups; it is rebuilt at boot by replaying the pages oldest first,
+/// and a record with a bad CRC (torn by a reset) ends its page's log.
+///
+/// Pages are used as a ring: writes fill the head page, and compaction
+/// copies the still-live records of the oldest page to the head and erases
+/// it. Every page therefore sees the same number of erases. Compaction runs
+/// on the low-priority work queue when free pages run short, and inline only
+/// if a write would otherwise dip into the page reserved for compaction.
+///
+/// The index is kept at most half full so probe runs stay short. The live
+/// data must still fit the 31 KB outside the reserve page: 512 keys leave
+/// room for small settings, fewer keys for values near KV_MAX_VALUE.
+
+#define KV_BASE             0x00038000   // first flash page of the store
+#define KV_PAGES            32           // 1 KB each
+#define KV_MAX_VALUE        256          // bytes per value
+#define KV_MAX_KEYS         512          // 6 KB of log at 4-byte values
+#define KV_INDEX_BITS       10           // 1024 hash slots, 4 KB of SRAM
+#define KV_NO_KEY           0xFFFF       // reserved, not a valid key
+
+/// Class for the key-value store
+class KvStore
+{
+public:
+    static bool init();
+    static bool set(uint16_t key, const void* data, uint16_t length);
+    static bool get(uint16_t key, void* data, uint16_t* length);
+    static bool remove(uint16_t key);
+    static uint32_t count();
+    static uint32_t freePages();
+};
+
+#endif // KVSTORE_H
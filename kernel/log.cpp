@@ -0,0 +1,91 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "log.h"
+#include "rtos.h"
+#include "uart.h"
+
+// Define variables
+static uint32_t ring[LOG_BUFFER_WORDS];
+static volatile uint32_t writeIndex;    // free-running, advanced by writers
+static volatile uint32_t readIndex;     // free-running, advanced by the drain task
+static volatile uint32_t lostRecords;   // dropped since the last report
+static uint32_t lostTotal;
+
+//-----------------------------------------------------------------------------
+// Deferred Binary Logging
+//-----------------------------------------------------------------------------
+
+void Log::push(uint32_t format, const uint32_t* args, uint32_t count) {
+    // any task or ISR; interrupts are masked only while the words are stored
+    uint32_t primask = disableInterrupts();
+    uint32_t w = writeIndex;
+    if (w + 2 + count - readIndex > LOG_BUFFER_WORDS)
+    {
+        lostRecords++;
+        restoreInterrupts(primask);
+        return;
+    }
+    ring[w & (LOG_BUFFER_WORDS - 1)] = LOG_MARKER | count << 24 | (format & 0x00FFFFFF);
+    ring[(w + 1) & (LOG_BUFFER_WORDS - 1)] = tickCount;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ring[(w + 2 + i) & (LOG_BUFFER_WORDS - 1)] = args[i];
+    }
+    writeIndex = w + 2 + count;
+    restoreInterrupts(primask);
+}
+
+void Log::drainTask() {
+    // create at a low priority; sends straight from the ring, no copy
+    while (true)
+    {
+        uint32_t lost = lostRecords;
+        if (lost != 0)
+        {
+            uint32_t primask = disableInterrupts();
+            lostRecords -= lost;
+            restoreInterrupts(primask);
+            lostTotal += lost;
+            uint32_t report[3] = { LOG_MARKER | 1 << 24 | LOG_DROPPED, tickCount, lost };
+            Uart::write(report, sizeof(report), WAIT_FOREVER);
+        }
+
+        uint32_t r = readIndex;
+        uint32_t w = writeIndex;
+        while (r != w)
+        {
+            // contiguous run up to the end of the ring
+            uint32_t start = r & (LOG_BUFFER_WORDS - 1);
+            uint32_t count = w - r;
+            if (count > LOG_BUFFER_WORDS - start)
+                count = LOG_BUFFER_WORDS - start;
+            Uart::write(&ring[start], count * 4, WAIT_FOREVER);
+            r += count;
+            readIndex = r;
+        }
+        RTOS::sleep(LOG_DRAIN_TICKS);
+    }
+}
+
+uint32_t Log::dropped() {
+    return lostTotal + lostRecords;
+}
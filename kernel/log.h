@@ -0,0 +1,90 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Deferred Binary Logging
+//-----------------------------------------------------------------------------
+
+/// LOG("fmt", args...) records the format string's address and the raw
+/// arguments instead of formatting on the target. The format strings live in
+/// the .logstr section, which linker.ld keeps in the ELF but never loads, so
+/// they cost no flash either. A low-priority drain task ships the records
+/// over UART0 and tools/logdecode.py formats them on the host using the ELF.
+///
+/// The hot path masks interrupts for a few word stores into a RAM ring; it
+/// never blocks. When the ring is full the record is dropped and counted,
+/// and the decoder is told how many were lost.
+///
+/// Arguments are stored as 32-bit words: integers, chars and pointers as
+/// is, float and double as a float. %s is not supported (the string would
+/// have to be copied); use a literal in the format instead.
+///
+/// Wire record, little-endian words:
+///   LOG_MARKER | args << 24 | format address, tickCount, args...
+
+#define LOG_BUFFER_WORDS    512          // ring size, power of two
+#define LOG_MAX_ARGS        8
+#define LOG_MARKER          0xA0000000   // top nibble of every record header
+#define LOG_DROPPED         0            // format address of a "records lost" record
+#define LOG_DRAIN_TICKS     10           // drain task period
+
+#define LOG(fmt, ...)                                                         \
+    do                                                                        \
+    {                                                                         \
+        static const char logFormat[] __attribute__((section(".logstr"), used)) = fmt; \
+        Log::write((uint32_t)logFormat, ##__VA_ARGS__);                      \
+    } while (0)
+
+/// Class for deferred logging
+class Log
+{
+public:
+    template <typename... Args>
+    static void write(uint32_t format, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many LOG() arguments");
+        uint32_t words[sizeof...(Args) + 1] = { word(args)..., 0 };
+        push(format, words, sizeof...(Args));
+    }
+
+    static void push(uint32_t format, const uint32_t* args, uint32_t count);
+    static void drainTask();
+    static uint32_t dropped();
+
+private:
+    template <typename T>
+    static uint32_t word(T value) {
+        return (uint32_t)value;
+    }
+    static uint32_t word(float value) {
+        union { float f; uint32_t u; } bits = { value };
+        return bits.u;
+    }
+    static uint32_t word(double value) {
+        return word((float)value);
+    }
+};
+
+#endif // LOG_H
@@ -0,0 +1,73 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "mempool.h"
+#include "rtos.h"
+
+//-----------------------------------------------------------------------------
+// Memory Pool
+//-----------------------------------------------------------------------------
+
+bool MemPool::init(memPool* pool, void* buf, uint32_t blockSize, uint32_t blocks) {
+    // buf must be 4-byte aligned and hold blocks * blockSize bytes
+    if (blockSize < 4 || (blockSize & 3) != 0 || ((uintptr_t)buf & 3) != 0 || blocks == 0)
+        return false;
+
+    uint8_t* block = (uint8_t*)buf;
+    for (uint32_t i = 0; i < blocks - 1; i++)
+    {
+        *(void**)block = block + blockSize;
+        block += blockSize;
+    }
+    *(void**)block = 0;
+
+    pool->blockSize = blockSize;
+    pool->blocks = blocks;
+    pool->available = blocks;
+    pool->freeList = buf;
+    return true;
+}
+
+void* MemPool::alloc(memPool* pool) {
+    uint32_t primask = disableInterrupts();
+    void* block = pool->freeList;
+    if (block != 0)
+    {
+        pool->freeList = *(void**)block;
+        pool->available--;
+    }
+    restoreInterrupts(primask);
+    return block;
+}
+
+void MemPool::free(memPool* pool, void* block) {
+    if (block == 0)
+        return;
+    uint32_t primask = disableInterrupts();
+    *(void**)block = pool->freeList;
+    pool->freeList = block;
+    pool->available++;
+    restoreInterrupts(primask);
+}
+
+uint32_t MemPool::available(memPool* pool) {
+    return pool->available;
+}
@@ -0,0 +1,54 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Memory Pool
+//-----------------------------------------------------------------------------
+
+/// Fixed-size block allocator over caller-provided storage. Free blocks are
+/// chained through their first word, so alloc and free are O(1) and never
+/// fragment. Neither call blocks; alloc returns 0 when the pool is empty.
+/// Both are safe to call from an ISR.
+
+struct memPool
+{
+  uint32_t blockSize;     // bytes per block, multiple of 4
+  uint32_t blocks;        // total blocks in the pool
+  volatile uint32_t available;  // blocks on the free list
+  void *freeList;         // first free block, or 0
+};
+
+/// Class for memory pool
+class MemPool
+{
+public:
+    static bool init(memPool* pool, void* buf, uint32_t blockSize, uint32_t blocks);
+    static void* alloc(memPool* pool);
+    static void free(memPool* pool, void* block);
+    static uint32_t available(memPool* pool);
+};
+
+#endif // MEMPOOL_H
@@ -27,8 +27,13 @@ struct semaphore *s, keyPressed, keyReleased, flashReq, printRTOSModeReq;
 uint8_t taskCurrent = 0;
 uint8_t taskCount = 0;
 int rtosMode;
+volatile uint32_t tickCount = 0;
 struct _tcb tcb[MAX_TASKS];
-uint32_t stack[MAX_TASKS][256];
+uint32_t stack[MAX_TASKS][256] __attribute__((aligned(8)));  // AAPCS stack alignment
+static uint32_t criticalNesting = 0;   // ENTER_CRITICAL_SECTION depth
+static uint32_t criticalPrimask;       // PRIMASK saved by the outermost entry
+static _fn tickHooks[MAX_TICK_HOOKS];
+static uint8_t tickHookCount = 0;
 
 void restoreMSP(uint32_t sp) {
     __asm volatile ("MSR MSP, %0" : : "r" (sp));
@@ -40,6 +45,79 @@ uint32_t saveMSP() {
     return msp;
 }
 
+uint32_t disableInterrupts() {
+    uint32_t primask;
+    __asm volatile ("MRS %0, PRIMASK" : "=r" (primask) );
+    __asm volatile ("CPSID I" : : : "memory");
+    return primask;
+}
+
+void restoreInterrupts(uint32_t primask) {
+    __asm volatile ("MSR PRIMASK, %0" : : "r" (primask) : "memory");
+}
+
+void enterCritical() {
+    uint32_t primask = disableInterrupts();
+    if (criticalNesting++ == 0)
+        criticalPrimask = primask;
+}
+
+void exitCritical() {
+    if (--criticalNesting == 0)
+        restoreInterrupts(criticalPrimask);
+}
+
+// in preemptive mode a task made ready ahead of the running one takes over
+// as soon as the caller, task or ISR, lets PendSV in
+static void preempt(uint8_t task) {
+    if (rtosMode == MODE_PREEMPTIVE && tcb[task].priority < tcb[taskCurrent].priority)
+        NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV;
+}
+
+//-----------------------------------------------------------------------------
+// Context Switch
+//-----------------------------------------------------------------------------
+
+// stores the outgoing task's stack pointer and returns the incoming one's
+extern "C" uint32_t* rtosSwitch(uint32_t* sp) {
+    tcb[taskCurrent].sp = sp;
+    int next;
+    while ((next = RTOS::rtosScheduler()) == NO_TASK)
+    {
+        // nothing ready: sleep until an interrupt is pending, then let the
+        // tick or that ISR run and ready a task
+        __asm volatile (" WFI \n"
+                        " CPSIE I \n"
+                        " CPSID I \n" : : : "memory");
+    }
+    taskCurrent = next;
+    return (uint32_t*)tcb[taskCurrent].sp;
+}
+
+// The hardware stacks R0-R3, R12, LR, PC and xPSR on the task's PSP; this
+// pushes R4-R11 and EXC_RETURN below them, plus S16-S31 if the task has used
+// the FPU, and pops the same from the next task's stack.
+extern "C" __attribute__((naked)) void PendSV_Handler() {
+    __asm volatile (" MRS     R0, PSP \n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+                    " TST     LR, #0x10 \n"
+                    " IT      EQ \n"
+                    " VSTMDBEQ R0!, {S16-S31} \n"
+#endif
+                    " STMDB   R0!, {R4-R11, LR} \n"
+                    " CPSID   I \n"              // ISRs may change task state
+                    " BL      rtosSwitch \n"
+                    " CPSIE   I \n"
+                    " LDMIA   R0!, {R4-R11, LR} \n"
+#if defined(__VFP_FP__) && !defined(__SOFTFP__)
+                    " TST     LR, #0x10 \n"
+                    " IT      EQ \n"
+                    " VLDMIAEQ R0!, {S16-S31} \n"
+#endif
+                    " MSR     PSP, R0 \n"
+                    " BX      LR \n");
+}
+
 //-----------------------------------------------------------------------------
 // RTOS Kernel
 //-----------------------------------------------------------------------------
@@ -53,6 +131,7 @@ void RTOS::rtosInit(int mode,int reload) {
     rtosMode = mode;
     // no tasks running
     taskCount = 0;
+    tickCount = 0;
     // clear out tcb records
     for (i = 0; i < MAX_TASKS; i++)
     {
@@ -96,25 +175,34 @@ bool RTOS::createProcess(_fn fn, int priority) {
         tcb[i].pid = (void*)fn;
         // REQUIRED: preload stack to look like the task had run before
         stack[i][255] = 0x01000000;   // xPSR
-        stack[i][254] = (uint32_t)fn; // PC
+        stack[i][254] = (uint32_t)fn & ~1u; // PC, without the Thumb bit
         stack[i][253] = (uint32_t)fn; // LR
         stack[i][252] = 12;           // R12
         stack[i][251] = 3;            // R3
         stack[i][250] = 2;            // R2
         stack[i][249] = 1;            // R1
         stack[i][248] = 0;            // R0
-        stack[i][247] = 4;            // R4
-        stack[i][246] = 5;            // R5
-        stack[i][245] = 6;            // R6
-        stack[i][244] = 7;            // R7
-        stack[i][243] = 8;            // R8
-        stack[i][242] = 9;            // R9
-        stack[i][241] = 10;           // R10
-        stack[i][240] = 11;           // R11
-        tcb[i].sp = &stack[i][240];   // REQUIRED: + offset as needed for the pre-loaded stack
+        stack[i][247] = 11;           // R11
+        stack[i][246] = 10;           // R10
+        stack[i][245] = 9;            // R9
+        stack[i][244] = 8;            // R8
+        stack[i][243] = 7;            // R7
+        stack[i][242] = 6;            // R6
+        stack[i][241] = 5;            // R5
+        stack[i][240] = 4;            // R4
+        stack[i][239] = EXC_RETURN_PSP; // LR in PendSV: thread mode, PSP, no FP frame
+        tcb[i].sp = &stack[i][239];   // REQUIRED: + offset as needed for the pre-loaded stack
         tcb[i].priority = priority;
         tcb[i].skipCount = priority;
         tcb[i].currentPriority = priority;
+        tcb[i].notify = NOTIFY_NONE;
+        tcb[i].runTicks = 0;
+        tcb[i].waitObject = 0;
+        // pattern the unused stack so its high-water mark can be measured
+        for (uint8_t j = 0; j < 239; j++)
+        {
+            stack[i][j] = STACK_FILL;
+        }
         // increment task count
         taskCount++;
         ok = true;
@@ -149,65 +237,110 @@ void RTOS::destroyProcess(_fn fn) {
 }
 
 int RTOS::rtosScheduler() {
-    // Implement prioritization to 8 levels
-
-    bool ok, priorityReset;
-    static uint8_t task = 0xFF;
-    ok = false;
-    priorityReset = true;
-
-    while (!ok) {
-        task++;
-        if (task >= MAX_TASKS) {
-            task = 0;
-            ok = (tcb[task].state == STATE_READY && tcb[task].skipCount <= 7); // Also validating priority of tasks
-        }
-
-        if (tcb[task].skipCount <= 7) {
-            tcb[task].skipCount++;
-        }
-
-        int i;
-        for (i = 0; i < MAX_TASKS; i++) {
-            if (tcb[i].state != STATE_INVALID) {
-                if ((tcb[i].state == STATE_READY) && (tcb[i].skipCount == 8)) {
-                    priorityReset = true;
-                } else {
-                    priorityReset = false;
-                }
+    // Implement prioritization to 8 levels: the highest priority ready task
+    // with turns left runs, and tasks of equal priority take turns starting
+    // after the last pick. skipCount counts a task's turns up from its
+    // priority to 8, so a round gives it 8 - priority of them; once no ready
+    // task has one left, a new round starts. A task that only yields thus
+    // takes its share and lower priorities still run. NO_TASK if none is ready.
+    static uint8_t task = MAX_TASKS - 1;
+
+    for (uint8_t round = 0; round < 2; round++)
+    {
+        uint8_t best = NO_TASK;
+        for (uint8_t n = 1; n <= MAX_TASKS; n++)
+        {
+            uint8_t i = (task + n) % MAX_TASKS;
+            if (tcb[i].state == STATE_READY && tcb[i].skipCount < 8 &&
+                (best == NO_TASK || tcb[i].priority < tcb[best].priority))
+            {
+                best = i;
             }
         }
-
-        if (priorityReset) {
-            for (i = 0; i < MAX_TASKS; i++) {
-                if (tcb[i].state == STATE_READY) {
-                    tcb[i].skipCount = tcb[i].priority;
-                }
-            }
+        if (best != NO_TASK)
+        {
+            tcb[best].skipCount++;
+            task = best;
+            return task;
+        }
+        for (uint8_t i = 0; i < MAX_TASKS; i++)
+        {
+            tcb[i].skipCount = tcb[i].priority;
         }
     }
-
-    return task;
+    return NO_TASK;
 }
 
 void RTOS::rtosStart() {
     // Add code to call the first task to be run, restoring the preloaded context
-    ENTER_CRITICAL_SECTION;
+    uint32_t primask = disableInterrupts();
 
-    taskCurrent = rtosScheduler();
-    // Add code to initialize the MSP with tcb[task_current].sp;
-    // Restore the stack to run the first process
-    restoreMSP((uint32_t)tcb[taskCurrent].sp);
-    __asm(" POP  {R4, R5, R6, R7, R8, R9, R10, R11} ");
-    __asm(" POP  {R0, R1, R2, R3, R12} ");
-    __asm(" POP  {R14} ");
-    __asm(" MOV  PC, R14 ");
+    // PendSV switches tasks, at the lowest priority so it never preempts a handler
+    NVIC_SYS_PRI3_R = (NVIC_SYS_PRI3_R & ~NVIC_SYS_PRI3_PENDSV_M) | (7 << NVIC_SYS_PRI3_PENDSV_S);
+    int first = rtosScheduler();
+    if (first == NO_TASK)
+    {
+        restoreInterrupts(primask);
+        return;
+    }
+    taskCurrent = first;
+
+    // Tasks run in thread mode on the PSP and handlers keep the MSP. The first
+    // task starts at the top of its own stack, so its preloaded frame is unused;
+    // the switch is done in one block since SP changes under the compiler's feet.
+    uint32_t top = (uint32_t)&stack[taskCurrent][256];
+    uint32_t fn = (uint32_t)tcb[taskCurrent].pid;
+    __asm volatile (" MSR   PSP, %0 \n"
+                    " MOVS  R0, #2 \n"
+                    " MSR   CONTROL, R0 \n"      // SPSEL: thread mode uses the PSP
+                    " ISB \n"
+                    " CPSIE I \n"                // the first task runs with interrupts enabled
+                    " BX    %1 \n"
+                    : : "r" (top), "r" (fn) : "r0", "memory");
+}
+
+void RTOS::tickIsr() {
+    // called once per system tick from the SysTick handler
+    tickCount++;
 
-    // Call the first task
-    _fn fn = (_fn)tcb[taskCurrent].pid;
-    fn();
+    // sampled CPU accounting: charge the tick to whoever it interrupted
+    tcb[taskCurrent].runTicks++;
 
+    // count down sleeping tasks and tasks blocked with a timeout
+    for (uint8_t i = 0; i < MAX_TASKS; i++)
+    {
+        if ((tcb[i].state == STATE_DELAYED || tcb[i].state == STATE_BLOCKED) && tcb[i].ticks != 0)
+        {
+            tcb[i].ticks--;
+            if (tcb[i].ticks == 0)
+            {
+                tcb[i].state = STATE_READY;
+            }
+        }
+    }
+
+    // subsystems with their own timers, e.g. delayed work
+    for (uint8_t i = 0; i < tickHookCount; i++)
+    {
+        tickHooks[i]();
+    }
+
+    // time slice: let the scheduler pick again once the handler returns
+    if (rtosMode == MODE_PREEMPTIVE)
+        NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV;
+}
+
+bool RTOS::addTickHook(_fn hook) {
+    // register a function to run from every tick; call before rtosStart
+    bool ok = false;
+    ENTER_CRITICAL_SECTION;
+    if (tickHookCount < MAX_TICK_HOOKS)
+    {
+        tickHooks[tickHookCount++] = hook;
+        ok = true;
+    }
     EXIT_CRITICAL_SECTION;
+    return ok;
 }
 
 void RTOS::initSemaphore(void* p, int count) {
@@ -217,44 +350,22 @@ void RTOS::initSemaphore(void* p, int count) {
 }
 
 void RTOS::yield() {
-    // push registers, call scheduler, pop registers, return to new function
-    // push registers
-    __asm(" PUSH  {R4, R5, R6, R7, R8, R9, R10, R11} ");
-    __asm(" PUSH  {R0, R1, R2, R3, R12} ");
-    __asm(" PUSH  {R14} ");
-    __asm(" PUSH  {R4} ");
-    __asm(" PUSH  {R5} ");
-    // call scheduler
-    taskCurrent = rtosScheduler();  // Find the next task to run
+    // pend the switch; PendSV saves this task and runs the scheduler's pick as
+    // soon as interrupts are enabled, and the call returns when we run again
+    NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV;
+    __asm volatile (" DSB \n ISB" : : : "memory");
 }
 
 void RTOS::sleep(uint32_t tick) {
-    // push registers, set state to delayed, store timeout, call scheduler, pop registers,
-    // return to new function (separate unrun or ready processing)
-        // push registers
-        __asm(" PUSH  {R4, R5, R6, R7, R8, R9, R10, R11} ");
-        __asm(" PUSH  {R0, R1, R2, R3, R12} ");
-        __asm(" PUSH  {R14} ");
-        __asm(" PUSH  {R4} ");
-        __asm(" PUSH  {R5} ");
-    
-        // set state to delayed
+    // set state to delayed, store timeout, call scheduler
+    if (tick != 0)
+    {
+        uint32_t primask = disableInterrupts();
         tcb[taskCurrent].state = STATE_DELAYED;
-        // store timeout
         tcb[taskCurrent].ticks = tick;
-    
-        // call scheduler
-        taskCurrent = rtosScheduler();
-    
-        // pop registers
-        __asm(" POP  {R5} ");
-        __asm(" POP  {R4} ");
-        __asm(" POP  {R14} ");
-        __asm(" POP  {R0, R1, R2, R3, R12} ");
-        __asm(" POP  {R4, R5, R6, R7, R8, R9, R10, R11} ");
-    
-        // return to new function (separate unrun or ready processing)
-        __asm(" MOV  PC, LR ");
+        restoreInterrupts(primask);
+    }
+    yield();
 }
 
 void RTOS::waitSemaphore(void* pSemaphore) {
@@ -269,6 +380,7 @@ void RTOS::waitSemaphore(void* pSemaphore) {
     } else {
         // Semaphore is not available, add the task to the semaphore queue
         s->processQueue[s->queueSize++] = taskCurrent;
+        tcb[taskCurrent].waitObject = s;
         tcb[taskCurrent].state = STATE_BLOCKED;
 
         // Implement priority inheritance
@@ -290,15 +402,16 @@ void RTOS::postSemaphore(void* pSemaphore) {
 
     // Check if there are any tasks waiting on the semaphore
     if (s->queueSize > 0) {
-        // Unblock the first task in the queue
-        tcb[s->processQueue[0]].state = STATE_READY;
-        s->count++;
+        // Unblock the first task in the queue and hand it the count
+        uint8_t task = s->processQueue[0];
+        tcb[task].state = STATE_READY;
         s->queueSize--;
 
         // Shift the queue to the left
         for (unsigned int i = 0; i < s->queueSize; i++) {
             s->processQueue[i] = s->processQueue[i + 1];
         }
+        preempt(task);
     } else {
         s->count++;
     }
@@ -306,3 +419,44 @@ void RTOS::postSemaphore(void* pSemaphore) {
     EXIT_CRITICAL_SECTION;
 }   
 
+bool RTOS::waitNotify(uint32_t timeout) {
+    // blocks until notify() is called for this task or the timeout expires;
+    // returns false on timeout
+    uint32_t primask = disableInterrupts();
+    if (tcb[taskCurrent].notify == NOTIFY_PENDING || timeout == NO_WAIT)
+    {
+        bool notified = (tcb[taskCurrent].notify == NOTIFY_PENDING);
+        tcb[taskCurrent].notify = NOTIFY_NONE;
+        restoreInterrupts(primask);
+        return notified;
+    }
+    tcb[taskCurrent].notify = NOTIFY_WAITING;
+    tcb[taskCurrent].waitObject = (void*)&tcb[taskCurrent].notify;
+    tcb[taskCurrent].ticks = (timeout == WAIT_FOREVER) ? 0 : timeout;
+    tcb[taskCurrent].state = STATE_BLOCKED;
+    restoreInterrupts(primask);
+
+    yield();
+
+    primask = disableInterrupts();
+    bool notified = (tcb[taskCurrent].notify == NOTIFY_PENDING);
+    tcb[taskCurrent].notify = NOTIFY_NONE;
+    restoreInterrupts(primask);
+    return notified;
+}
+
+void RTOS::notify(uint8_t task) {
+    // wakes a task blocked in waitNotify(), or lets its next wait return at once;
+    // safe to call from an ISR
+    if (task >= MAX_TASKS)
+        return;
+    uint32_t primask = disableInterrupts();
+    if (tcb[task].notify == NOTIFY_WAITING && tcb[task].state == STATE_BLOCKED)
+    {
+        tcb[task].ticks = 0;
+        tcb[task].state = STATE_READY;
+        preempt(task);
+    }
+    tcb[task].notify = NOTIFY_PENDING;
+    restoreInterrupts(primask);
+}
@@ -30,12 +30,25 @@
 /// function pointer
 typedef void (*_fn)();
 
+/// tick hooks, run from tickIsr with the kernel's tick bookkeeping done
+#define MAX_TICK_HOOKS    4
+
 /// stack pointer manipulation
 void restoreMSP(uint32_t sp);
 uint32_t saveMSP();
 
-/// semaphore
-#define MAX_QUEUE_SIZE    10
+/// interrupt masking, for state shared with ISRs
+uint32_t disableInterrupts();
+void restoreInterrupts(uint32_t primask);
+void enterCritical();
+void exitCritical();
+
+/// task limit
+#define MAX_TASKS 12          // maximum number of valid tasks
+
+/// semaphore, and the wait queues of sync.h; a task waits on one object at
+/// a time, so a queue as long as the task table can never overflow
+#define MAX_QUEUE_SIZE    MAX_TASKS
 struct semaphore
 {
   unsigned int count;
@@ -46,11 +59,11 @@ struct semaphore
 extern struct semaphore *s, keyPressed, keyReleased, flashReq, printRTOSModeReq;
 
 /// task
-#define MAX_TASKS 10          // maximum number of valid tasks
 #define STATE_INVALID    0    // no task
 #define STATE_READY      1    // ready to run
 #define STATE_BLOCKED    2    // has run, but now blocked by semaphore
 #define STATE_DELAYED    3    // has run, but now awaiting timer
+#define NO_TASK          0xFF // no task index (empty wait slot)
 
 extern uint8_t taskCurrent;      // index of last dispatched task
 extern uint8_t taskCount;        // total number of valid tasks
@@ -61,6 +74,12 @@ extern uint8_t taskCount;        // total number of valid tasks
 
 extern int rtosMode;
 
+/// timeouts, in system ticks
+#define NO_WAIT          0
+#define WAIT_FOREVER     0xFFFFFFFF
+
+extern volatile uint32_t tickCount;  // ticks since rtosInit
+
 /// data structure for task control block
 struct _tcb
 {
@@ -70,17 +89,27 @@ struct _tcb
   uint8_t priority;              // 0=highest, 7=lowest
   uint8_t skipCount;             // no of times task can be skipped
   uint8_t currentPriority;       // used for priority inheritance
-  uint32_t ticks;                // ticks until sleep complete
+  uint32_t ticks;                // ticks until sleep or timed wait complete (0 = no timeout)
+  volatile uint8_t notify;       // see NOTIFY_ values below
+  uint32_t runTicks;             // ticks this task was running when SysTick fired
+  void *waitObject;              // object last blocked on, valid while BLOCKED
 };
 
 extern struct _tcb tcb[MAX_TASKS];
 
+/// task notification
+#define NOTIFY_NONE      0    // nothing pending
+#define NOTIFY_PENDING   1    // notified, not yet consumed
+#define NOTIFY_WAITING   2    // blocked in waitNotify()
+
 /// data structure for stack manipulation 
 extern uint32_t stack[MAX_TASKS][256];
+#define STACK_FILL       0xA5A5A5A5   // unused stack words, for high-water marks
+#define EXC_RETURN_PSP   0xFFFFFFFD   // return to thread mode on the PSP, basic frame
 
-/// critical section
-#define ENTER_CRITICAL_SECTION   (NVIC_ST_CTRL_R = 0x00)
-#define EXIT_CRITICAL_SECTION    (NVIC_ST_CTRL_R = 0x01)
+/// critical section: masks interrupts and nests, restoring PRIMASK on the last exit
+#define ENTER_CRITICAL_SECTION   enterCritical()
+#define EXIT_CRITICAL_SECTION    exitCritical()
 
 /// Class for RTOS 
 class RTOS 
@@ -92,12 +121,17 @@ public:
     static void destroyProcess(_fn fn);
     static int  rtosScheduler();
     static void rtosStart();
+    static void tickIsr();
+    static bool addTickHook(_fn hook);
 
     static void initSemaphore(void* p, int count); 
     static void yield();
     static void sleep(uint32_t tick);
     static void waitSemaphore(void* pSemaphore);
     static void postSemaphore(void* pSemaphore);
+
+    static bool waitNotify(uint32_t timeout);
+    static void notify(uint8_t task);
 };
 
 #endif // RTOS_H
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "streambuf.h"
+#include "rtos.h"
+
+// compiler barrier so index updates are not reordered around buffer accesses
+static inline void memoryBarrier() {
+#if defined(__arm__)
+    __asm volatile (" DMB" : : : "memory");
+#else
+    __sync_synchronize();   // host benchmarks
+#endif
+}
+
+// bytes a record of the given payload length occupies in the ring
+static inline uint32_t recordSize(uint32_t length) {
+    return (STREAM_RECORD_HEADER + length + 3) & ~3u;
+}
+
+static inline uint16_t* headerAt(streamBuffer* sb, uint32_t index) {
+    return (uint16_t*)&sb->buf[index & (sb->size - 1)];
+}
+
+// make a reader blocked in receive() ready once the trigger level is reached
+static void wakeReader(streamBuffer* sb) {
+    uint8_t task = sb->reader;
+    if (task != NO_TASK && StreamBuffer::used(sb) >= sb->triggerLevel)
+    {
+        sb->reader = NO_TASK;
+        tcb[task].ticks = 0;
+        tcb[task].state = STATE_READY;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Stream Buffer
+//-----------------------------------------------------------------------------
+
+bool StreamBuffer::init(streamBuffer* sb, uint8_t* buf, uint32_t size, uint32_t triggerLevel) {
+    // the ring must be a power of two so free-running indices wrap cleanly
+    if (size < 8 || (size & (size - 1)) != 0 || ((uintptr_t)buf & 3) != 0)
+        return false;
+
+    sb->size = size;
+    sb->buf = buf;
+    sb->writeIndex = 0;
+    sb->readIndex = 0;
+    sb->reserveIndex = 0;
+    sb->reader = NO_TASK;
+    if (triggerLevel == 0)
+        triggerLevel = 1;
+    if (triggerLevel > size)
+        triggerLevel = size;
+    sb->triggerLevel = triggerLevel;
+    return true;
+}
+
+void StreamBuffer::flush(streamBuffer* sb) {
+    // reader side: discard everything the writer has published so far
+    sb->readIndex = sb->writeIndex;
+}
+
+uint32_t StreamBuffer::used(streamBuffer* sb) {
+    return sb->writeIndex - sb->readIndex;
+}
+
+uint32_t StreamBuffer::available(streamBuffer* sb) {
+    // largest payload that send() would accept right now
+    uint32_t free = sb->size - used(sb);
+    uint32_t tail = sb->size - (sb->writeIndex & (sb->size - 1));
+    uint32_t span = (free < tail) ? free : tail;
+    if (free > tail && free - tail > span)
+        span = free - tail;
+    if (span <= STREAM_RECORD_HEADER)
+        return 0;
+    span -= STREAM_RECORD_HEADER;
+    return (span < STREAM_WRAP_MARKER) ? span : STREAM_WRAP_MARKER - 1;
+}
+
+bool StreamBuffer::send(streamBuffer* sb, const void* data, uint32_t length) {
+    uint8_t* dst = reserve(sb, length);
+    if (dst == 0)
+        return false;
+
+    const uint8_t* src = (const uint8_t*)data;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        dst[i] = src[i];
+    }
+    commit(sb, length);
+    return true;
+}
+
+uint8_t* StreamBuffer::reserve(streamBuffer* sb, uint32_t length) {
+    // returns contiguous space for a record of up to length bytes, or 0 if full;
+    // nothing is visible to the reader until commit()
+    if (length >= STREAM_WRAP_MARKER)
+        return 0;
+
+    uint32_t rec = recordSize(length);
+    uint32_t w = sb->writeIndex;
+    uint32_t pos = w & (sb->size - 1);
+    uint32_t tail = sb->size - pos;
+    uint32_t free = sb->size - (w - sb->readIndex);
+
+    if (rec > tail)
+    {
+        // record would straddle the end: mark the tail as padding and restart at 0
+        if (tail + rec > free)
+            return 0;
+        *headerAt(sb, w) = STREAM_WRAP_MARKER;
+        w += tail;
+        pos = 0;
+    }
+    else if (rec > free)
+    {
+        return 0;
+    }
+
+    sb->reserveIndex = w;
+    return &sb->buf[pos + STREAM_RECORD_HEADER];
+}
+
+void StreamBuffer::commit(streamBuffer* sb, uint32_t length) {
+    // length may be shorter than what was reserved, never longer
+    *headerAt(sb, sb->reserveIndex) = (uint16_t)length;
+    memoryBarrier();
+    sb->writeIndex = sb->reserveIndex + recordSize(length);
+    memoryBarrier();
+    wakeReader(sb);
+}
+
+uint32_t StreamBuffer::receive(streamBuffer* sb, void* data, uint32_t maxLength, uint32_t timeout) {
+    // blocks until triggerLevel bytes are queued or the timeout expires, then
+    // returns the next record; returns 0 on timeout, or if the next record is
+    // longer than maxLength (it is left in place for peek())
+    uint32_t start = tickCount;
+
+    while (used(sb) < sb->triggerLevel)
+    {
+        uint32_t elapsed = tickCount - start;
+        if (timeout == NO_WAIT || (timeout != WAIT_FOREVER && elapsed >= timeout))
+            break;
+
+        // block first, then publish ourselves and re-check, so a writer
+        // running in between cannot lose the wakeup
+        tcb[taskCurrent].ticks = (timeout == WAIT_FOREVER) ? 0 : timeout - elapsed;
+        tcb[taskCurrent].state = STATE_BLOCKED;
+        sb->reader = taskCurrent;
+        memoryBarrier();
+        if (used(sb) >= sb->triggerLevel)
+        {
+            sb->reader = NO_TASK;
+            tcb[taskCurrent].ticks = 0;
+            tcb[taskCurrent].state = STATE_READY;
+        }
+        else
+        {
+            RTOS::yield();
+        }
+        sb->reader = NO_TASK;
+    }
+
+    uint32_t length;
+    const uint8_t* src = peek(sb, &length);
+    if (src == 0 || length > maxLength)
+        return 0;
+
+    uint8_t* dst = (uint8_t*)data;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        dst[i] = src[i];
+    }
+    release(sb);
+    return length;
+}
+
+const uint8_t* StreamBuffer::peek(streamBuffer* sb, uint32_t* length) {
+    // returns the payload of the oldest record in place, or 0 if empty
+    uint32_t r = sb->readIndex;
+    while (r != sb->writeIndex)
+    {
+        memoryBarrier();
+        uint16_t header = *headerAt(sb, r);
+        if (header != STREAM_WRAP_MARKER)
+        {
+            *length = header;
+            return &sb->buf[(r & (sb->size - 1)) + STREAM_RECORD_HEADER];
+        }
+        // skip the padded tail
+        r += sb->size - (r & (sb->size - 1));
+        sb->readIndex = r;
+    }
+    return 0;
+}
+
+void StreamBuffer::release(streamBuffer* sb) {
+    // drops the record returned by the last successful peek()
+    uint16_t header = *headerAt(sb, sb->readIndex);
+    memoryBarrier();
+    sb->readIndex += recordSize(header);
+}
@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ *
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RTOS-Framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+#ifndef STREAMBUF_H
+#define STREAMBUF_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Stream Buffer
+//-----------------------------------------------------------------------------
+
+/// A byte ring in the spirit of tRingBufObject (utils/ringbuf.h) that carries
+/// length-prefixed records, so variable-length frames share one buffer.
+///
+/// Each record is a 16-bit length header followed by the payload, padded to a
+/// 4-byte boundary and never split across the end of the ring; a record that
+/// does not fit in the tail leaves a wrap marker and starts again at offset 0.
+/// This keeps every record contiguous for the zero-copy peek/reserve APIs.
+///
+/// There must be exactly one writer (a task or an ISR) and one reader task.
+/// The writer only advances writeIndex and the reader only advances readIndex,
+/// so neither side needs a critical section.
+
+#define STREAM_RECORD_HEADER   2        // bytes of length prefix per record
+#define STREAM_WRAP_MARKER     0xFFFF   // header value: skip to start of ring
+
+struct streamBuffer
+{
+  uint32_t size;                  // ring size in bytes, power of two
+  volatile uint32_t writeIndex;   // free-running, advanced only by the writer
+  volatile uint32_t readIndex;    // free-running, advanced only by the reader
+  uint8_t *buf;                   // ring storage, 4-byte aligned
+  uint32_t triggerLevel;          // queued bytes needed to wake a blocked reader
+  uint32_t reserveIndex;          // writer: header position of reserved record
+  volatile uint8_t reader;        // task blocked in receive(), or NO_TASK
+};
+
+/// Class for stream buffer
+class StreamBuffer
+{
+public:
+    static bool init(streamBuffer* sb, uint8_t* buf, uint32_t size, uint32_t triggerLevel);
+    static void flush(streamBuffer* sb);
+    static uint32_t used(streamBuffer* sb);
+    static uint32_t available(streamBuffer* sb);
+
+    // writer side (task or ISR)
+    static bool send(streamBuffer* sb, const void* data, uint32_t length);
+    static uint8_t* reserve(streamBuffer* sb, uint32_t length);
+    static void commit(streamBuffer* sb, uint32_t length);
+
+    // reader side (one task)
+    static uint32_t receive(streamBuffer* sb, void* data, uint32_t maxLength, uint32_t timeout);
+    static const uint8_t* peek(streamBuffer* sb, uint32_t* length);
+    static void release(streamBuffer* sb);
+};
+
+#endif // STREAMBUF_H
@@ -0,0 +1,246 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "sync.h"
+#include "tm4c123gh6pm.h"
+
+// add the current task to a wait queue and mark it blocked;
+// caller holds the critical section and yields after leaving it
+static void blockOn(void* object, unsigned int* queue, unsigned int* queueSize, uint32_t timeout) {
+    queue[(*queueSize)++] = taskCurrent;
+    tcb[taskCurrent].waitObject = object;
+    tcb[taskCurrent].ticks = (timeout == WAIT_FOREVER) ? 0 : timeout;
+    tcb[taskCurrent].state = STATE_BLOCKED;
+}
+
+// remove the first waiter from a wait queue and make it ready
+static uint8_t wakeFirst(unsigned int* queue, unsigned int* queueSize) {
+    uint8_t task = queue[0];
+    (*queueSize)--;
+    for (unsigned int i = 0; i < *queueSize; i++)
+    {
+        queue[i] = queue[i + 1];
+    }
+    tcb[task].ticks = 0;
+    tcb[task].state = STATE_READY;
+    return task;
+}
+
+// remove a given task from a wait queue, returns false if it was not queued
+static bool removeWaiter(unsigned int* queue, unsigned int* queueSize, uint8_t task) {
+    for (unsigned int i = 0; i < *queueSize; i++)
+    {
+        if (queue[i] == task)
+        {
+            (*queueSize)--;
+            for (; i < *queueSize; i++)
+            {
+                queue[i] = queue[i + 1];
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Mutex
+//-----------------------------------------------------------------------------
+
+void Mutex::init(mutex* m) {
+    m->owner = NO_TASK;
+    m->queueSize = 0;
+}
+
+void Mutex::lock(mutex* m) {
+    uint32_t primask = disableInterrupts();
+
+    if (m->owner == NO_TASK)
+    {
+        m->owner = taskCurrent;
+        restoreInterrupts(primask);
+        return;
+    }
+
+    // lend our priority to the owner so it cannot be starved by middle tasks
+    if (tcb[m->owner].priority > tcb[taskCurrent].priority)
+    {
+        tcb[m->owner].priority = tcb[taskCurrent].priority;
+    }
+
+    // unlock() hands ownership to us before making us ready
+    blockOn(m, m->processQueue, &m->queueSize, WAIT_FOREVER);
+    restoreInterrupts(primask);
+    RTOS::yield();
+}
+
+bool Mutex::tryLock(mutex* m) {
+    bool ok = false;
+    uint32_t primask = disableInterrupts();
+    if (m->owner == NO_TASK)
+    {
+        m->owner = taskCurrent;
+        ok = true;
+    }
+    restoreInterrupts(primask);
+    return ok;
+}
+
+void Mutex::unlock(mutex* m) {
+    uint32_t primask = disableInterrupts();
+
+    if (m->owner == taskCurrent)
+    {
+        // drop any inherited priority
+        tcb[taskCurrent].priority = tcb[taskCurrent].currentPriority;
+
+        if (m->queueSize > 0)
+            m->owner = wakeFirst(m->processQueue, &m->queueSize);
+        else
+            m->owner = NO_TASK;
+    }
+
+    restoreInterrupts(primask);
+}
+
+//-----------------------------------------------------------------------------
+// Reader-Writer Lock
+//-----------------------------------------------------------------------------
+
+void RwLock::init(rwLock* rw) {
+    rw->readers = 0;
+    rw->writer = false;
+    rw->readQueueSize = 0;
+    rw->writeQueueSize = 0;
+}
+
+void RwLock::readLock(rwLock* rw) {
+    uint32_t primask = disableInterrupts();
+
+    // new readers queue behind any waiting writer so writers are not starved
+    if (!rw->writer && rw->writeQueueSize == 0)
+    {
+        rw->readers++;
+        restoreInterrupts(primask);
+        return;
+    }
+
+    blockOn(rw, rw->readQueue, &rw->readQueueSize, WAIT_FOREVER);
+    restoreInterrupts(primask);
+    RTOS::yield();
+}
+
+void RwLock::readUnlock(rwLock* rw) {
+    uint32_t primask = disableInterrupts();
+
+    rw->readers--;
+    if (rw->readers == 0 && rw->writeQueueSize > 0)
+    {
+        rw->writer = true;
+        wakeFirst(rw->writeQueue, &rw->writeQueueSize);
+    }
+
+    restoreInterrupts(primask);
+}
+
+void RwLock::writeLock(rwLock* rw) {
+    uint32_t primask = disableInterrupts();
+
+    if (!rw->writer && rw->readers == 0)
+    {
+        rw->writer = true;
+        restoreInterrupts(primask);
+        return;
+    }
+
+    blockOn(rw, rw->writeQueue, &rw->writeQueueSize, WAIT_FOREVER);
+    restoreInterrupts(primask);
+    RTOS::yield();
+}
+
+void RwLock::writeUnlock(rwLock* rw) {
+    uint32_t primask = disableInterrupts();
+
+    if (rw->writeQueueSize > 0)
+    {
+        // writer preference: pass the lock straight to the next writer
+        wakeFirst(rw->writeQueue, &rw->writeQueueSize);
+    }
+    else
+    {
+        // otherwise admit every waiting reader at once
+        rw->writer = false;
+        while (rw->readQueueSize > 0)
+        {
+            wakeFirst(rw->readQueue, &rw->readQueueSize);
+            rw->readers++;
+        }
+    }
+
+    restoreInterrupts(primask);
+}
+
+//-----------------------------------------------------------------------------
+// Condition Variable
+//-----------------------------------------------------------------------------
+
+void CondVar::init(condVar* cv) {
+    cv->queueSize = 0;
+}
+
+bool CondVar::wait(condVar* cv, mutex* m, uint32_t timeout) {
+    // atomically release m and wait for a signal, then re-acquire m;
+    // returns false if the timeout expired first
+    if (timeout == NO_WAIT)
+        return false;
+
+    uint32_t primask = disableInterrupts();
+    // queue before releasing the mutex so a signal cannot be missed
+    blockOn(cv, cv->processQueue, &cv->queueSize, timeout);
+    restoreInterrupts(primask);
+
+    Mutex::unlock(m);
+    RTOS::yield();
+
+    // still queued means we were woken by the timeout, not a signal
+    primask = disableInterrupts();
+    bool signaled = !removeWaiter(cv->processQueue, &cv->queueSize, taskCurrent);
+    restoreInterrupts(primask);
+
+    Mutex::lock(m);
+    return signaled;
+}
+
+void CondVar::signal(condVar* cv) {
+    uint32_t primask = disableInterrupts();
+    if (cv->queueSize > 0)
+        wakeFirst(cv->processQueue, &cv->queueSize);
+    restoreInterrupts(primask);
+}
+
+void CondVar::broadcast(condVar* cv) {
+    uint32_t primask = disableInterrupts();
+    while (cv->queueSize > 0)
+    {
+        wakeFirst(cv->processQueue, &cv->queueSize);
+    }
+    restoreInterrupts(primask);
+}
@@ -0,0 +1,92 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <stdint.h>
+#include "rtos.h"
+
+//-----------------------------------------------------------------------------
+// Mutex, Reader-Writer Lock and Condition Variable
+//-----------------------------------------------------------------------------
+
+/// These primitives are for task context only. Ownership is handed directly
+/// to the task being woken, so a woken task never has to re-contend.
+
+/// mutex with priority inheritance
+struct mutex
+{
+  uint8_t owner;                               // owning task, or NO_TASK
+  unsigned int queueSize;
+  unsigned int processQueue[MAX_QUEUE_SIZE];   // tasks waiting for the mutex
+};
+
+/// writer-preferring reader-writer lock
+struct rwLock
+{
+  unsigned int readers;                        // readers holding the lock
+  bool writer;                                 // a writer holds the lock
+  unsigned int readQueueSize;
+  unsigned int readQueue[MAX_QUEUE_SIZE];      // readers waiting for the lock
+  unsigned int writeQueueSize;
+  unsigned int writeQueue[MAX_QUEUE_SIZE];     // writers waiting for the lock
+};
+
+/// condition variable, used together with a mutex
+struct condVar
+{
+  unsigned int queueSize;
+  unsigned int processQueue[MAX_QUEUE_SIZE];   // tasks waiting for a signal
+};
+
+/// Class for mutex
+class Mutex
+{
+public:
+    static void init(mutex* m);
+    static void lock(mutex* m);
+    static bool tryLock(mutex* m);
+    static void unlock(mutex* m);
+};
+
+/// Class for reader-writer lock
+class RwLock
+{
+public:
+    static void init(rwLock* rw);
+    static void readLock(rwLock* rw);
+    static void readUnlock(rwLock* rw);
+    static void writeLock(rwLock* rw);
+    static void writeUnlock(rwLock* rw);
+};
+
+/// Class for condition variable
+class CondVar
+{
+public:
+    static void init(condVar* cv);
+    static bool wait(condVar* cv, mutex* m, uint32_t timeout);
+    static void signal(condVar* cv);
+    static void broadcast(condVar* cv);
+};
+
+#endif // SYNC_H
@@ -0,0 +1,214 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "workqueue.h"
+#include "rtos.h"
+
+// Define variables
+struct workQueue workQueues[MAX_WORK_QUEUES];
+static struct workItem* delayedList = 0;
+
+// append to a worker queue and wake its worker; caller masks interrupts
+static void enqueue(workItem* work) {
+    struct workQueue* q = &workQueues[work->queue];
+    work->next = 0;
+    work->state = WORK_QUEUED;
+    if (q->tail != 0)
+        q->tail->next = work;
+    else
+        q->head = work;
+    q->tail = work;
+
+    if (q->waiting)
+    {
+        q->waiting = false;
+        tcb[q->worker].state = STATE_READY;
+    }
+}
+
+// unlink from a singly linked list, reporting the predecessor through prev
+static bool unlink(workItem** head, workItem* work, workItem** prev) {
+    workItem* p = 0;
+    workItem* it = *head;
+    while (it != 0 && it != work)
+    {
+        p = it;
+        it = it->next;
+    }
+    if (it == 0)
+        return false;
+    if (p != 0)
+        p->next = work->next;
+    else
+        *head = work->next;
+    *prev = p;
+    return true;
+}
+
+static void worker(uint8_t queue) {
+    struct workQueue* q = &workQueues[queue];
+    while (true)
+    {
+        uint32_t primask = disableInterrupts();
+        workItem* work = q->head;
+        if (work == 0)
+        {
+            // nothing to do: block until submit() hands us work
+            q->waiting = true;
+            tcb[taskCurrent].ticks = 0;
+            tcb[taskCurrent].state = STATE_BLOCKED;
+            restoreInterrupts(primask);
+            RTOS::yield();
+            continue;
+        }
+        q->head = work->next;
+        if (q->head == 0)
+            q->tail = 0;
+        // idle before running so the handler may resubmit itself
+        work->state = WORK_IDLE;
+        restoreInterrupts(primask);
+
+        work->fn(work);
+    }
+}
+
+static void workerHigh()   { worker(WORK_QUEUE_HIGH); }
+static void workerNormal() { worker(WORK_QUEUE_NORMAL); }
+static void workerLow()    { worker(WORK_QUEUE_LOW); }
+
+//-----------------------------------------------------------------------------
+// Work Queues
+//-----------------------------------------------------------------------------
+
+bool WorkQueue::init() {
+    // create the worker tasks; call after rtosInit and before rtosStart
+    static const _fn workers[MAX_WORK_QUEUES] = { workerHigh, workerNormal, workerLow };
+    static const uint8_t priorities[MAX_WORK_QUEUES] = { WORK_PRIORITY_HIGH, WORK_PRIORITY_NORMAL, WORK_PRIORITY_LOW };
+    bool ok = true;
+
+    delayedList = 0;
+    for (uint8_t i = 0; i < MAX_WORK_QUEUES; i++)
+    {
+        workQueues[i].head = 0;
+        workQueues[i].tail = 0;
+        workQueues[i].waiting = false;
+        workQueues[i].worker = NO_TASK;
+        ok &= RTOS::createProcess(workers[i], priorities[i]);
+
+        // remember which tcb the worker landed in
+        for (uint8_t t = 0; t < MAX_TASKS; t++)
+        {
+            if (tcb[t].pid == (void*)workers[i])
+                workQueues[i].worker = t;
+        }
+    }
+    // delayed work counts down on the kernel tick
+    ok &= RTOS::addTickHook(WorkQueue::tickIsr);
+    return ok;
+}
+
+void WorkQueue::initWork(workItem* work, _workFn fn, uint8_t queue) {
+    work->next = 0;
+    work->fn = fn;
+    work->ticks = 0;
+    work->queue = (queue < MAX_WORK_QUEUES) ? queue : WORK_QUEUE_LOW;
+    work->state = WORK_IDLE;
+}
+
+bool WorkQueue::submit(workItem* work) {
+    // returns false if the item is already pending
+    bool ok = false;
+    uint32_t primask = disableInterrupts();
+    if (work->state == WORK_IDLE)
+    {
+        enqueue(work);
+        ok = true;
+    }
+    restoreInterrupts(primask);
+    return ok;
+}
+
+bool WorkQueue::submitDelayed(workItem* work, uint32_t ticks) {
+    // queue the item after the given number of ticks; 0 queues immediately
+    if (ticks == 0)
+        return submit(work);
+
+    bool ok = false;
+    uint32_t primask = disableInterrupts();
+    if (work->state == WORK_IDLE)
+    {
+        work->ticks = ticks;
+        work->state = WORK_DELAYED;
+        work->next = delayedList;
+        delayedList = work;
+        ok = true;
+    }
+    restoreInterrupts(primask);
+    return ok;
+}
+
+bool WorkQueue::cancel(workItem* work) {
+    // returns true if the item was pending and will not run; an item whose
+    // handler is already running is not affected
+    bool ok = false;
+    workItem* prev;
+    uint32_t primask = disableInterrupts();
+    if (work->state == WORK_DELAYED)
+    {
+        ok = unlink(&delayedList, work, &prev);
+    }
+    else if (work->state == WORK_QUEUED)
+    {
+        struct workQueue* q = &workQueues[work->queue];
+        ok = unlink(&q->head, work, &prev);
+        if (ok && q->tail == work)
+            q->tail = prev;
+    }
+    if (ok)
+        work->state = WORK_IDLE;
+    restoreInterrupts(primask);
+    return ok;
+}
+
+void WorkQueue::tickIsr() {
+    // tick hook registered by init, runs once per tick
+    uint32_t primask = disableInterrupts();
+    workItem* prev = 0;
+    workItem* work = delayedList;
+    while (work != 0)
+    {
+        workItem* next = work->next;
+        if (--work->ticks == 0)
+        {
+            if (prev != 0)
+                prev->next = next;
+            else
+                delayedList = next;
+            enqueue(work);
+        }
+        else
+        {
+            prev = work;
+        }
+        work = next;
+    }
+    restoreInterrupts(primask);
+}
@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef WORKQUEUE_H
+#define WORKQUEUE_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Work Queues
+//-----------------------------------------------------------------------------
+
+/// Deferred work runs on a few shared worker tasks instead of one task per
+/// job. Work items are statically allocated by the caller and linked into a
+/// queue in O(1); submit() and submitDelayed() may be called from an ISR.
+
+/// worker queues, one worker task each
+#define WORK_QUEUE_HIGH      0
+#define WORK_QUEUE_NORMAL    1
+#define WORK_QUEUE_LOW       2
+#define MAX_WORK_QUEUES      3
+
+/// worker task priorities (0=highest, 7=lowest)
+#define WORK_PRIORITY_HIGH   1
+#define WORK_PRIORITY_NORMAL 4
+#define WORK_PRIORITY_LOW    6
+
+/// work item state
+#define WORK_IDLE            0    // not queued, may be (re)submitted
+#define WORK_QUEUED          1    // waiting on a worker queue
+#define WORK_DELAYED         2    // waiting for its delay to expire
+
+struct workItem;
+typedef void (*_workFn)(struct workItem* work);
+
+struct workItem
+{
+  struct workItem* next;     // link in worker or delayed list
+  _workFn fn;                // handler, runs in worker task context
+  uint32_t ticks;            // ticks until a delayed item is queued
+  uint8_t queue;             // see WORK_QUEUE_ values above
+  volatile uint8_t state;    // see WORK_ values above
+};
+
+struct workQueue
+{
+  struct workItem* head;     // next item to run
+  struct workItem* tail;     // last item queued
+  uint8_t worker;            // worker task index
+  volatile bool waiting;     // worker is blocked on an empty queue
+};
+
+extern struct workQueue workQueues[MAX_WORK_QUEUES];
+
+/// Class for work queues
+class WorkQueue
+{
+public:
+    static bool init();
+    static void initWork(workItem* work, _workFn fn, uint8_t queue);
+    static bool submit(workItem* work);
+    static bool submitDelayed(workItem* work, uint32_t ticks);
+    static bool cancel(workItem* work);
+    static void tickIsr();
+};
+
+#endif // WORKQUEUE_H
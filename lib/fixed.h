@@ -0,0 +1,514 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ *
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * RTOS-Framework is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Fixed Point
+//-----------------------------------------------------------------------------
+
+/// Header-only Q-format arithmetic in place of TivaWare's IQmath, which ships
+/// as a prebuilt library and so cannot be inlined or built for the host.
+///
+/// Fixed<IntBits, FracBits> holds a 32-bit two's complement value; IntBits
+/// counts the sign bit, so Fixed<8, 24> is IQmath's _iq24 and Fixed<1, 31>
+/// is Q31. Everything is constexpr, and no path uses the FPU or a library
+/// call, so each operation takes the same number of cycles for any input.
+///
+///   + - * /         wrap like int32_t; * truncates, / saturates its result
+///   addSat/subSat   QADD/QSUB on the M4, a 64-bit clamp elsewhere
+///   mulSat/mac      SMULL and SMLAL; mac keeps the full 64-bit sum so a dot
+///                   product rounds once, in fromAcc
+///   Fixed<I2, F2>   conversion between formats, SSAT then LSL when narrowing
+///
+/// FixedMath provides sin, cos, atan2, sqrt and exp from 257-entry tables
+/// built at compile time, with linear interpolation between entries. Angles
+/// are in radians; a table is only linked into images that use it.
+
+#define FIXED_PI        3.14159265358979323846
+
+//-----------------------------------------------------------------------------
+// Saturation helpers
+//-----------------------------------------------------------------------------
+
+/// Raw 32-bit operations shared by every format. The M4 instructions are
+/// used at run time only; constant evaluation takes the portable path.
+struct FixedOps
+{
+    static constexpr int32_t saturate(int64_t v) {
+        return v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (int32_t)v;
+    }
+
+    // shift without the undefined behaviour of << on negative values
+    static constexpr int32_t shiftLeft(int32_t v, int s) {
+        return (int32_t)((uint32_t)v << s);
+    }
+
+#if defined(__ARM_FEATURE_DSP)
+    static inline int32_t qadd(int32_t a, int32_t b) {
+        int32_t r;
+        __asm__("qadd %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+        return r;
+    }
+
+    static inline int32_t qsub(int32_t a, int32_t b) {
+        int32_t r;
+        __asm__("qsub %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+        return r;
+    }
+#endif
+
+#if defined(__ARM_FEATURE_SAT)
+    template <int Bits>
+    static inline int32_t ssat(int32_t v) {
+        int32_t r;
+        __asm__("ssat %0, %1, %2" : "=r"(r) : "I"(Bits), "r"(v));
+        return r;
+    }
+#endif
+
+    static constexpr int32_t add(int32_t a, int32_t b) {
+#if defined(__ARM_FEATURE_DSP)
+        if (!__builtin_is_constant_evaluated())
+            return qadd(a, b);
+#endif
+        return saturate((int64_t)a + b);
+    }
+
+    static constexpr int32_t sub(int32_t a, int32_t b) {
+#if defined(__ARM_FEATURE_DSP)
+        if (!__builtin_is_constant_evaluated())
+            return qsub(a, b);
+#endif
+        return saturate((int64_t)a - b);
+    }
+
+    // clamp to a signed Bits-wide range
+    template <int Bits>
+    static constexpr int32_t clamp(int32_t v) {
+        static_assert(Bits >= 1 && Bits <= 32, "saturation width out of range");
+        if constexpr (Bits == 32)
+            return v;
+        else
+        {
+#if defined(__ARM_FEATURE_SAT)
+            if (!__builtin_is_constant_evaluated())
+                return ssat<Bits>(v);
+#endif
+            constexpr int32_t high = (int32_t)((1u << (Bits - 1)) - 1);
+            return v > high ? high : v < -high - 1 ? -high - 1 : v;
+        }
+    }
+
+    // move a raw value from From fraction bits to To, saturating on overflow
+    template <int From, int To>
+    static constexpr int32_t rescale(int32_t v) {
+        if constexpr (From > To)
+            return v >> (From - To);
+        else if constexpr (From < To)
+        {
+            // a clamped positive value fills the step bits too, so it lands
+            // on INT32_MAX rather than the largest multiple of the step
+            int32_t c = clamp<32 - (To - From)>(v);
+            int32_t r = shiftLeft(c, To - From);
+            return (c != v && v > 0) ? r | (int32_t)((1u << (To - From)) - 1) : r;
+        }
+        else
+            return v;
+    }
+
+    // same for a 64-bit intermediate, e.g. a product or an accumulator
+    template <int From, int To>
+    static constexpr int32_t rescale(int64_t v) {
+        if constexpr (From > To)
+            return saturate(v >> (From - To));
+        else
+            return saturate(v * ((int64_t)1 << (To - From)));
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Fixed
+//-----------------------------------------------------------------------------
+
+template <int IntBits, int FracBits>
+class Fixed
+{
+    static_assert(IntBits >= 1 && FracBits >= 0 && IntBits + FracBits == 32,
+                  "Fixed formats are 32 bits wide, sign included in IntBits");
+
+public:
+    static constexpr int intBits = IntBits;
+    static constexpr int fracBits = FracBits;
+    static constexpr int64_t one = (int64_t)1 << FracBits;
+
+    int32_t raw;
+
+    constexpr Fixed() : raw(0) {}
+
+    // integers saturate to the format's range
+    constexpr explicit Fixed(int value) : raw(FixedOps::saturate((int64_t)value * one)) {}
+
+    // rounds to nearest; meant for constants, the M4 has no double hardware
+    constexpr explicit Fixed(double value) : raw(fromReal(value)) {}
+
+    constexpr explicit Fixed(float value) : raw(fromReal(value)) {}
+
+    template <int I2, int F2>
+    constexpr explicit Fixed(Fixed<I2, F2> other) : raw(FixedOps::rescale<F2, FracBits>(other.raw)) {}
+
+    static constexpr Fixed fromRaw(int32_t r) {
+        Fixed f;
+        f.raw = r;
+        return f;
+    }
+
+    // a raw value with From fraction bits, saturated into this format
+    template <int From, typename T>
+    static constexpr Fixed fromQ(T r) {
+        return fromRaw(FixedOps::rescale<From, FracBits>(r));
+    }
+
+    static constexpr Fixed max() { return fromRaw(INT32_MAX); }
+    static constexpr Fixed min() { return fromRaw(INT32_MIN); }
+    static constexpr Fixed epsilon() { return fromRaw(1); }
+
+    constexpr float toFloat() const { return (float)raw * (1.0f / (float)one); }
+    constexpr double toDouble() const { return (double)raw / (double)one; }
+    constexpr int32_t toInt() const { return raw >> FracBits; }   // floor
+
+    //-------------------------------------------------------------------------
+    // Wrapping arithmetic
+    //-------------------------------------------------------------------------
+
+    constexpr Fixed operator-() const { return fromRaw((int32_t)(0u - (uint32_t)raw)); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) {
+        return fromRaw((int32_t)((uint32_t)a.raw + (uint32_t)b.raw));
+    }
+
+    friend constexpr Fixed operator-(Fixed a, Fixed b) {
+        return fromRaw((int32_t)((uint32_t)a.raw - (uint32_t)b.raw));
+    }
+
+    // SMULL and a shift pair; truncates toward minus infinity
+    friend constexpr Fixed operator*(Fixed a, Fixed b) {
+        return fromRaw((int32_t)(((int64_t)a.raw * b.raw) >> FracBits));
+    }
+
+    // 64-bit division, so not constant time; b must be nonzero
+    friend constexpr Fixed operator/(Fixed a, Fixed b) {
+        return fromRaw(FixedOps::saturate((int64_t)a.raw * one / b.raw));
+    }
+
+    friend constexpr Fixed operator*(Fixed a, int32_t k) {
+        return fromRaw((int32_t)((uint32_t)a.raw * (uint32_t)k));
+    }
+
+    friend constexpr Fixed operator/(Fixed a, int32_t k) { return fromRaw(a.raw / k); }
+
+    constexpr Fixed& operator+=(Fixed b) { return *this = *this + b; }
+    constexpr Fixed& operator-=(Fixed b) { return *this = *this - b; }
+    constexpr Fixed& operator*=(Fixed b) { return *this = *this * b; }
+    constexpr Fixed& operator/=(Fixed b) { return *this = *this / b; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+    //-------------------------------------------------------------------------
+    // Saturating arithmetic
+    //-------------------------------------------------------------------------
+
+    static constexpr Fixed addSat(Fixed a, Fixed b) { return fromRaw(FixedOps::add(a.raw, b.raw)); }
+    static constexpr Fixed subSat(Fixed a, Fixed b) { return fromRaw(FixedOps::sub(a.raw, b.raw)); }
+
+    static constexpr Fixed mulSat(Fixed a, Fixed b) {
+        return fromRaw(FixedOps::saturate(((int64_t)a.raw * b.raw) >> FracBits));
+    }
+
+    static constexpr Fixed abs(Fixed a) {
+        return fromRaw(a.raw < 0 ? FixedOps::sub(0, a.raw) : a.raw);
+    }
+
+    // SMLAL: the accumulator has 2 * FracBits fraction bits
+    static constexpr int64_t mac(int64_t acc, Fixed a, Fixed b) {
+        return acc + (int64_t)a.raw * b.raw;
+    }
+
+    // round a mac() sum back to this format
+    static constexpr Fixed fromAcc(int64_t acc) {
+        if constexpr (FracBits == 0)
+            return fromRaw(FixedOps::saturate(acc));
+        else
+            return fromRaw(FixedOps::saturate((acc + (one >> 1)) >> FracBits));
+    }
+
+private:
+    template <typename T>
+    static constexpr int32_t fromReal(T value) {
+        T scaled = value * (T)one;
+        if (scaled >= (T)2147483647.0)
+            return INT32_MAX;
+        if (scaled <= (T)-2147483648.0)
+            return INT32_MIN;
+        return (int32_t)(scaled >= 0 ? scaled + (T)0.5 : scaled - (T)0.5);
+    }
+};
+
+typedef Fixed<1, 31>  Q31;
+typedef Fixed<2, 30>  Q30;
+typedef Fixed<8, 24>  Q24;
+typedef Fixed<16, 16> Q16;
+
+//-----------------------------------------------------------------------------
+// Lookup tables
+//-----------------------------------------------------------------------------
+
+template <typename T, int N>
+struct fixedTable
+{
+  T v[N];
+};
+
+/// Double-precision series used only while the compiler builds the tables.
+struct FixedTableGen
+{
+    static constexpr int64_t round(double v) {
+        return (int64_t)(v >= 0 ? v + 0.5 : v - 0.5);
+    }
+
+    static constexpr double sqrt(double x) {
+        double r = x > 1 ? x : 1;
+        for (int i = 0; i < 64; i++)
+            r = 0.5 * (r + x / r);
+        return r;
+    }
+
+    static constexpr double sin(double x) {
+        double term = x, sum = x;
+        for (int n = 1; n < 16; n++)
+        {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    // two half-angle steps bring t <= 1 under tan(pi / 16) for the series
+    static constexpr double atan(double t) {
+        double a = t / (1 + sqrt(1 + t * t));
+        a = a / (1 + sqrt(1 + a * a));
+        double power = a, sum = a;
+        for (int n = 1; n < 24; n++)
+        {
+            power *= -a * a;
+            sum += power / (2 * n + 1);
+        }
+        return 4 * sum;
+    }
+
+    static constexpr double exp2(double f) {
+        double x = f * 0.69314718055994530942, term = 1, sum = 1;
+        for (int n = 1; n < 24; n++)
+        {
+            term *= x / n;
+            sum += term;
+        }
+        return sum;
+    }
+
+    // sin over a quarter turn, Q30; the last entry repeats for the mirror
+    static constexpr fixedTable<int32_t, 258> makeSin() {
+        fixedTable<int32_t, 258> t{};
+        for (int i = 0; i <= 256; i++)
+            t.v[i] = (int32_t)round(sin(i * (FIXED_PI / 2) / 256) * (1 << 30));
+        t.v[257] = t.v[256];
+        return t;
+    }
+
+    // atan over [0, 1], Q30
+    static constexpr fixedTable<int32_t, 258> makeAtan() {
+        fixedTable<int32_t, 258> t{};
+        for (int i = 0; i <= 256; i++)
+            t.v[i] = (int32_t)round(atan(i / 256.0) * (1 << 30));
+        t.v[257] = t.v[256];
+        return t;
+    }
+
+    // sqrt over [0.25, 1], Q31 unsigned
+    static constexpr fixedTable<uint32_t, 193> makeSqrt() {
+        fixedTable<uint32_t, 193> t{};
+        for (int i = 0; i <= 192; i++)
+            t.v[i] = (uint32_t)round(sqrt((i + 64) / 256.0) * 2147483648.0);
+        return t;
+    }
+
+    // 2^f over [0, 1], Q30 unsigned
+    static constexpr fixedTable<uint32_t, 257> makeExp2() {
+        fixedTable<uint32_t, 257> t{};
+        for (int i = 0; i <= 256; i++)
+            t.v[i] = (uint32_t)round(exp2(i / 256.0) * (1 << 30));
+        return t;
+    }
+};
+
+//-----------------------------------------------------------------------------
+// Fixed Math
+//-----------------------------------------------------------------------------
+
+/// Class for fixed-point elementary functions
+class FixedMath
+{
+public:
+    static constexpr fixedTable<int32_t, 258> sinTable = FixedTableGen::makeSin();
+    static constexpr fixedTable<int32_t, 258> atanTable = FixedTableGen::makeAtan();
+    static constexpr fixedTable<uint32_t, 193> sqrtTable = FixedTableGen::makeSqrt();
+    static constexpr fixedTable<uint32_t, 257> exp2Table = FixedTableGen::makeExp2();
+
+    static constexpr uint32_t TURN_SCALE = 683565276;   // 2^32 / 2pi
+    static constexpr uint32_t PI_Q30 = 3373259426u;
+    static constexpr int32_t LOG2E_Q30 = 1549082005;
+
+    template <int I, int F>
+    static constexpr Fixed<I, F> sin(Fixed<I, F> x) {
+        return Fixed<I, F>::template fromQ<30>(sinTurn(turn<F>(x.raw)));
+    }
+
+    template <int I, int F>
+    static constexpr Fixed<I, F> cos(Fixed<I, F> x) {
+        return Fixed<I, F>::template fromQ<30>(sinTurn(turn<F>(x.raw) + (1u << 30)));
+    }
+
+    // angle of (x, y) in (-pi, pi]; the format needs IntBits >= 3 to hold pi
+    template <int I, int F>
+    static constexpr Fixed<I, F> atan2(Fixed<I, F> y, Fixed<I, F> x) {
+        if (x.raw == 0 && y.raw == 0)
+            return Fixed<I, F>();
+
+        uint32_t ax = x.raw < 0 ? 0u - (uint32_t)x.raw : (uint32_t)x.raw;
+        uint32_t ay = y.raw < 0 ? 0u - (uint32_t)y.raw : (uint32_t)y.raw;
+        bool steep = ay > ax;
+        uint32_t num = steep ? ax : ay;
+        uint32_t den = steep ? ay : ax;
+
+        // ratio num / den in [0, 1], Q30, by reciprocal rather than UDIV chains
+        int s = __builtin_clz(den);
+        den <<= s;
+        num <<= s;
+        uint32_t ratio = (uint32_t)(((uint64_t)num * reciprocal(den)) >> 32);
+        uint32_t angle = (uint32_t)interpolate(atanTable.v, ratio >> 22, ratio & 0x3FFFFF, 22);
+
+        if (steep)
+            angle = (PI_Q30 >> 1) - angle;
+        if (x.raw < 0)
+            angle = PI_Q30 - angle;
+        return Fixed<I, F>::template fromQ<30>(y.raw < 0 ? -(int64_t)angle : (int64_t)angle);
+    }
+
+    // negative inputs return 0
+    template <int I, int F>
+    static constexpr Fixed<I, F> sqrt(Fixed<I, F> x) {
+        if (x.raw <= 0)
+            return Fixed<I, F>();
+
+        // normalize to [2^30, 2^32) with an even total exponent
+        int z = __builtin_clz((uint32_t)x.raw);
+        int s = z - ((z + F) & 1);
+        uint32_t n = (uint32_t)x.raw << s;
+        uint32_t i = (n >> 24) - 64;
+        uint32_t root = sqrtTable.v[i] +
+                        (uint32_t)(((uint64_t)(sqrtTable.v[i + 1] - sqrtTable.v[i]) * (n & 0xFFFFFF)) >> 24);
+
+        // root is sqrt(n / 2^32) in Q31; scale back by half the exponent
+        int k = 15 - (F - s) / 2;
+        if (k > 0)
+            root = (root >> k) + ((root >> (k - 1)) & 1);
+        return Fixed<I, F>::fromRaw(root > INT32_MAX ? INT32_MAX : (int32_t)root);
+    }
+
+    // saturates to max() on overflow
+    template <int I, int F>
+    static constexpr Fixed<I, F> exp(Fixed<I, F> x) {
+        // e^x = 2^n * 2^f with y = x log2(e) = n + f, 0 <= f < 1
+        int64_t y = ((int64_t)x.raw * LOG2E_Q30) >> 30;
+        int64_t n = y >> F;
+        uint32_t f = 0;
+        if constexpr (F > 0)
+            f = (uint32_t)(y - n * ((int64_t)1 << F)) << (32 - F);
+        uint32_t power = exp2Table.v[f >> 24] +
+                         (uint32_t)(((uint64_t)(exp2Table.v[(f >> 24) + 1] - exp2Table.v[f >> 24]) *
+                                     (f & 0xFFFFFF)) >> 24);
+
+        // power is 2^f in Q30, so the result is power << (n + F - 30)
+        int64_t shift = n + F - 30;
+        if (shift > 0)
+            return Fixed<I, F>::max();
+        if (shift <= -32)
+            return Fixed<I, F>();
+        int k = (int)-shift;
+        if (k > 0)
+            power = (power >> k) + ((power >> (k - 1)) & 1);
+        else if (power > INT32_MAX)
+            return Fixed<I, F>::max();
+        return Fixed<I, F>::fromRaw((int32_t)power);
+    }
+
+private:
+    // radians to a fraction of a turn, 2^32 per turn, wrapping for free
+    template <int F>
+    static constexpr uint32_t turn(int32_t raw) {
+        return (uint32_t)(((int64_t)raw * TURN_SCALE) >> F);
+    }
+
+    static constexpr int32_t interpolate(const int32_t* t, uint32_t i, uint32_t frac, int bits) {
+        return t[i] + (int32_t)(((int64_t)(t[i + 1] - t[i]) * frac) >> bits);
+    }
+
+    // sin of a turn fraction, Q30, from the quarter-wave table
+    static constexpr int32_t sinTurn(uint32_t phase) {
+        uint32_t quadrant = phase >> 30;
+        uint32_t p = phase & 0x3FFFFFFF;
+        if (quadrant & 1)
+            p = 0x40000000 - p;
+        int32_t v = interpolate(sinTable.v, p >> 22, p & 0x3FFFFF, 22);
+        return (quadrant & 2) ? -v : v;
+    }
+
+    // 1 / d for d in [2^31, 2^32) read as [0.5, 1), Q30: linear seed and
+    // three Newton steps, two SMULL each
+    static constexpr uint32_t reciprocal(uint32_t d) {
+        uint32_t r = 3031741621u - (uint32_t)(((uint64_t)2021161081u * d) >> 32);
+        for (int i = 0; i < 3; i++)
+        {
+            uint32_t e = (uint32_t)((1ull << 31) - (((uint64_t)d * r) >> 32));
+            r = (uint32_t)(((uint64_t)r * e) >> 30);
+        }
+        return r;
+    }
+};
+
+#endif // FIXED_H
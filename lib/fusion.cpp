@@ -0,0 +1,337 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+#include "fusion.h"
+
+#define GYRO_SCALE      (3.14159265f / 180.0f / IMU_GYRO_LSB_PER_DPS)      // rad/s per LSB
+#define GYRO_SCALE_Q24  ((int32_t)(GYRO_SCALE * 16777216.0f + 0.5f))
+#define ONE_Q30         (1 << 30)
+
+//-----------------------------------------------------------------------------
+// Single precision
+//-----------------------------------------------------------------------------
+
+static inline float invSqrt(float x) {
+#if defined(__ARM_FP)
+    float root;
+    __asm__("vsqrt.f32 %0, %1" : "=t"(root) : "t"(x));
+    return 1.0f / root;
+#else
+    return 1.0f / __builtin_sqrtf(x);
+#endif
+}
+
+static inline float sqrtSingle(float x) {
+#if defined(__ARM_FP)
+    float root;
+    __asm__("vsqrt.f32 %0, %1" : "=t"(root) : "t"(x));
+    return root;
+#else
+    return __builtin_sqrtf(x);
+#endif
+}
+
+void Fusion::init(fusionFilter* f, float kp, float ki) {
+    f->q[0] = 1.0f;
+    f->q[1] = 0.0f;
+    f->q[2] = 0.0f;
+    f->q[3] = 0.0f;
+    f->integral[0] = 0.0f;
+    f->integral[1] = 0.0f;
+    f->integral[2] = 0.0f;
+    f->kp = kp;
+    f->ki = ki;
+}
+
+void Fusion::update(fusionFilter* f, const imuBlock* block) {
+    // state lives in registers for the whole block
+    float q0 = f->q[0], q1 = f->q[1], q2 = f->q[2], q3 = f->q[3];
+    float ix = f->integral[0], iy = f->integral[1], iz = f->integral[2];
+    const float kp = f->kp;
+    const float kiDt = f->ki * block->period * 1e-6f;
+    const float halfDt = 0.5f * block->period * 1e-6f;
+
+    for (uint16_t i = 0; i < block->count; i++)
+    {
+        float gx = block->gx[i] * GYRO_SCALE;
+        float gy = block->gy[i] * GYRO_SCALE;
+        float gz = block->gz[i] * GYRO_SCALE;
+        float ax = block->ax[i];
+        float ay = block->ay[i];
+        float az = block->az[i];
+        float norm = ax * ax + ay * ay + az * az;
+
+        if (norm > 0.0f)
+        {
+            float scale = invSqrt(norm);
+            ax *= scale;
+            ay *= scale;
+            az *= scale;
+
+            // rotation matrix rows as needed; the last row is gravity as the attitude expects it
+            float q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+            float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+            float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+            float r20 = 2.0f * (q1q3 - q0q2);
+            float r21 = 2.0f * (q2q3 + q0q1);
+            float r22 = 1.0f - 2.0f * (q1q1 + q2q2);
+            float ex = ay * r22 - az * r21;
+            float ey = az * r20 - ax * r22;
+            float ez = ax * r21 - ay * r20;
+
+            float mx = block->mx[i];
+            float my = block->my[i];
+            float mz = block->mz[i];
+            norm = mx * mx + my * my + mz * mz;
+            if (norm > 0.0f)
+            {
+                scale = invSqrt(norm);
+                mx *= scale;
+                my *= scale;
+                mz *= scale;
+                float r00 = 1.0f - 2.0f * (q2q2 + q3q3);
+                float r01 = 2.0f * (q1q2 - q0q3);
+                float r02 = 2.0f * (q1q3 + q0q2);
+                float r10 = 2.0f * (q1q2 + q0q3);
+                float r11 = 1.0f - 2.0f * (q1q1 + q3q3);
+                float r12 = 2.0f * (q2q3 - q0q1);
+
+                // flux in the earth frame, folded into the x-z plane, then back in the sensor frame
+                float hx = r00 * mx + r01 * my + r02 * mz;
+                float hy = r10 * mx + r11 * my + r12 * mz;
+                float bx = sqrtSingle(hx * hx + hy * hy);
+                float bz = r20 * mx + r21 * my + r22 * mz;
+                float wx = r00 * bx + r20 * bz;
+                float wy = r01 * bx + r21 * bz;
+                float wz = r02 * bx + r22 * bz;
+                ex += my * wz - mz * wy;
+                ey += mz * wx - mx * wz;
+                ez += mx * wy - my * wx;
+            }
+
+            ix += kiDt * ex;
+            iy += kiDt * ey;
+            iz += kiDt * ez;
+            gx += kp * ex;
+            gy += kp * ey;
+            gz += kp * ez;
+        }
+        gx = (gx + ix) * halfDt;
+        gy = (gy + iy) * halfDt;
+        gz = (gz + iz) * halfDt;
+
+        float a = q0, b = q1, c = q2;
+        q0 += -b * gx - c * gy - q3 * gz;
+        q1 += a * gx + c * gz - q3 * gy;
+        q2 += a * gy - b * gz + q3 * gx;
+        q3 += a * gz + b * gy - c * gx;
+
+        float scale = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+        q0 *= scale;
+        q1 *= scale;
+        q2 *= scale;
+        q3 *= scale;
+    }
+
+    f->q[0] = q0;
+    f->q[1] = q1;
+    f->q[2] = q2;
+    f->q[3] = q3;
+    f->integral[0] = ix;
+    f->integral[1] = iy;
+    f->integral[2] = iz;
+}
+
+//-----------------------------------------------------------------------------
+// Fixed point
+//-----------------------------------------------------------------------------
+
+// Q30 product; SMULL and a funnel shift on the M4
+static inline int32_t mul30(int32_t a, int32_t b) {
+    return (int32_t)(((int64_t)a * b) >> 30);
+}
+
+// x*x + y*y + z*z of raw counts; wraps past INT32_MAX, so read it unsigned
+static inline uint32_t sumSquares(int16_t x, int16_t y, int16_t z) {
+#if defined(__ARM_FEATURE_DSP)
+    uint32_t xy = (uint16_t)x | (uint32_t)(uint16_t)y << 16;
+    uint32_t sum;
+    __asm__("smuad %0, %1, %1" : "=r"(sum) : "r"(xy));
+    __asm__("smlabb %0, %1, %1, %0" : "+r"(sum) : "r"((int32_t)z));
+    return sum;
+#else
+    return (uint32_t)(x * x) + (uint32_t)(y * y) + (uint32_t)(z * z);
+#endif
+}
+
+// floor(sqrt(n)) for n > 0, one result bit per step from the top set bit
+static uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << ((31 - __builtin_clz(n)) & ~1);
+    while (bit)
+    {
+        if (n >= root + bit)
+        {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// raw vector to Q30 unit vector; false if it is zero
+static inline bool normalize(int16_t x, int16_t y, int16_t z, int32_t* v) {
+    uint32_t sum = sumSquares(x, y, z);
+    if (sum == 0)
+        return false;
+    int32_t recip = (int32_t)(ONE_Q30 / isqrt(sum));     // |component| * recip <= 2^30
+    v[0] = x * recip;
+    v[1] = y * recip;
+    v[2] = z * recip;
+    return true;
+}
+
+static void setPeriod(fusionFilterQ* f, uint32_t period) {
+    // 64-bit divides, only when the sample period changes
+    f->period = period;
+    f->halfDt = (int32_t)(((uint64_t)period << 31) / 2000000);
+    f->kiDt = (int32_t)(((int64_t)f->ki * period << 15) / 1000000);
+}
+
+void Fusion::init(fusionFilterQ* f, float kp, float ki) {
+    f->q[0] = ONE_Q30;
+    f->q[1] = 0;
+    f->q[2] = 0;
+    f->q[3] = 0;
+    f->integral[0] = 0;
+    f->integral[1] = 0;
+    f->integral[2] = 0;
+    f->kp = (int32_t)(kp * 65536.0f + 0.5f);
+    f->ki = (int32_t)(ki * 65536.0f + 0.5f);
+    setPeriod(f, 1000);
+}
+
+void Fusion::update(fusionFilterQ* f, const imuBlock* block) {
+    if (block->period != f->period)
+        setPeriod(f, block->period);
+
+    int32_t q0 = f->q[0], q1 = f->q[1], q2 = f->q[2], q3 = f->q[3];
+    int32_t ix = f->integral[0], iy = f->integral[1], iz = f->integral[2];
+    const int32_t kp = f->kp;
+    const int32_t kiDt = f->kiDt;
+    const int32_t halfDt = f->halfDt;
+
+    for (uint16_t i = 0; i < block->count; i++)
+    {
+        int32_t gx = block->gx[i] * GYRO_SCALE_Q24;
+        int32_t gy = block->gy[i] * GYRO_SCALE_Q24;
+        int32_t gz = block->gz[i] * GYRO_SCALE_Q24;
+        int32_t a[3];
+
+        if (normalize(block->ax[i], block->ay[i], block->az[i], a))
+        {
+            // rotation matrix elements are within +/-1 and unit-vector dot products
+            // within +/-sqrt(2) at every partial sum, so nothing leaves Q30
+            int32_t q0q1 = mul30(q0, q1), q0q2 = mul30(q0, q2), q0q3 = mul30(q0, q3);
+            int32_t q1q1 = mul30(q1, q1), q1q2 = mul30(q1, q2), q1q3 = mul30(q1, q3);
+            int32_t q2q2 = mul30(q2, q2), q2q3 = mul30(q2, q3), q3q3 = mul30(q3, q3);
+            int32_t r20 = 2 * (q1q3 - q0q2);
+            int32_t r21 = 2 * (q2q3 + q0q1);
+            int32_t r22 = ONE_Q30 - (q1q1 + q2q2) - (q1q1 + q2q2);
+            int32_t ex = mul30(a[1], r22) - mul30(a[2], r21);
+            int32_t ey = mul30(a[2], r20) - mul30(a[0], r22);
+            int32_t ez = mul30(a[0], r21) - mul30(a[1], r20);
+
+            int32_t m[3];
+            if (normalize(block->mx[i], block->my[i], block->mz[i], m))
+            {
+                int32_t r00 = ONE_Q30 - (q2q2 + q3q3) - (q2q2 + q3q3);
+                int32_t r01 = 2 * (q1q2 - q0q3);
+                int32_t r02 = 2 * (q1q3 + q0q2);
+                int32_t r10 = 2 * (q1q2 + q0q3);
+                int32_t r11 = ONE_Q30 - (q1q1 + q3q3) - (q1q1 + q3q3);
+                int32_t r12 = 2 * (q2q3 - q0q1);
+
+                int32_t hx = mul30(r00, m[0]) + mul30(r01, m[1]) + mul30(r02, m[2]);
+                int32_t hy = mul30(r10, m[0]) + mul30(r11, m[1]) + mul30(r12, m[2]);
+                uint32_t horizontal = mul30(hx, hx) + mul30(hy, hy);
+                int32_t bx = horizontal ? isqrt(horizontal) << 15 : 0;
+                int32_t bz = mul30(r20, m[0]) + mul30(r21, m[1]) + mul30(r22, m[2]);
+                int32_t wx = mul30(r00, bx) + mul30(r20, bz);
+                int32_t wy = mul30(r01, bx) + mul30(r21, bz);
+                int32_t wz = mul30(r02, bx) + mul30(r22, bz);
+                ex += mul30(m[1], wz) - mul30(m[2], wy);
+                ey += mul30(m[2], wx) - mul30(m[0], wz);
+                ez += mul30(m[0], wy) - mul30(m[1], wx);
+            }
+
+            // errors are Q30, rates Q24
+            ix += (int32_t)(((int64_t)kiDt * ex) >> 37);
+            iy += (int32_t)(((int64_t)kiDt * ey) >> 37);
+            iz += (int32_t)(((int64_t)kiDt * ez) >> 37);
+            gx += (int32_t)(((int64_t)kp * ex) >> 22);
+            gy += (int32_t)(((int64_t)kp * ey) >> 22);
+            gz += (int32_t)(((int64_t)kp * ez) >> 22);
+        }
+
+        // rotation this sample in Q30 radians
+        gx = (int32_t)(((int64_t)(gx + ix) * halfDt) >> 25);
+        gy = (int32_t)(((int64_t)(gy + iy) * halfDt) >> 25);
+        gz = (int32_t)(((int64_t)(gz + iz) * halfDt) >> 25);
+
+        // q += q * (0, g) / 2, each row one SMLAL chain
+        int64_t d0 = -(int64_t)q1 * gx - (int64_t)q2 * gy - (int64_t)q3 * gz;
+        int64_t d1 = (int64_t)q0 * gx + (int64_t)q2 * gz - (int64_t)q3 * gy;
+        int64_t d2 = (int64_t)q0 * gy - (int64_t)q1 * gz + (int64_t)q3 * gx;
+        int64_t d3 = (int64_t)q0 * gz + (int64_t)q1 * gy - (int64_t)q2 * gx;
+        q0 += (int32_t)(d0 >> 30);
+        q1 += (int32_t)(d1 >> 30);
+        q2 += (int32_t)(d2 >> 30);
+        q3 += (int32_t)(d3 >> 30);
+
+        // |q| stays within a hair of 1, so one Newton step of 1/sqrt suffices
+        int64_t n = (int64_t)q0 * q0 + (int64_t)q1 * q1 + (int64_t)q2 * q2 + (int64_t)q3 * q3;
+        int32_t r = (3 << 29) - (int32_t)(n >> 31);
+        q0 = mul30(q0, r);
+        q1 = mul30(q1, r);
+        q2 = mul30(q2, r);
+        q3 = mul30(q3, r);
+    }
+
+    f->q[0] = q0;
+    f->q[1] = q1;
+    f->q[2] = q2;
+    f->q[3] = q3;
+    f->integral[0] = ix;
+    f->integral[1] = iy;
+    f->integral[2] = iz;
+}
+
+void Fusion::quaternion(const fusionFilterQ* f, float q[4]) {
+    for (uint8_t i = 0; i < 4; i++)
+        q[i] = f->q[i] * (1.0f / ONE_Q30);
+}
@@ -0,0 +1,85 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+
+#ifndef FUSION_H
+#define FUSION_H
+
+#include <stdint.h>
+#include "imu.h"
+
+//-----------------------------------------------------------------------------
+// Sensor Fusion
+//-----------------------------------------------------------------------------
+
+/// Mahony complementary filter run over whole imuBlocks, as a faster
+/// alternative to sensorlib's CompDCM for high sample rates and several IMUs.
+/// The attitude is a quaternion; accelerometer (and magnetometer, when the
+/// block has one) errors feed back into the gyro rate through a proportional
+/// and an integral gain. One state per IMU, no shared data.
+///
+/// Two paths share the algorithm:
+///   fusionFilter   single precision, no doubles or library calls, so the
+///                  M4 FPU runs it straight through (VSQRT for the norms)
+///   fusionFilterQ  Q30 quaternion and vectors, Q24 rates in rad/s; products
+///                  are SMULL/SMLAL, sensor norms use SMUAD on packed pairs
+///                  and an integer square root. No FPU use after init.
+///
+/// Both take raw counts at the full scales set by Imu::init. Quaternions
+/// are (w, x, y, z) and rotate sensor axes into the earth frame.
+
+#define FUSION_KP       2.0f    // proportional gain suited to 1 kHz
+#define FUSION_KI       0.05f   // integral gain, tracks gyro bias
+
+struct fusionFilter
+{
+  float q[4];                   // attitude, unit quaternion
+  float integral[3];            // gyro bias estimate, rad/s
+  float kp;
+  float ki;
+};
+
+struct fusionFilterQ
+{
+  int32_t q[4];                 // Q30
+  int32_t integral[3];          // Q24 rad/s
+  int32_t kp;                   // Q16
+  int32_t ki;                   // Q16
+  int32_t kiDt;                 // Q31, ki times the sample period
+  int32_t halfDt;               // Q31, half the sample period in seconds
+  uint32_t period;              // microseconds kiDt and halfDt were set for
+};
+
+/// Class for sensor fusion
+class Fusion
+{
+public:
+    // single precision
+    static void init(fusionFilter* f, float kp, float ki);
+    static void update(fusionFilter* f, const imuBlock* block);
+
+    // fixed point
+    static void init(fusionFilterQ* f, float kp, float ki);
+    static void update(fusionFilterQ* f, const imuBlock* block);
+    static void quaternion(const fusionFilterQ* f, float q[4]);
+};
+
+#endif // FUSION_H
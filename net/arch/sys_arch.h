@@ -0,0 +1,74 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef ARCH_SYS_ARCH_H
+#define ARCH_SYS_ARCH_H
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// lwIP Operating System Emulation Layer
+//-----------------------------------------------------------------------------
+
+/// lwIP semaphores and mailboxes built on task notifications (net/sys_arch.cpp).
+/// Waiters queue by task index and are woken with RTOS::notify(), so posting
+/// is safe from an ISR. lwIP threads are kernel tasks; the stack size argument
+/// is ignored because every task has the kernel's fixed stack.
+
+#define SYS_MBOX_SIZE       16    // messages per mailbox, lwipopts sizes must fit
+#define SYS_MAX_WAITERS     4     // tasks blocked on one semaphore or mailbox side
+#define SYS_MAX_THREADS     4     // lwIP threads, including tcpip
+
+#define SYS_MBOX_NULL       0
+#define SYS_SEM_NULL        0
+
+struct sysWaiters
+{
+  uint8_t count;
+  uint8_t task[SYS_MAX_WAITERS];  // blocked tasks, oldest first
+};
+
+typedef struct
+{
+  volatile uint32_t count;
+  struct sysWaiters waiters;
+  uint8_t valid;
+} sys_sem_t;
+
+typedef struct
+{
+  void *volatile msg[SYS_MBOX_SIZE];
+  volatile uint16_t head;         // oldest message
+  volatile uint16_t count;        // messages queued
+  uint16_t size;                  // capacity requested at sys_mbox_new()
+  struct sysWaiters readers;      // tasks waiting for a message
+  struct sysWaiters writers;      // tasks waiting for space
+  uint8_t valid;
+} sys_mbox_t;
+
+typedef uint8_t sys_thread_t;     // kernel task index
+
+#define sys_sem_valid(s)            ((s)->valid)
+#define sys_sem_set_invalid(s)      ((s)->valid = 0)
+#define sys_mbox_valid(m)           ((m)->valid)
+#define sys_mbox_set_invalid(m)     ((m)->valid = 0)
+
+#endif // ARCH_SYS_ARCH_H
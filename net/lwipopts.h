@@ -0,0 +1,80 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef LWIPOPTS_H
+#define LWIPOPTS_H
+
+//-----------------------------------------------------------------------------
+// lwIP Configuration
+//-----------------------------------------------------------------------------
+
+// threaded stack on the RTOS kernel (net/sys_arch.cpp)
+#define NO_SYS                          0
+#define SYS_LIGHTWEIGHT_PROT            1    // interrupt masking, ISR-safe
+#define LWIP_COMPAT_MUTEX               1    // lwIP mutexes are binary sys_sem
+#define LWIP_PROVIDE_ERRNO              1
+
+// memory: 32K of SRAM is shared with the kernel, so keep the pools small
+#define MEM_ALIGNMENT                   4
+#define MEM_SIZE                        (4 * 1024)
+#define MEMP_NUM_PBUF                   8
+#define MEMP_NUM_UDP_PCB                4
+#define MEMP_NUM_TCP_PCB                4
+#define MEMP_NUM_TCP_PCB_LISTEN         2
+#define MEMP_NUM_TCP_SEG                12
+#define MEMP_NUM_NETBUF                 4
+#define MEMP_NUM_NETCONN                6
+#define PBUF_POOL_SIZE                  6
+#define PBUF_POOL_BUFSIZE               256
+
+// point-to-point links only, no Ethernet
+#define LWIP_ARP                        0
+#define LWIP_DHCP                       0
+#define LWIP_HAVE_LOOPIF                1
+#define LWIP_NETIF_LOOPBACK             1
+#define LWIP_NETIF_API                  1
+
+// TCP; out-of-sequence segments would pin zero-copy receive buffers
+#define TCP_MSS                         536
+#define TCP_WND                         (2 * TCP_MSS)
+#define TCP_SND_BUF                     (2 * TCP_MSS)
+#define TCP_QUEUE_OOSEQ                 0
+
+// tcpip thread and mailboxes, sizes at most SYS_MBOX_SIZE
+#define TCPIP_THREAD_NAME               "tcpip"
+#define TCPIP_THREAD_PRIO               2
+#define TCPIP_THREAD_STACKSIZE          1024
+#define TCPIP_MBOX_SIZE                 8
+#define DEFAULT_RAW_RECVMBOX_SIZE       4
+#define DEFAULT_UDP_RECVMBOX_SIZE       4
+#define DEFAULT_TCP_RECVMBOX_SIZE       4
+#define DEFAULT_ACCEPTMBOX_SIZE         4
+#define DEFAULT_THREAD_STACKSIZE        1024
+#define DEFAULT_THREAD_PRIO             4
+
+// sequential APIs
+#define LWIP_NETCONN                    1
+#define LWIP_SOCKET                     1
+#define LWIP_SO_RCVTIMEO                1
+
+#define LWIP_STATS                      0
+
+#endif // LWIPOPTS_H
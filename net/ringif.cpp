@@ -0,0 +1,122 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include <stddef.h>
+#include "ringif.h"
+#include "lwip/tcpip.h"
+#include "lwip/netifapi.h"
+#include "lwip/mem.h"
+
+// lwIP may hunt for link headroom in front of a received frame; it must find
+// none rather than overwrite the free function between the pbuf and data
+static_assert(offsetof(ringIfBuffer, data) - LWIP_MEM_ALIGN_SIZE(sizeof(pbuf)) < PBUF_LINK_HLEN,
+              "ringIfBuffer leaves headroom before data");
+
+//-----------------------------------------------------------------------------
+// lwIP Callbacks
+//-----------------------------------------------------------------------------
+
+// lwIP has released a received frame: put its buffer back in the ring
+static void freeBuffer(pbuf* p) {
+    ringIfBuffer* buffer = (ringIfBuffer*)p;
+    MemPool::free(&buffer->owner->pool, buffer);
+}
+
+static err_t output(netif* nif, pbuf* p, ip_addr_t* ipaddr) {
+    (void)ipaddr;
+    ringIf* rif = (ringIf*)nif;
+    return rif->transmit(rif, p);
+}
+
+static err_t netifInit(netif* nif) {
+    nif->name[0] = 'r';
+    nif->name[1] = 'i';
+    nif->mtu = RINGIF_MTU;
+    nif->flags = NETIF_FLAG_LINK_UP;
+    nif->output = output;
+    return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Zero-Copy Network Interface
+//-----------------------------------------------------------------------------
+
+bool RingIf::init(ringIf* rif, ringIfTransmit transmit, void* driver,
+                  ip_addr_t* ip, ip_addr_t* netmask, ip_addr_t* gateway) {
+    // tcpip_init() must have been called; the interface is added on its thread
+    rif->transmit = transmit;
+    rif->driver = driver;
+    rif->rxFrames = 0;
+    rif->rxDropped = 0;
+    // the pool links free buffers through their first word, the pbuf's next
+    // pointer, which lwIP sets when a buffer is wrapped
+    if (!MemPool::init(&rif->pool, rif->buffers, sizeof(ringIfBuffer), RINGIF_BUFFERS))
+        return false;
+    for (uint8_t i = 0; i < RINGIF_BUFFERS; i++)
+    {
+        rif->buffers[i].owner = rif;
+    }
+
+    if (netifapi_netif_add(&rif->netif, ip, netmask, gateway, rif, netifInit, tcpip_input) != ERR_OK)
+        return false;
+    return netifapi_netif_set_up(&rif->netif) == ERR_OK;
+}
+
+uint8_t* RingIf::rxBuffer(ringIf* rif) {
+    // an empty frame buffer for the driver to fill, or 0 if all are lent out
+    ringIfBuffer* buffer = (ringIfBuffer*)MemPool::alloc(&rif->pool);
+    if (buffer == 0)
+    {
+        rif->rxDropped++;
+        return 0;
+    }
+    return (uint8_t*)buffer->data;
+}
+
+void RingIf::rxDone(ringIf* rif, uint8_t* frame, uint16_t length) {
+    // wrap the filled buffer in place and queue it for the tcpip thread. lwIP
+    // 1.4.1 can only move a PBUF_REF payload forward, and icmp_input() must
+    // move it back over the IP header to answer a ping, so the frame is typed
+    // as pool memory directly after its pbuf: headers it has parsed can be
+    // restored and the custom flag still routes the free to freeBuffer
+    ringIfBuffer* buffer = (ringIfBuffer*)(frame - offsetof(ringIfBuffer, data));
+    buffer->custom.custom_free_function = freeBuffer;
+    pbuf* p = pbuf_alloced_custom(PBUF_RAW, length, PBUF_POOL, &buffer->custom,
+                                  buffer->data, sizeof(buffer->data));
+    if (p == 0)
+    {
+        MemPool::free(&rif->pool, buffer);
+        rif->rxDropped++;
+        return;
+    }
+    if (rif->netif.input(p, &rif->netif) != ERR_OK)
+    {
+        pbuf_free(p);
+        rif->rxDropped++;
+        return;
+    }
+    rif->rxFrames++;
+}
+
+void RingIf::rxAbort(ringIf* rif, uint8_t* frame) {
+    // return a buffer from rxBuffer() unused, e.g. after a framing error
+    MemPool::free(&rif->pool, frame - offsetof(ringIfBuffer, data));
+}
@@ -0,0 +1,84 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef RINGIF_H
+#define RINGIF_H
+
+#include <stdint.h>
+#include "mempool.h"
+#include "lwip/netif.h"
+#include "lwip/pbuf.h"
+
+//-----------------------------------------------------------------------------
+// Zero-Copy Network Interface
+//-----------------------------------------------------------------------------
+
+/// An lwIP netif for point-to-point links whose driver receives straight into
+/// buffers lent from a ring. A filled buffer is handed to lwIP as a custom
+/// pbuf without copying, and returns to the ring when lwIP frees it,
+/// in whatever order that happens. While lwIP or a socket holds a frame its
+/// buffer is out of the ring; an empty ring makes the driver drop frames.
+///
+/// Transmit is also zero-copy: output() passes the pbuf chain to the driver,
+/// which must pbuf_ref() it if it keeps it past the call and pbuf_free() it
+/// from task context when sent.
+
+#define RINGIF_MTU          576     // bytes per IP packet
+#define RINGIF_TRAILER      4       // room past the MTU for a link check, e.g. an FCS
+#define RINGIF_BUFFERS      4       // receive buffers per interface
+
+struct ringIf;
+
+/// driver transmit hook, called on the tcpip thread
+typedef err_t (*ringIfTransmit)(struct ringIf* rif, struct pbuf* p);
+
+struct ringIfBuffer
+{
+  struct pbuf_custom custom;      // lwIP frees the frame through this
+  uint32_t data[(RINGIF_MTU + RINGIF_TRAILER) / 4];  // received frame, word aligned; must follow custom
+  struct ringIf *owner;
+};
+
+struct ringIf
+{
+  struct netif netif;             // must be first: netif callbacks cast back
+  ringIfTransmit transmit;
+  void *driver;                   // driver context
+  memPool pool;                   // free receive buffers
+  ringIfBuffer buffers[RINGIF_BUFFERS];
+  volatile uint32_t rxFrames;
+  volatile uint32_t rxDropped;    // frames lost for lack of a buffer or mailbox
+};
+
+/// Class for zero-copy network interface
+class RingIf
+{
+public:
+    static bool init(ringIf* rif, ringIfTransmit transmit, void* driver,
+                     ip_addr_t* ip, ip_addr_t* netmask, ip_addr_t* gateway);
+
+    // driver receive side, task or ISR
+    static uint8_t* rxBuffer(ringIf* rif);
+    static void rxDone(ringIf* rif, uint8_t* frame, uint16_t length);
+    static void rxAbort(ringIf* rif, uint8_t* frame);
+};
+
+#endif // RINGIF_H
@@ -0,0 +1,264 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include "serialif.h"
+#include "rtos.h"
+#include "sync.h"
+#include "uart.h"
+#include "crc.h"
+#include "lwip/sys.h"
+
+// framing bytes: an escaped end or escape byte is sent as escape, escEnd/escEsc
+struct framingBytes
+{
+  uint8_t end;
+  uint8_t esc;
+  uint8_t escEnd;
+  uint8_t escEsc;
+};
+
+static const framingBytes framings[2] =
+{
+    { 0xC0, 0xDB, 0xDC, 0xDD },     // SLIP
+    { 0x7E, 0x7D, 0x5E, 0x5D },     // HDLC
+};
+
+// Define variables
+static ringIf rif;
+static uint8_t framing;
+static const framingBytes* bytes;
+static uint32_t rxErrorCount;
+
+static uint8_t txBuf[2][SERIALIF_BURST];
+static uint16_t txLength[2];
+static uint8_t txFill;            // buffer the tcpip thread encodes into
+static uint8_t txSend;            // buffer on the UART while txBusy
+static bool txBusy;
+static mutex txLock;              // guards the four fields above
+static sys_sem_t txReady;         // signalled when a burst is handed over
+static sys_sem_t txFree;          // signalled after each burst
+
+//-----------------------------------------------------------------------------
+// Transmit
+//-----------------------------------------------------------------------------
+
+// txLock held: hand the fill buffer to the transmit thread if it is idle
+static void startBurst() {
+    if (!txBusy && txLength[txFill] > 0)
+    {
+        txSend = txFill;
+        txFill ^= 1;
+        txBusy = true;
+        sys_sem_signal(&txReady);
+    }
+}
+
+// blocks on each burst for as long as the UART takes, so it has its own
+// thread rather than holding up a shared work queue worker
+static void txThread(void* arg) {
+    (void)arg;
+    while (true)
+    {
+        sys_arch_sem_wait(&txReady, 0);
+        Uart::write(txBuf[txSend], txLength[txSend], WAIT_FOREVER);
+
+        Mutex::lock(&txLock);
+        txLength[txSend] = 0;
+        txBusy = false;
+        startBurst();   // send whatever queued up meanwhile
+        Mutex::unlock(&txLock);
+        sys_sem_signal(&txFree);
+    }
+}
+
+// txLock held: append one byte, waiting for a burst to finish if both are full
+static void put(uint8_t b) {
+    while (txLength[txFill] == SERIALIF_BURST)
+    {
+        startBurst();
+        if (txLength[txFill] == SERIALIF_BURST)
+        {
+            Mutex::unlock(&txLock);
+            sys_arch_sem_wait(&txFree, 0);
+            Mutex::lock(&txLock);
+        }
+    }
+    txBuf[txFill][txLength[txFill]++] = b;
+}
+
+static void putEscaped(uint8_t b) {
+    if (b == bytes->end)
+    {
+        put(bytes->esc);
+        put(bytes->escEnd);
+    }
+    else if (b == bytes->esc)
+    {
+        put(bytes->esc);
+        put(bytes->escEsc);
+    }
+    else
+    {
+        put(b);
+    }
+}
+
+static err_t transmit(ringIf* r, pbuf* p) {
+    // encodes from the pbuf payloads in place, so lwIP keeps ownership of p
+    (void)r;
+    uint16_t fcs = 0;
+
+    Mutex::lock(&txLock);
+    put(bytes->end);    // flushes line noise at the receiver
+    for (pbuf* q = p; q != 0; q = q->next)
+    {
+        const uint8_t* data = (const uint8_t*)q->payload;
+        if (framing == SERIALIF_HDLC)
+            fcs = Crc::crc16(fcs, data, q->len);
+        for (uint16_t i = 0; i < q->len; i++)
+        {
+            putEscaped(data[i]);
+        }
+    }
+    if (framing == SERIALIF_HDLC)
+    {
+        // FCS-16, least significant byte first
+        putEscaped(fcs & 0xFF);
+        putEscaped(fcs >> 8);
+    }
+    put(bytes->end);
+    startBurst();
+    Mutex::unlock(&txLock);
+    return ERR_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Receive
+//-----------------------------------------------------------------------------
+
+static void rxThread(void* arg) {
+    (void)arg;
+    uint8_t chunk[SERIALIF_RX_CHUNK];
+    uint8_t* frame = 0;
+    uint16_t length = 0;
+    bool escaped = false;
+    bool discard = false;   // frame overflowed or had no buffer
+    // an HDLC frame carries its FCS past the MTU, in the buffer's trailer
+    uint16_t frameLimit = (framing == SERIALIF_HDLC) ? RINGIF_MTU + 2 : RINGIF_MTU;
+
+    while (true)
+    {
+        uint32_t n = Uart::read(chunk, sizeof(chunk), WAIT_FOREVER);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint8_t b = chunk[i];
+            if (b == bytes->end)
+            {
+                // empty frames between back-to-back ends are not errors
+                if (frame != 0 && length > 0 && !discard)
+                {
+                    if (framing == SERIALIF_HDLC)
+                    {
+                        if (length > 2 && Crc::crc16(0, frame, length - 2) ==
+                                          (frame[length - 2] | frame[length - 1] << 8))
+                        {
+                            RingIf::rxDone(&rif, frame, length - 2);
+                            frame = 0;
+                        }
+                        else
+                        {
+                            rxErrorCount++;
+                        }
+                    }
+                    else
+                    {
+                        RingIf::rxDone(&rif, frame, length);
+                        frame = 0;
+                    }
+                }
+                length = 0;
+                escaped = false;
+                discard = false;
+                continue;
+            }
+            if (b == bytes->esc)
+            {
+                escaped = true;
+                continue;
+            }
+            if (escaped)
+            {
+                escaped = false;
+                if (b == bytes->escEnd)
+                    b = bytes->end;
+                else if (b == bytes->escEsc)
+                    b = bytes->esc;
+                else if (framing == SERIALIF_HDLC)
+                    b ^= 0x20;
+            }
+            if (discard)
+                continue;
+
+            // borrow a buffer at the first byte of a frame
+            if (frame == 0)
+                frame = RingIf::rxBuffer(&rif);
+            if (frame == 0 || length == frameLimit)
+            {
+                if (frame != 0)
+                    rxErrorCount++;
+                discard = true;
+                continue;
+            }
+            frame[length++] = b;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Serial Network Interface
+//-----------------------------------------------------------------------------
+
+bool SerialIf::init(uint8_t mode, ip_addr_t* ip, ip_addr_t* netmask, ip_addr_t* gateway) {
+    framing = (mode == SERIALIF_HDLC) ? SERIALIF_HDLC : SERIALIF_SLIP;
+    bytes = &framings[framing];
+    rxErrorCount = 0;
+    txLength[0] = 0;
+    txLength[1] = 0;
+    txFill = 0;
+    txBusy = false;
+    Mutex::init(&txLock);
+    if (sys_sem_new(&txReady, 0) != ERR_OK || sys_sem_new(&txFree, 0) != ERR_OK)
+        return false;
+
+    if (!RingIf::init(&rif, transmit, 0, ip, netmask, gateway))
+        return false;
+    if (sys_thread_new("serialtx", txThread, 0, DEFAULT_THREAD_STACKSIZE, 3) == NO_TASK)
+        return false;
+    return sys_thread_new("serialif", rxThread, 0, DEFAULT_THREAD_STACKSIZE, 3) != NO_TASK;
+}
+
+ringIf* SerialIf::netif() {
+    return &rif;
+}
+
+uint32_t SerialIf::rxErrors() {
+    return rxErrorCount;
+}
@@ -0,0 +1,60 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#ifndef SERIALIF_H
+#define SERIALIF_H
+
+#include <stdint.h>
+#include "ringif.h"
+
+//-----------------------------------------------------------------------------
+// Serial Network Interface
+//-----------------------------------------------------------------------------
+
+/// IP over UART0 for lwIP, on a RingIf. SERIALIF_SLIP is plain RFC 1055 SLIP,
+/// so a Linux host can attach with slattach; SERIALIF_HDLC uses RFC 1662 flags
+/// and escapes with an FCS-16 on every frame for noisy links.
+///
+/// Receive decodes straight from the UART's DMA ring into RingIf buffers.
+/// Transmit escapes each pbuf chain directly into one of two burst buffers;
+/// packets queue up in the idle buffer while the other is on the DMA, so a
+/// busy link sends several packets per UART transfer. Bursts are written by
+/// a transmit thread of the interface's own, next to the receive thread.
+///
+/// The interface owns UART0: do not run the console or the LOG() drain with
+/// it. Call init() from a task, after tcpip_init().
+
+#define SERIALIF_SLIP       0
+#define SERIALIF_HDLC       1
+
+#define SERIALIF_BURST      512     // bytes per transmit burst buffer
+#define SERIALIF_RX_CHUNK   64      // bytes taken from the UART ring per read
+
+/// Class for serial network interface
+class SerialIf
+{
+public:
+    static bool init(uint8_t framing, ip_addr_t* ip, ip_addr_t* netmask, ip_addr_t* gateway);
+    static ringIf* netif();
+    static uint32_t rxErrors();
+};
+
+#endif // SERIALIF_H
@@ -0,0 +1,286 @@
+/*-----------------------------------------------------------------------------
+ * This file is part of the RTOS-Framework Project.
+ * 
+ * RTOS-Framework is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * RTOS-Framework is distributed in the hope that it will be useful, 
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License 
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * 
+ * Copyright (c) 2025 Sandeep K. Pal
+ *-----------------------------------------------------------------------------
+ */
+
+
+#include <stdint.h>
+#include "rtos.h"
+#include "introspect.h"
+#include "lwip/sys.h"
+#include "lwip/err.h"
+
+// Define variables
+struct sysThread
+{
+  lwip_thread_fn fn;
+  void *arg;
+};
+
+static sysThread threads[SYS_MAX_THREADS];
+static uint8_t threadCount;
+
+//-----------------------------------------------------------------------------
+// Wait Lists
+//-----------------------------------------------------------------------------
+
+// all wait list helpers run with interrupts masked by the caller
+
+static void dequeue(sysWaiters* w, uint8_t task) {
+    for (uint8_t i = 0; i < w->count; i++)
+    {
+        if (w->task[i] == task)
+        {
+            w->count--;
+            for (; i < w->count; i++)
+            {
+                w->task[i] = w->task[i + 1];
+            }
+            return;
+        }
+    }
+}
+
+static void wakeOne(sysWaiters* w) {
+    if (w->count > 0)
+    {
+        uint8_t task = w->task[0];
+        dequeue(w, task);
+        RTOS::notify(task);
+    }
+}
+
+// queue the current task and sleep until woken or the lwIP timeout (ms, 0 =
+// forever) measured from start runs out; returns false once it has run out.
+// The caller re-checks its condition, so spurious wakeups are harmless.
+static bool block(sysWaiters* w, uint32_t start, uint32_t timeout, uint32_t* primask) {
+    uint32_t wait = WAIT_FOREVER;
+    if (timeout != 0)
+    {
+        uint32_t elapsed = tickCount - start;
+        if (elapsed >= timeout)
+            return false;
+        wait = timeout - elapsed;
+    }
+    if (w->count < SYS_MAX_WAITERS)
+        w->task[w->count++] = taskCurrent;
+    else
+        wait = 1;   // list full: poll once a tick instead
+
+    restoreInterrupts(*primask);
+    RTOS::waitNotify(wait);
+    *primask = disableInterrupts();
+    dequeue(w, taskCurrent);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Semaphores
+//-----------------------------------------------------------------------------
+
+err_t sys_sem_new(sys_sem_t* sem, u8_t count) {
+    sem->count = count;
+    sem->waiters.count = 0;
+    sem->valid = 1;
+    return ERR_OK;
+}
+
+void sys_sem_free(sys_sem_t* sem) {
+    sem->valid = 0;
+}
+
+void sys_sem_signal(sys_sem_t* sem) {
+    uint32_t primask = disableInterrupts();
+    sem->count++;
+    wakeOne(&sem->waiters);
+    restoreInterrupts(primask);
+}
+
+u32_t sys_arch_sem_wait(sys_sem_t* sem, u32_t timeout) {
+    uint32_t start = tickCount;
+    uint32_t primask = disableInterrupts();
+    while (sem->count == 0)
+    {
+        if (!block(&sem->waiters, start, timeout, &primask))
+        {
+            restoreInterrupts(primask);
+            return SYS_ARCH_TIMEOUT;
+        }
+    }
+    sem->count--;
+    restoreInterrupts(primask);
+    return tickCount - start;
+}
+
+//-----------------------------------------------------------------------------
+// Mailboxes
+//-----------------------------------------------------------------------------
+
+err_t sys_mbox_new(sys_mbox_t* mbox, int size) {
+    if (size <= 0 || size > SYS_MBOX_SIZE)
+        return ERR_MEM;
+    mbox->head = 0;
+    mbox->count = 0;
+    mbox->size = size;
+    mbox->readers.count = 0;
+    mbox->writers.count = 0;
+    mbox->valid = 1;
+    return ERR_OK;
+}
+
+void sys_mbox_free(sys_mbox_t* mbox) {
+    mbox->valid = 0;
+}
+
+// interrupts masked by the caller, mailbox not full
+static void put(sys_mbox_t* mbox, void* msg) {
+    mbox->msg[(mbox->head + mbox->count) % SYS_MBOX_SIZE] = msg;
+    mbox->count++;
+    wakeOne(&mbox->readers);
+}
+
+// interrupts masked by the caller, mailbox not empty
+static void* take(sys_mbox_t* mbox) {
+    void* msg = mbox->msg[mbox->head];
+    mbox->head = (mbox->head + 1) % SYS_MBOX_SIZE;
+    mbox->count--;
+    wakeOne(&mbox->writers);
+    return msg;
+}
+
+void sys_mbox_post(sys_mbox_t* mbox, void* msg) {
+    uint32_t primask = disableInterrupts();
+    while (mbox->count >= mbox->size)
+    {
+        block(&mbox->writers, 0, 0, &primask);
+    }
+    put(mbox, msg);
+    restoreInterrupts(primask);
+}
+
+err_t sys_mbox_trypost(sys_mbox_t* mbox, void* msg) {
+    // safe from an ISR: a driver can hand received frames to tcpip_input()
+    err_t err = ERR_MEM;
+    uint32_t primask = disableInterrupts();
+    if (mbox->count < mbox->size)
+    {
+        put(mbox, msg);
+        err = ERR_OK;
+    }
+    restoreInterrupts(primask);
+    return err;
+}
+
+u32_t sys_arch_mbox_fetch(sys_mbox_t* mbox, void** msg, u32_t timeout) {
+    uint32_t start = tickCount;
+    uint32_t primask = disableInterrupts();
+    while (mbox->count == 0)
+    {
+        if (!block(&mbox->readers, start, timeout, &primask))
+        {
+            restoreInterrupts(primask);
+            if (msg != 0)
+                *msg = 0;
+            return SYS_ARCH_TIMEOUT;
+        }
+    }
+    void* m = take(mbox);
+    restoreInterrupts(primask);
+    if (msg != 0)
+        *msg = m;
+    return tickCount - start;
+}
+
+u32_t sys_arch_mbox_tryfetch(sys_mbox_t* mbox, void** msg) {
+    uint32_t primask = disableInterrupts();
+    if (mbox->count == 0)
+    {
+        restoreInterrupts(primask);
+        return SYS_MBOX_EMPTY;
+    }
+    void* m = take(mbox);
+    restoreInterrupts(primask);
+    if (msg != 0)
+        *msg = m;
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Threads
+//-----------------------------------------------------------------------------
+
+// createProcess() identifies tasks by entry function, so each lwIP thread
+// gets its own trampoline
+template <int N>
+static void threadEntry() {
+    threads[N].fn(threads[N].arg);
+    while (true)
+    {
+        RTOS::waitNotify(WAIT_FOREVER);
+    }
+}
+
+static const _fn threadEntries[SYS_MAX_THREADS] = { threadEntry<0>, threadEntry<1>, threadEntry<2>, threadEntry<3> };
+
+sys_thread_t sys_thread_new(const char* name, lwip_thread_fn thread, void* arg, int stacksize, int prio) {
+    (void)stacksize;
+    if (threadCount >= SYS_MAX_THREADS)
+        return NO_TASK;
+
+    uint8_t n = threadCount++;
+    threads[n].fn = thread;
+    threads[n].arg = arg;
+    if (prio < 0)
+        prio = 0;
+    if (prio > 7)
+        prio = 7;
+    if (!RTOS::createProcess(threadEntries[n], prio))
+        return NO_TASK;
+    Introspect::registerObject(name, OBJECT_TASK, (void*)threadEntries[n]);
+
+    for (uint8_t i = 0; i < MAX_TASKS; i++)
+    {
+        if (tcb[i].state != STATE_INVALID && tcb[i].pid == (void*)threadEntries[n])
+            return i;
+    }
+    return NO_TASK;
+}
+
+//-----------------------------------------------------------------------------
+// Time and Protection
+//-----------------------------------------------------------------------------
+
+void sys_init() {
+}
+
+// one kernel tick is one millisecond
+u32_t sys_now() {
+    return tickCount;
+}
+
+u32_t sys_jiffies() {
+    return tickCount;
+}
+
+sys_prot_t sys_arch_protect() {
+    return disableInterrupts();
+}
+
+void sys_arch_unprotect(sys_prot_t pval) {
+    restoreInterrupts(pval);
+}
@@ -1,9 +1,218 @@
+.syntax unified
+.thumb
+
 .section .text
 .global _start
-_stack_top = 0x20001000;
+.type _start, %function
 
 _start:
     ldr r0, =_stack_top
     mov sp, r0
+
+    @ copy .data from its load address in flash
+    ldr r0, =_sidata
+    ldr r1, =_sdata
+    ldr r2, =_edata
+copy_data:
+    cmp r1, r2
+    bhs zero_bss
+    ldr r3, [r0], #4
+    str r3, [r1], #4
+    b copy_data
+
+    @ clear .bss
+zero_bss:
+    ldr r1, =_sbss
+    ldr r2, =_ebss
+    movs r3, #0
+zero_loop:
+    cmp r1, r2
+    bhs run_init
+    str r3, [r1], #4
+    b zero_loop
+
+    @ static constructors (.preinit_array and .init_array)
+run_init:
+    bl __libc_init_array
     bl main
     b .
+
+@ -nostartfiles drops crti.o, which __libc_init_array expects to supply _init
+.weak _init
+.type _init, %function
+_init:
+    bx lr
+
+@ Unused exceptions and interrupts spin here
+.type Default_Handler, %function
+Default_Handler:
+    b .
+
+@ Handlers are weak so drivers override them by defining the symbol
+.macro handler name
+    .weak \name
+    .thumb_set \name, Default_Handler
+.endm
+
+handler NMI_Handler
+handler HardFault_Handler
+handler MemManage_Handler
+handler BusFault_Handler
+handler UsageFault_Handler
+handler SVC_Handler
+handler DebugMon_Handler
+handler PendSV_Handler
+handler SysTick_Handler
+handler GPIOPortA_Handler
+handler GPIOPortB_Handler
+handler GPIOPortC_Handler
+handler GPIOPortD_Handler
+handler GPIOPortE_Handler
+handler UART0_Handler
+handler UART1_Handler
+handler SSI0_Handler
+handler I2C0_Handler
+handler PWM0Fault_Handler
+handler PWM0Gen0_Handler
+handler PWM0Gen1_Handler
+handler PWM0Gen2_Handler
+handler QEI0_Handler
+handler ADC0Seq0_Handler
+handler ADC0Seq1_Handler
+handler ADC0Seq2_Handler
+handler ADC0Seq3_Handler
+handler Watchdog_Handler
+handler Timer0A_Handler
+handler Timer0B_Handler
+handler Timer1A_Handler
+handler Timer1B_Handler
+handler Timer2A_Handler
+handler Timer2B_Handler
+handler Comp0_Handler
+handler Comp1_Handler
+handler Comp2_Handler
+handler SysCtl_Handler
+handler FlashCtl_Handler
+handler GPIOPortF_Handler
+handler GPIOPortG_Handler
+handler GPIOPortH_Handler
+handler UART2_Handler
+handler SSI1_Handler
+handler Timer3A_Handler
+handler Timer3B_Handler
+handler I2C1_Handler
+handler QEI1_Handler
+handler CAN0_Handler
+handler CAN1_Handler
+handler Hibernate_Handler
+handler USB0_Handler
+handler PWM0Gen3_Handler
+handler uDMA_Handler
+handler uDMAError_Handler
+handler ADC1Seq0_Handler
+handler ADC1Seq1_Handler
+handler ADC1Seq2_Handler
+handler ADC1Seq3_Handler
+handler GPIOPortJ_Handler
+handler GPIOPortK_Handler
+handler GPIOPortL_Handler
+handler SSI2_Handler
+handler SSI3_Handler
+handler UART3_Handler
+handler UART4_Handler
+handler UART5_Handler
+handler UART6_Handler
+handler UART7_Handler
+handler I2C2_Handler
+handler I2C3_Handler
+
+@ Vector table, placed at address 0 by the linker script
+.section .vectors, "a"
+.global vectors
+vectors:
+    .word _stack_top                        @ initial stack pointer
+    .word _start                            @ reset
+    .word NMI_Handler                       @ NMI
+    .word HardFault_Handler                 @ hard fault
+    .word MemManage_Handler                 @ MPU fault
+    .word BusFault_Handler                  @ bus fault
+    .word UsageFault_Handler                @ usage fault
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word SVC_Handler                       @ SVCall
+    .word DebugMon_Handler                  @ debug monitor
+    .word 0                                 @ reserved
+    .word PendSV_Handler                    @ PendSV
+    .word SysTick_Handler                   @ SysTick
+    .word GPIOPortA_Handler                 @ GPIO Port A
+    .word GPIOPortB_Handler                 @ GPIO Port B
+    .word GPIOPortC_Handler                 @ GPIO Port C
+    .word GPIOPortD_Handler                 @ GPIO Port D
+    .word GPIOPortE_Handler                 @ GPIO Port E
+    .word UART0_Handler                     @ UART0 Rx and Tx
+    .word UART1_Handler                     @ UART1 Rx and Tx
+    .word SSI0_Handler                      @ SSI0 Rx and Tx
+    .word I2C0_Handler                      @ I2C0 Master and Slave
+    .word PWM0Fault_Handler                 @ PWM Fault
+    .word PWM0Gen0_Handler                  @ PWM Generator 0
+    .word PWM0Gen1_Handler                  @ PWM Generator 1
+    .word PWM0Gen2_Handler                  @ PWM Generator 2
+    .word QEI0_Handler                      @ Quadrature Encoder 0
+    .word ADC0Seq0_Handler                  @ ADC0 Sequence 0
+    .word ADC0Seq1_Handler                  @ ADC0 Sequence 1
+    .word ADC0Seq2_Handler                  @ ADC0 Sequence 2
+    .word ADC0Seq3_Handler                  @ ADC0 Sequence 3
+    .word Watchdog_Handler                  @ Watchdog timer
+    .word Timer0A_Handler                   @ Timer 0 subtimer A
+    .word Timer0B_Handler                   @ Timer 0 subtimer B
+    .word Timer1A_Handler                   @ Timer 1 subtimer A
+    .word Timer1B_Handler                   @ Timer 1 subtimer B
+    .word Timer2A_Handler                   @ Timer 2 subtimer A
+    .word Timer2B_Handler                   @ Timer 2 subtimer B
+    .word Comp0_Handler                     @ Analog Comparator 0
+    .word Comp1_Handler                     @ Analog Comparator 1
+    .word Comp2_Handler                     @ Analog Comparator 2
+    .word SysCtl_Handler                    @ System Control
+    .word FlashCtl_Handler                  @ Flash Control
+    .word GPIOPortF_Handler                 @ GPIO Port F
+    .word GPIOPortG_Handler                 @ GPIO Port G
+    .word GPIOPortH_Handler                 @ GPIO Port H
+    .word UART2_Handler                     @ UART2 Rx and Tx
+    .word SSI1_Handler                      @ SSI1 Rx and Tx
+    .word Timer3A_Handler                   @ Timer 3 subtimer A
+    .word Timer3B_Handler                   @ Timer 3 subtimer B
+    .word I2C1_Handler                      @ I2C1 Master and Slave
+    .word QEI1_Handler                      @ Quadrature Encoder 1
+    .word CAN0_Handler                      @ CAN0
+    .word CAN1_Handler                      @ CAN1
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word Hibernate_Handler                 @ Hibernate
+    .word USB0_Handler                      @ USB0
+    .word PWM0Gen3_Handler                  @ PWM Generator 3
+    .word uDMA_Handler                      @ uDMA Software Transfer
+    .word uDMAError_Handler                 @ uDMA Error
+    .word ADC1Seq0_Handler                  @ ADC1 Sequence 0
+    .word ADC1Seq1_Handler                  @ ADC1 Sequence 1
+    .word ADC1Seq2_Handler                  @ ADC1 Sequence 2
+    .word ADC1Seq3_Handler                  @ ADC1 Sequence 3
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word GPIOPortJ_Handler                 @ GPIO Port J
+    .word GPIOPortK_Handler                 @ GPIO Port K
+    .word GPIOPortL_Handler                 @ GPIO Port L
+    .word SSI2_Handler                      @ SSI2 Rx and Tx
+    .word SSI3_Handler                      @ SSI3 Rx and Tx
+    .word UART3_Handler                     @ UART3 Rx and Tx
+    .word UART4_Handler                     @ UART4 Rx and Tx
+    .word UART5_Handler                     @ UART5 Rx and Tx
+    .word UART6_Handler                     @ UART6 Rx and Tx
+    .word UART7_Handler                     @ UART7 Rx and Tx
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word 0                                 @ reserved
+    .word I2C2_Handler                      @ I2C2 Master and Slave
+    .word I2C3_Handler                      @ I2C3 Master and Slave
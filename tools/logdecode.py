@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# This file is part of the RTOS-Framework Project.
+#
+# RTOS-Framework is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# RTOS-Framework is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <https://www.gnu.org/licenses/>.
+#
+# Copyright (c) 2025 Sandeep K. Pal
+#-----------------------------------------------------------------------------
+
+"""Decode the binary LOG() stream (kernel/log.h) using the firmware ELF.
+
+usage: logdecode.py rtos-framework.elf /dev/ttyACM0 [--baud 115200]
+       logdecode.py rtos-framework.elf capture.bin
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LOG_MARKER = 0xA
+LOG_DROPPED = 0
+SPEC = re.compile(r'%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z|j|t)?([diouxXcfeEgGp%])')
+
+
+def read_logstr(path):
+    """Map .logstr address -> format string from an ELF32 little-endian file."""
+    data = open(path, 'rb').read()
+    if data[:4] != b'\x7fELF' or data[4] != 1:
+        sys.exit('%s: not an ELF32 file' % path)
+    shoff, = struct.unpack_from('<I', data, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from('<HHH', data, 0x2E)
+    sections = [struct.unpack_from('<IIIIII', data, shoff + i * shentsize) for i in range(shnum)]
+    names = sections[shstrndx][4]
+    for name, _, _, addr, offset, size in sections:
+        end = data.index(b'\0', names + name)
+        if data[names + name:end] == b'.logstr':
+            blob = data[offset:offset + size]
+            strings = {}
+            start = 0
+            while start < len(blob):
+                stop = blob.index(b'\0', start)
+                strings[(addr + start) & 0xFFFFFF] = blob[start:stop].decode('latin-1')
+                start = stop + 1
+                while start < len(blob) and blob[start] == 0:
+                    start += 1   # alignment padding
+            return strings
+    sys.exit('%s: no .logstr section' % path)
+
+
+def render(fmt, args):
+    """printf-style formatting from raw 32-bit argument words."""
+    out = []
+    pos = 0
+    words = iter(args)
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        conv = m.group(1)
+        if conv == '%':
+            out.append('%')
+            continue
+        spec = re.sub(r'(hh|h|ll|l|z|j|t)', '', m.group(0))
+        w = next(words, 0)
+        if conv in 'fFeEgG':
+            out.append(spec % struct.unpack('<f', struct.pack('<I', w))[0])
+        elif conv in 'di':
+            out.append(spec % (w - (1 << 32) if w & 0x80000000 else w))
+        elif conv == 'c':
+            out.append(chr(w & 0xFF))
+        elif conv == 'p':
+            out.append('0x%08x' % w)
+        else:
+            out.append(spec.replace('u', 'd') % w)
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+def records(stream):
+    """Yield (format address, tick, args), resynchronising on the marker nibble."""
+    buf = b''
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        buf += chunk
+        while len(buf) >= 8:
+            header, tick = struct.unpack_from('<II', buf)
+            if header >> 28 != LOG_MARKER:
+                buf = buf[1:]
+                continue
+            count = (header >> 24) & 0xF
+            if len(buf) < 8 + 4 * count:
+                break
+            args = struct.unpack_from('<%dI' % count, buf, 8)
+            buf = buf[8 + 4 * count:]
+            yield header & 0xFFFFFF, tick, args
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('elf')
+    parser.add_argument('source', help='serial port or captured binary file')
+    parser.add_argument('--baud', type=int, default=115200)
+    opts = parser.parse_args()
+
+    strings = read_logstr(opts.elf)
+    if opts.source.startswith('/dev/') or opts.source.upper().startswith('COM'):
+        import serial
+        stream = serial.Serial(opts.source, opts.baud, timeout=None)
+    else:
+        stream = open(opts.source, 'rb')
+
+    for address, tick, args in records(stream):
+        if address == LOG_DROPPED:
+            line = '<%d records dropped>' % (args[0] if args else 0)
+        elif address in strings:
+            line = render(strings[address], args)
+        else:
+            line = '<unknown format 0x%06x> %s' % (address, ' '.join('%08x' % a for a in args))
+        print('%10d  %s' % (tick, line), flush=True)
+
+
+if __name__ == '__main__':
+    main()